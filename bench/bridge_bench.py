@@ -0,0 +1,717 @@
+#!/usr/bin/env python3
+"""
+LucidConsole bridge benchmark - end-to-end UART -> SSE/TCP delivery
+
+Drives a known line stream into the UART side, fans it out to N
+/api/uart/stream SSE clients and raw TCP clients, and reports delivered
+throughput, loss, reorder and latency percentiles as JSON. Works against
+the host simulator (sim/, optionally launched by this script) or a device.
+
+Every line carries a run tag, a sequence number and the host send time:
+
+    LB<run:4x> <seq:8x> <send_us:12x> <filler...>\\n
+
+so any receiver can count lost, reordered and corrupted lines and measure
+latency without help from the bridge. SSE event ids (stream offsets) are
+checked as well, to tell bytes the bridge dropped from lines it mangled.
+"""
+
+import argparse
+import base64
+import json
+import os
+import random
+import select
+import shutil
+import signal
+import socket
+import subprocess
+import sys
+import tempfile
+import termios
+import threading
+import time
+import tty
+import urllib.request
+
+FILLER = b'abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ'
+
+
+def now_us():
+    return time.monotonic_ns() // 1000
+
+
+def make_line(run, seq, send_us, size):
+    """One stream line; the filler depends on seq so corruption is visible"""
+    head = b'LB%04x %08x %012x ' % (run, seq, send_us)
+    fill_len = size - len(head) - 1
+    start = seq % len(FILLER)
+    filler = (FILLER[start:] + FILLER * (fill_len // len(FILLER) + 1))[:fill_len]
+    return head + filler + b'\n'
+
+
+def percentile(sorted_values, pct):
+    if not sorted_values:
+        return None
+    index = min(len(sorted_values) - 1, int(round(pct / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+class LineChecker:
+    """Reassembles stream lines and scores them against the sender's sequence"""
+
+    def __init__(self, run, line_size):
+        self.run_tag = b'LB%04x' % run
+        self.line_size = line_size
+        self.partial = b''
+        self.expected = None
+        self.bytes = 0
+        self.lines = 0
+        self.lost = 0
+        self.reordered = 0
+        self.duplicates = 0
+        self.corrupt = 0
+        self.seen = set()
+        self.latencies_us = []
+        self.first_us = None
+        self.last_us = None
+        self.seen_max = -1
+
+    def feed(self, data, recv_us):
+        self.bytes += len(data)
+        if self.first_us is None:
+            self.first_us = recv_us
+        self.last_us = recv_us
+
+        self.partial += data
+        *lines, self.partial = self.partial.split(b'\n')
+        for line in lines:
+            self._check(line + b'\n', recv_us)
+
+    def _check(self, line, recv_us):
+        if not line.startswith(self.run_tag):
+            # Stale bytes from before the run, or a line cut by a gap
+            if self.expected is not None:
+                self.corrupt += 1
+            return
+        try:
+            seq = int(line[7:15], 16)
+            send_us = int(line[16:28], 16)
+        except ValueError:
+            self.corrupt += 1
+            return
+        if line != make_line(int(line[2:6], 16), seq, send_us, self.line_size):
+            self.corrupt += 1
+            return
+
+        if seq in self.seen:
+            self.duplicates += 1
+            return
+        self.seen.add(seq)
+        self.lines += 1
+        self.latencies_us.append(recv_us - send_us)
+        if self.expected is None:
+            # Clients start before the source; the first line must be seq 0
+            self.lost += seq
+            self.expected = seq
+        if seq == self.expected:
+            self.expected = seq + 1
+        elif seq > self.expected:
+            self.lost += seq - self.expected
+            self.expected = seq + 1
+        else:
+            # Arrived after a later line; it was counted as lost then
+            self.reordered += 1
+            self.lost -= 1
+        self.seen_max = max(self.seen_max, seq)
+
+    def finish(self, lines_sent):
+        """Lines never seen at the end of the run are lost too"""
+        if self.expected is None:
+            self.lost = lines_sent
+        elif self.expected < lines_sent:
+            self.lost += lines_sent - self.expected
+
+    def report(self, lines_sent):
+        self.finish(lines_sent)
+        lat = sorted(self.latencies_us)
+        elapsed = ((self.last_us - self.first_us) / 1e6) if self.first_us is not None else 0
+        ms = lambda us: None if us is None else round(us / 1000.0, 3)
+        return {
+            'bytes': self.bytes,
+            'lines': self.lines,
+            'lost_lines': self.lost,
+            'loss_ratio': round(self.lost / lines_sent, 6) if lines_sent else 0,
+            'reordered_lines': self.reordered,
+            'duplicate_lines': self.duplicates,
+            'corrupt_lines': self.corrupt,
+            'throughput_bps': round(self.bytes / elapsed, 1) if elapsed > 0 else 0,
+            'latency_ms': {
+                'p50': ms(percentile(lat, 50)),
+                'p90': ms(percentile(lat, 90)),
+                'p99': ms(percentile(lat, 99)),
+                'max': ms(lat[-1] if lat else None),
+            },
+        }
+
+
+class Client(threading.Thread):
+    """Base receiver: a socket read loop feeding a LineChecker"""
+
+    def __init__(self, name, host, port, checker):
+        super().__init__(daemon=True)
+        self.name = name
+        self.host = host
+        self.port = port
+        self.checker = checker
+        self.stop = threading.Event()
+        self.connected = threading.Event()
+        self.error = None
+        self.sock = None
+
+    def run(self):
+        try:
+            self.sock = socket.create_connection((self.host, self.port), timeout=5)
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self.start_stream()
+            self.connected.set()
+            while not self.stop.is_set():
+                ready, _, _ = select.select([self.sock], [], [], 0.1)
+                if not ready:
+                    continue
+                data = self.sock.recv(65536)
+                if not data:
+                    self.error = self.error or 'closed by server'
+                    break
+                self.on_data(data, now_us())
+        except OSError as e:
+            self.error = str(e)
+        finally:
+            self.connected.set()
+            if self.sock:
+                self.sock.close()
+
+    def start_stream(self):
+        pass
+
+    def on_data(self, data, recv_us):
+        self.checker.feed(data, recv_us)
+
+    def report(self, lines_sent):
+        result = {'name': self.name}
+        result.update(self.checker.report(lines_sent))
+        if self.error:
+            result['error'] = self.error
+        return result
+
+
+class TcpClient(Client):
+    """Raw TCP bridge client (port 2323): the UART byte stream as is"""
+
+
+class SseClient(Client):
+    """/api/uart/stream client: de-chunks HTTP, parses events, checks offsets"""
+
+    def __init__(self, name, host, port, checker, query):
+        super().__init__(name, host, port, checker)
+        self.query = query
+        self.raw = b''
+        self.headers_done = False
+        self.chunk_left = 0
+        self.events = b''
+        self.frames = 0
+        self.heartbeats = 0
+        self.offset = None
+        self.gap_bytes = 0
+        self.overlap_bytes = 0
+
+    def start_stream(self):
+        path = '/api/uart/stream' + ('?' + self.query if self.query else '')
+        request = 'GET %s HTTP/1.1\r\nHost: %s\r\nAccept: text/event-stream\r\n\r\n' % (path, self.host)
+        self.sock.sendall(request.encode())
+
+    def on_data(self, data, recv_us):
+        self.raw += data
+        if not self.headers_done:
+            end = self.raw.find(b'\r\n\r\n')
+            if end < 0:
+                return
+            status = self.raw.split(b'\r\n', 1)[0]
+            if b' 200 ' not in status + b' ':
+                self.error = status.decode(errors='replace')
+                self.stop.set()
+                return
+            self.raw = self.raw[end + 4:]
+            self.headers_done = True
+
+        # Chunked transfer encoding: size line, payload, CRLF
+        while self.raw:
+            if self.chunk_left == 0:
+                end = self.raw.find(b'\r\n')
+                if end < 0:
+                    break
+                size = int(self.raw[:end].split(b';')[0] or b'0', 16)
+                if size == 0:
+                    self.stop.set()
+                    break
+                self.raw = self.raw[end + 2:]
+                self.chunk_left = size + 2
+            data_take = min(max(self.chunk_left - 2, 0), len(self.raw))
+            self.events += self.raw[:data_take]
+            self.raw = self.raw[data_take:]
+            self.chunk_left -= data_take
+            if self.chunk_left <= 2:
+                skip = min(self.chunk_left, len(self.raw))
+                self.raw = self.raw[skip:]
+                self.chunk_left -= skip
+        self._parse_events(recv_us)
+
+    def _parse_events(self, recv_us):
+        *events, self.events = self.events.split(b'\n\n')
+        for event in events:
+            fields = {}
+            for line in event.split(b'\n'):
+                if line.startswith(b':'):
+                    self.heartbeats += 1
+                    continue
+                key, _, value = line.partition(b':')
+                fields[key] = value[1:] if value.startswith(b' ') else value
+            if b'id' not in fields or b'data' not in fields or b'event' in fields:
+                continue
+            try:
+                message = json.loads(fields[b'data'])
+                data = base64.b64decode(message['uart_b64'])
+                end = int(fields[b'id'])
+            except (ValueError, KeyError):
+                continue
+            self.frames += 1
+
+            # Event id is the stream offset after the frame
+            start = (end - len(data)) & 0xFFFFFFFF
+            if self.offset is not None and start != self.offset:
+                delta = (start - self.offset) & 0xFFFFFFFF
+                if delta < 0x80000000:
+                    self.gap_bytes += delta
+                else:
+                    self.overlap_bytes += 0x100000000 - delta
+            self.offset = end
+            self.checker.feed(data, recv_us)
+
+    def report(self, lines_sent):
+        result = super().report(lines_sent)
+        result.update({
+            'frames': self.frames,
+            'heartbeats': self.heartbeats,
+            'offset_gap_bytes': self.gap_bytes,
+            'offset_overlap_bytes': self.overlap_bytes,
+        })
+        return result
+
+
+class Source:
+    """Generates the line stream at a target rate and hands it to write()"""
+
+    def __init__(self, run, line_size, total_bytes, duration, rate, chunk):
+        self.run = run
+        self.line_size = line_size
+        self.total_lines = (total_bytes // line_size) if total_bytes else None
+        self.duration = duration
+        self.rate = rate
+        self.chunk_lines = max(1, chunk // line_size)
+        self.lines_sent = 0
+        self.bytes_sent = 0
+        self.elapsed = 0.0
+
+    def write(self, data):
+        raise NotImplementedError
+
+    def close(self):
+        pass
+
+    def run_stream(self):
+        start = time.monotonic()
+        while True:
+            elapsed = time.monotonic() - start
+            if self.duration and elapsed >= self.duration:
+                break
+            if self.total_lines is not None and self.lines_sent >= self.total_lines:
+                break
+            if self.rate:
+                ahead = self.bytes_sent / self.rate - elapsed
+                if ahead > 0:
+                    time.sleep(ahead)
+
+            count = self.chunk_lines
+            if self.total_lines is not None:
+                count = min(count, self.total_lines - self.lines_sent)
+            stamp = now_us()
+            data = b''.join(make_line(self.run, self.lines_sent + i, stamp, self.line_size)
+                            for i in range(count))
+            self.write(data)
+            self.lines_sent += count
+            self.bytes_sent += len(data)
+        self.elapsed = time.monotonic() - start
+        self.close()
+
+
+class PtySource(Source):
+    """Writes into a serial device or pty (sim --uart pty, or a USB adapter)"""
+
+    def __init__(self, path, baud=None, **kwargs):
+        super().__init__(**kwargs)
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            tty.setraw(self.fd)
+            self.set_speed(self.fd, baud)
+
+    @staticmethod
+    def set_speed(fd, baud):
+        speed = getattr(termios, 'B%d' % baud, None) if baud else None
+        if speed is not None:
+            # A USB adapter must match the device; a pty ignores it
+            attrs = termios.tcgetattr(fd)
+            attrs[4] = attrs[5] = speed
+            termios.tcsetattr(fd, termios.TCSANOW, attrs)
+
+    def write(self, data):
+        view = memoryview(data)
+        while view:
+            written = os.write(self.fd, view)
+            view = view[written:]
+
+    def close(self):
+        os.close(self.fd)
+
+
+class HttpSource(Source):
+    """Streams one long POST /api/uart/write; TX must loop back to RX"""
+
+    def __init__(self, host, port, **kwargs):
+        super().__init__(**kwargs)
+        if self.total_lines is None:
+            raise ValueError('--source http needs --bytes (the POST has a Content-Length)')
+        self.sock = socket.create_connection((host, port), timeout=30)
+        length = self.total_lines * self.line_size
+        request = ('POST /api/uart/write HTTP/1.1\r\nHost: %s\r\n'
+                   'Content-Type: application/octet-stream\r\nContent-Length: %d\r\n\r\n' % (host, length))
+        self.sock.sendall(request.encode())
+        self.response = None
+
+    def write(self, data):
+        self.sock.sendall(data)
+
+    def close(self):
+        try:
+            self.response = self.sock.recv(4096).decode(errors='replace')
+        except OSError as e:
+            self.response = str(e)
+        self.sock.close()
+
+
+TELNET_IAC, TELNET_SB, TELNET_SE = 255, 250, 240
+COM_PORT_OPTION, SET_BAUDRATE, SERVER_OFFSET = 44, 1, 100
+
+
+def set_baud(host, port, baud, timeout=5):
+    """Pin the UART baud over RFC 2217; this also stops autobaud hunting"""
+    request = bytes([TELNET_IAC, TELNET_SB, COM_PORT_OPTION, SET_BAUDRATE])
+    request += baud.to_bytes(4, 'big').replace(b'\xff', b'\xff\xff')
+    request += bytes([TELNET_IAC, TELNET_SE])
+    reply = bytes([TELNET_IAC, TELNET_SB, COM_PORT_OPTION, SET_BAUDRATE + SERVER_OFFSET])
+
+    with socket.create_connection((host, port), timeout=timeout) as sock:
+        sock.sendall(request)
+        received = b''
+        deadline = time.monotonic() + timeout
+        while reply not in received:
+            if time.monotonic() >= deadline:
+                raise RuntimeError('no RFC 2217 baud reply from %s:%d' % (host, port))
+            data = sock.recv(4096)
+            if not data:
+                raise RuntimeError('RFC 2217 server closed the connection')
+            received += data
+
+
+def http_json(host, port, path, timeout=5):
+    try:
+        with urllib.request.urlopen('http://%s:%d%s' % (host, port, path), timeout=timeout) as response:
+            return json.loads(response.read())
+    except (OSError, ValueError):
+        return None
+
+
+def port_open(host, port):
+    try:
+        socket.create_connection((host, port), timeout=1).close()
+        return True
+    except OSError:
+        return False
+
+
+def launch_sim(args):
+    """Start the simulator with a private state dir; returns (process, state_dir)"""
+    state_dir = tempfile.mkdtemp(prefix='lucidbench_')
+    uart = 'pty' if args.source == 'pty' else 'loopback'
+    cmd = [args.sim, '--uart', uart, '--state-dir', state_dir,
+           '--port-offset', str(args.http_port - 80), '--log', 'warn']
+    if args.sim_pace:
+        cmd += ['--pace', args.sim_pace]
+    log = open(os.path.join(state_dir, 'sim.log'), 'w')
+    proc = subprocess.Popen(cmd, stdout=log, stderr=log, stdin=subprocess.DEVNULL)
+
+    pty_link = os.path.join(state_dir, 'uart.pty')
+    deadline = time.monotonic() + 10
+    while time.monotonic() < deadline:
+        if proc.poll() is not None:
+            raise RuntimeError('simulator exited, see %s/sim.log' % state_dir)
+        # The TCP bridge comes up last, after autobaud has been started
+        if port_open(args.host, args.tcp_port) and (uart != 'pty' or os.path.exists(pty_link)):
+            break
+        time.sleep(0.2)
+    else:
+        proc.kill()
+        raise RuntimeError('simulator did not come up on port %d' % args.http_port)
+    return proc, state_dir
+
+
+def stats_delta(before, after):
+    """Device-side counters that moved during the run"""
+    if not before or not after:
+        return None
+    delta = {}
+    for group in ('rx', 'tx', 'errors'):
+        for key, value in (after.get(group) or {}).items():
+            old = (before.get(group) or {}).get(key)
+            if isinstance(value, (int, float)) and isinstance(old, (int, float)):
+                delta['%s_%s' % (group, key)] = value - old
+    return delta
+
+
+def summarize(clients, lines_sent):
+    """Worst case across clients of each transport"""
+    summary = {}
+    for kind in ('sse', 'tcp'):
+        reports = [c for c in clients if c['name'].startswith(kind)]
+        if not reports:
+            continue
+        p99 = [c['latency_ms']['p99'] for c in reports if c['latency_ms']['p99'] is not None]
+        p50 = [c['latency_ms']['p50'] for c in reports if c['latency_ms']['p50'] is not None]
+        summary[kind] = {
+            'clients': len(reports),
+            'min_throughput_bps': min(c['throughput_bps'] for c in reports),
+            'total_throughput_bps': round(sum(c['throughput_bps'] for c in reports), 1),
+            'max_loss_ratio': max(c['loss_ratio'] for c in reports),
+            'reordered_lines': sum(c['reordered_lines'] for c in reports),
+            'corrupt_lines': sum(c['corrupt_lines'] for c in reports),
+            'max_latency_p50_ms': max(p50) if p50 else None,
+            'max_latency_p99_ms': max(p99) if p99 else None,
+        }
+    return summary
+
+
+# Metric -> True if higher is better
+COMPARED_METRICS = {
+    'min_throughput_bps': True,
+    'total_throughput_bps': True,
+    'max_loss_ratio': False,
+    'max_latency_p50_ms': False,
+    'max_latency_p99_ms': False,
+}
+
+
+def compare(result, baseline, threshold_pct):
+    """Per-metric change against a baseline result; flags regressions"""
+    comparison = {}
+    regressions = []
+    for kind, metrics in result['summary'].items():
+        base = baseline.get('summary', {}).get(kind)
+        if not base:
+            continue
+        for metric, higher_is_better in COMPARED_METRICS.items():
+            new, old = metrics.get(metric), base.get(metric)
+            if new is None or old is None:
+                continue
+            change = ((new - old) / old * 100.0) if old else (0.0 if new == old else float('inf'))
+            worse = (change < -threshold_pct) if higher_is_better else (change > threshold_pct)
+            # Loss going from 0 to anything is a regression whatever the percentage
+            if metric == 'max_loss_ratio' and old == 0 and new > 0:
+                worse = True
+            entry = {'baseline': old, 'current': new,
+                     'change_pct': None if change == float('inf') else round(change, 1),
+                     'regression': worse}
+            comparison['%s.%s' % (kind, metric)] = entry
+            if worse:
+                regressions.append('%s.%s' % (kind, metric))
+    return comparison, regressions
+
+
+def print_comparison(comparison):
+    print('%-34s %14s %14s %9s' % ('metric', 'baseline', 'current', 'change'), file=sys.stderr)
+    for name, entry in comparison.items():
+        change = '-' if entry['change_pct'] is None else '%+.1f%%' % entry['change_pct']
+        flag = '  REGRESSION' if entry['regression'] else ''
+        print('%-34s %14s %14s %9s%s' % (name, entry['baseline'], entry['current'], change, flag),
+              file=sys.stderr)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='End-to-end LucidConsole bridge benchmark')
+    target = parser.add_argument_group('target')
+    target.add_argument('--host', default='127.0.0.1', help='Device or simulator address')
+    target.add_argument('--http-port', type=int, default=8080,
+                        help='HTTP port (8080 = simulator default, 80 on a device)')
+    target.add_argument('--tcp-port', type=int, default=2323, help='Raw TCP bridge port')
+    target.add_argument('--rfc2217-port', type=int, default=2217, help='RFC 2217 port used by --baud')
+    target.add_argument('--baud', type=int,
+                        help='Pin the UART to this baud over RFC 2217 before the run '
+                             '(default 115200 with --sim, so autobaud cannot reconfigure mid-run)')
+    target.add_argument('--sim', metavar='BINARY',
+                        help='Launch this simulator build for the run (e.g. sim/build/lucidconsole_sim)')
+    target.add_argument('--sim-pace', choices=('on', 'off'), help='Passed to the simulator as --pace')
+
+    load = parser.add_argument_group('load')
+    load.add_argument('--source', choices=('pty', 'http'), default='pty',
+                      help='pty: write a serial device/pty; http: POST /api/uart/write with TX looped to RX')
+    load.add_argument('--pty', metavar='PATH', help='Serial device or pty (default: the launched simulator\'s)')
+    load.add_argument('--bytes', type=int, default=256 * 1024, help='Bytes to send (0 = use --duration)')
+    load.add_argument('--duration', type=float, default=0, help='Seconds to send for')
+    load.add_argument('--rate', type=int, help='Source rate in bytes/s (default: 90%% of the line rate for '
+                           '--source pty, unpaced for http; 0 = as fast as accepted)')
+    load.add_argument('--line-size', type=int, default=64, help='Bytes per stream line (>= 32)')
+    load.add_argument('--chunk', type=int, default=1024, help='Bytes per source write')
+    load.add_argument('--sse', type=int, default=1, help='Concurrent SSE clients')
+    load.add_argument('--tcp', type=int, default=1, help='Concurrent raw TCP clients')
+    load.add_argument('--sse-query', default='', help='Extra stream query, e.g. "policy=drop-client&flush_ms=0"')
+    load.add_argument('--drain', type=float, default=2.0, help='Seconds to wait for stragglers after sending')
+
+    output = parser.add_argument_group('output')
+    output.add_argument('--label', default='', help='Free-form run label stored in the result')
+    output.add_argument('--out', metavar='FILE', help='Write the JSON result here (default: stdout)')
+    output.add_argument('--baseline', metavar='FILE', help='Compare against an earlier result')
+    output.add_argument('--threshold', type=float, default=10.0,
+                        help='Percent change counted as a regression (default 10)')
+    args = parser.parse_args()
+
+    if args.line_size < 32:
+        parser.error('--line-size must be at least 32')
+    if not args.bytes and not args.duration:
+        parser.error('give --bytes or --duration')
+    if args.source == 'pty' and not args.pty and not args.sim:
+        parser.error('--source pty needs --pty PATH or --sim')
+    if args.sim and args.http_port < 80:
+        parser.error('--sim maps port 80 to --http-port, which must be >= 80')
+    if args.sim and args.baud is None:
+        args.baud = 115200
+    return args
+
+
+def main():
+    args = parse_args()
+    run = random.randrange(0x10000)
+
+    sim_proc = None
+    sim_dir = None
+    if args.sim:
+        sim_proc, sim_dir = launch_sim(args)
+        if args.source == 'pty' and not args.pty:
+            args.pty = os.path.join(sim_dir, 'uart.pty')
+
+    try:
+        if args.baud:
+            set_baud(args.host, args.rfc2217_port, args.baud)
+        stats_before = http_json(args.host, args.http_port, '/api/uart/stats')
+        baud = (stats_before or {}).get('baud') or args.baud
+        if args.rate is None:
+            # Faster than the wire only queues in the pty and inflates latency
+            args.rate = int(baud / 10 * 0.9) if args.source == 'pty' and baud else 0
+
+        clients = []
+        for i in range(args.sse):
+            clients.append(SseClient('sse%d' % i, args.host, args.http_port,
+                                     LineChecker(run, args.line_size), args.sse_query))
+        for i in range(args.tcp):
+            clients.append(TcpClient('tcp%d' % i, args.host, args.tcp_port,
+                                     LineChecker(run, args.line_size)))
+        for client in clients:
+            client.start()
+        for client in clients:
+            client.connected.wait(5)
+        time.sleep(0.5)             # Let the bridge register every cursor
+
+        source_args = dict(run=run, line_size=args.line_size, total_bytes=args.bytes,
+                           duration=args.duration, rate=args.rate, chunk=args.chunk)
+        if args.source == 'pty':
+            source = PtySource(args.pty, baud=args.baud, **source_args)
+        else:
+            source = HttpSource(args.host, args.http_port, **source_args)
+        source.run_stream()
+
+        # Stragglers: stop once every client has the last line or the drain time is up
+        deadline = time.monotonic() + args.drain
+        while time.monotonic() < deadline:
+            if all(c.checker.seen_max >= source.lines_sent - 1 for c in clients):
+                break
+            time.sleep(0.1)
+        for client in clients:
+            client.stop.set()
+        for client in clients:
+            client.join(2)
+
+        stats_after = http_json(args.host, args.http_port, '/api/uart/stats')
+        reports = [c.report(source.lines_sent) for c in clients]
+        result = {
+            'label': args.label,
+            'timestamp': time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+            'target': {
+                'host': args.host,
+                'http_port': args.http_port,
+                'simulator': bool(args.sim),
+                'baud': (stats_after or {}).get('baud'),
+            },
+            'source': {
+                'kind': args.source,
+                'lines': source.lines_sent,
+                'bytes': source.bytes_sent,
+                'target_rate_bps': args.rate,
+                'line_size': args.line_size,
+                'seconds': round(source.elapsed, 3),
+                'rate_bps': round(source.bytes_sent / source.elapsed, 1) if source.elapsed else 0,
+            },
+            'clients': reports,
+            'summary': summarize(reports, source.lines_sent),
+            'device': stats_delta(stats_before, stats_after),
+        }
+        if args.source == 'http':
+            result['source']['response'] = source.response.split('\r\n\r\n', 1)[-1]
+    finally:
+        if sim_proc:
+            sim_proc.send_signal(signal.SIGTERM)
+            try:
+                sim_proc.wait(5)
+            except subprocess.TimeoutExpired:
+                sim_proc.kill()
+            shutil.rmtree(sim_dir, ignore_errors=True)
+
+    exit_code = 0
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        comparison, regressions = compare(result, baseline, args.threshold)
+        result['comparison'] = {'baseline_label': baseline.get('label', ''),
+                                'threshold_pct': args.threshold,
+                                'metrics': comparison,
+                                'regressions': regressions}
+        print_comparison(comparison)
+        exit_code = 1 if regressions else 0
+
+    text = json.dumps(result, indent=2)
+    if args.out:
+        with open(args.out, 'w') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+    return exit_code
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,418 @@
+/*
+ * Host Microbenchmarks - LucidConsole
+ * Times hot-path primitives on the build machine, linked against the
+ * simulator's objects so the code under test is the firmware's own.
+ * The ssd1306 component is not built here: OLED drawing runs through
+ * the simulator's stand-in (sim/hal/ssd1306_sim.c), and its cases say so.
+ */
+
+#include "sim.h"
+#include "esp_log.h"
+#include "mbedtls/base64.h"
+#include "cJSON.h"
+#include "ssd1306/ssd1306.h"
+#include "fonts/fonts.h"
+#include "display/oled_framebuffer.h"
+#include "web/web_server.h"
+#include "tcp/rfc2217.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_SAMPLES       1000
+#define BENCH_STREAM_LEN        1024    // Bytes per stream kernel call (one UART read)
+
+// One benchmark: run() does a single operation of units_per_op units
+typedef struct {
+    const char* name;
+    const char* unit;           // "byte" or "op"
+    size_t units_per_op;
+    void (*setup)(void);
+    void (*run)(void);
+} bench_case_t;
+
+// Keeps results alive so the compiler cannot drop the work
+static volatile size_t bench_sink;
+
+// Measurement settings (command line)
+static unsigned bench_samples = 25;
+static unsigned bench_sample_ms = 5;
+static unsigned bench_warmup_ms = 100;
+
+extern const font_info_t _fonts_glcd_5x7_info;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*
+ * Inputs
+ */
+
+// Boot-log-like text, the common case for UART traffic
+static uint8_t text_input[BENCH_STREAM_LEN];
+
+static void text_input_setup(void) {
+    static const char sample[] =
+        "I (1234) wifi: station: 24:0a:c4:00:00:01 join, AID=1, bgn, 20\r\n"
+        "W (1240) httpd: httpd_accept_conn: error in accept (23)\r\n"
+        "[  12.345678] usb 1-1: new high-speed USB device number 2 using ehci\n";
+    for (size_t i = 0; i < sizeof(text_input); i++) {
+        text_input[i] = (uint8_t)sample[i % (sizeof(sample) - 1)];
+    }
+}
+
+/*
+ * Base64 per SSE event (web_server.c encodes each RX chunk)
+ */
+
+static unsigned char b64_output[((LUCIDUART_SSE_CHUNK_MAX + 2) / 3) * 4 + 1];
+
+static void b64_encode(size_t len) {
+    size_t out_len = 0;
+    mbedtls_base64_encode(b64_output, sizeof(b64_output), &out_len, text_input, len);
+    bench_sink += out_len + b64_output[out_len / 2];
+}
+
+static void run_b64_16(void) {
+    b64_encode(16);
+}
+
+static void run_b64_128(void) {
+    b64_encode(128);
+}
+
+static void run_b64_chunk(void) {
+    b64_encode(LUCIDUART_SSE_CHUNK_MAX);
+}
+
+/*
+ * /api/status document, built and printed as api_status_handler does
+ */
+
+static const web_system_status_t status_input = {
+    .uptime_sec = 86400,
+    .free_heap = 41234,
+    .firmware_version = "1.0.0",
+    .chip_model = "ESP8266",
+    .wifi_mode = "STA",
+    .ssid = "LucidConsole-Lab",
+    .ip_address = "192.168.1.42",
+    .rssi = -61,
+    .client_count = 0,
+    .uart_rx_count = 123456789,
+    .uart_tx_count = 4321,
+    .uart_baud_rate = 115200,
+    .uart_bridge_active = true,
+    .uart_autobaud = "locked",
+    .uart_autobaud_score = 97,
+};
+
+static void run_cjson_status(void) {
+    const web_system_status_t* s = &status_input;
+    cJSON* json = cJSON_CreateObject();
+    cJSON_AddItemToObject(json, "uptime_sec", cJSON_CreateNumber(s->uptime_sec));
+    cJSON_AddItemToObject(json, "free_heap", cJSON_CreateNumber(s->free_heap));
+    cJSON_AddItemToObject(json, "firmware_version", cJSON_CreateString(s->firmware_version));
+    cJSON_AddItemToObject(json, "chip_model", cJSON_CreateString(s->chip_model));
+    cJSON_AddItemToObject(json, "wifi_mode", cJSON_CreateString(s->wifi_mode));
+    cJSON_AddItemToObject(json, "ssid", cJSON_CreateString(s->ssid));
+    cJSON_AddItemToObject(json, "ip_address", cJSON_CreateString(s->ip_address));
+    cJSON_AddItemToObject(json, "rssi", cJSON_CreateNumber(s->rssi));
+    cJSON_AddItemToObject(json, "client_count", cJSON_CreateNumber(s->client_count));
+    cJSON_AddItemToObject(json, "uart_rx_count", cJSON_CreateNumber(s->uart_rx_count));
+    cJSON_AddItemToObject(json, "uart_tx_count", cJSON_CreateNumber(s->uart_tx_count));
+    cJSON_AddItemToObject(json, "uart_baud_rate", cJSON_CreateNumber(s->uart_baud_rate));
+    cJSON_AddItemToObject(json, "uart_bridge_active", cJSON_CreateBool(s->uart_bridge_active));
+    cJSON_AddItemToObject(json, "uart_autobaud", cJSON_CreateString(s->uart_autobaud));
+    cJSON_AddItemToObject(json, "uart_autobaud_score", cJSON_CreateNumber(s->uart_autobaud_score));
+
+    char* text = cJSON_Print(json);
+    bench_sink += strlen(text);
+    free(text);
+    cJSON_Delete(json);
+}
+
+/*
+ * OLED status screen
+ */
+
+static const ssd1306_t oled_dev = {
+    .width = OLED_WIDTH,
+    .height = OLED_HEIGHT,
+};
+static uint8_t oled_fb[OLED_FB_SIZE];
+
+static const oled_status_t oled_status_input = {
+    .uptime_sec = 86400,
+    .free_heap = 41234,
+    .wifi_state = OLED_WIFI_CONNECTED,
+    .wifi_ssid = "LucidConsole-Lab",
+    .ip_address = "192.168.1.42",
+    .rssi = -61,
+    .rx_count = 123456789,
+    .tx_count = 4321,
+};
+
+static void run_draw_string_sim(void) {
+    // One full 21-column status line
+    int width = ssd1306_draw_string(&oled_dev, oled_fb, &_fonts_glcd_5x7_info, 0, 8,
+                                    "STA: LucidConsole-Lab", OLED_COLOR_WHITE, OLED_COLOR_BLACK);
+    bench_sink += width + oled_fb[200];
+}
+
+static void run_status_format(void) {
+    // The four lines of oled_framebuffer_display_status, formatting only
+    const oled_status_t* s = &oled_status_input;
+    char line_buf[32];
+    int n = snprintf(line_buf, sizeof(line_buf), "LucidConsole %us", s->uptime_sec);
+    n += snprintf(line_buf, sizeof(line_buf), "STA: %s %ddBm", s->wifi_ssid, s->rssi);
+    n += snprintf(line_buf, sizeof(line_buf), "IP: %s", s->ip_address);
+    n += snprintf(line_buf, sizeof(line_buf), "%uK RX:%u TX:%u",
+                  s->free_heap / 1024, s->rx_count, s->tx_count);
+    bench_sink += n + line_buf[3];
+}
+
+static void display_status_setup(void) {
+    oled_framebuffer_init();
+}
+
+static void run_display_status(void) {
+    bench_sink += oled_framebuffer_display_status(&oled_status_input);
+}
+
+/*
+ * Stream kernels (per byte of UART or socket data)
+ */
+
+// Network bytes from a client: text with CR LF and escaped 0xFF
+static uint8_t telnet_input[BENCH_STREAM_LEN];
+static uint8_t telnet_output[BENCH_STREAM_LEN];
+static rfc2217_session_t telnet_session;
+
+static void telnet_setup(void) {
+    text_input_setup();
+    memcpy(telnet_input, text_input, sizeof(telnet_input));
+    for (size_t i = 0; i + 1 < sizeof(telnet_input); i += 97) {
+        telnet_input[i] = TELNET_IAC;
+        telnet_input[i + 1] = TELNET_IAC;
+    }
+    rfc2217_session_init(&telnet_session);
+}
+
+static void run_rfc2217_decode(void) {
+    size_t n = rfc2217_decode(&telnet_session, telnet_input, sizeof(telnet_input), telnet_output);
+    bench_sink += n + telnet_output[n / 2];
+}
+
+/*
+ * Case table: add new kernels here
+ */
+
+static const bench_case_t bench_cases[] = {
+    { "base64/16", "byte", 16, text_input_setup, run_b64_16 },
+    { "base64/128", "byte", 128, text_input_setup, run_b64_128 },
+    { "base64/sse_chunk", "byte", LUCIDUART_SSE_CHUNK_MAX, text_input_setup, run_b64_chunk },
+    { "cjson/api_status", "op", 1, NULL, run_cjson_status },
+    { "oled/draw_string_sim", "op", 1, NULL, run_draw_string_sim },
+    { "oled/status_format", "op", 1, NULL, run_status_format },
+    { "oled/display_status_sim", "op", 1, display_status_setup, run_display_status },
+    { "stream/rfc2217_decode", "byte", BENCH_STREAM_LEN, telnet_setup, run_rfc2217_decode },
+};
+
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+/*
+ * Measurement
+ */
+
+typedef struct {
+    double min;
+    double median;
+    double mean;
+    double stddev;
+    unsigned samples;
+    uint64_t iterations;        // Operations per sample
+} bench_result_t;
+
+static uint64_t run_for(const bench_case_t* c, uint64_t iterations) {
+    uint64_t start = now_ns();
+    for (uint64_t i = 0; i < iterations; i++) {
+        c->run();
+    }
+    return now_ns() - start;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Warm up, size a sample to the target time, then time the samples
+ *
+ * @return Statistics in ns per unit
+ */
+static bench_result_t bench_measure(const bench_case_t* c) {
+    static double per_unit[BENCH_MAX_SAMPLES];
+    bench_result_t r = { 0 };
+
+    if (c->setup) {
+        c->setup();
+    }
+
+    // Warmup doubles the batch until it alone fills the sample time
+    uint64_t iterations = 1;
+    uint64_t sample_ns = (uint64_t)bench_sample_ms * 1000000;
+    uint64_t warmup_end = now_ns() + (uint64_t)bench_warmup_ms * 1000000;
+    for (;;) {
+        uint64_t elapsed = run_for(c, iterations);
+        if (elapsed >= sample_ns && now_ns() >= warmup_end) {
+            break;
+        }
+        if (elapsed < sample_ns) {
+            iterations *= 2;
+        }
+    }
+
+    double units = (double)iterations * c->units_per_op;
+    for (unsigned i = 0; i < bench_samples; i++) {
+        per_unit[i] = run_for(c, iterations) / units;
+    }
+    qsort(per_unit, bench_samples, sizeof(per_unit[0]), compare_double);
+
+    double sum = 0;
+    for (unsigned i = 0; i < bench_samples; i++) {
+        sum += per_unit[i];
+    }
+    r.mean = sum / bench_samples;
+    double var = 0;
+    for (unsigned i = 0; i < bench_samples; i++) {
+        var += (per_unit[i] - r.mean) * (per_unit[i] - r.mean);
+    }
+    r.stddev = (bench_samples > 1) ? sqrt(var / (bench_samples - 1)) : 0;
+    r.min = per_unit[0];
+    r.median = (bench_samples % 2) ? per_unit[bench_samples / 2]
+                                   : (per_unit[bench_samples / 2 - 1] + per_unit[bench_samples / 2]) / 2;
+    r.samples = bench_samples;
+    r.iterations = iterations;
+    return r;
+}
+
+static bool bench_selected(const bench_case_t* c, char** filters, int count) {
+    if (count == 0) {
+        return true;
+    }
+    for (int i = 0; i < count; i++) {
+        if (strstr(c->name, filters[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [options] [filter...]\n"
+            "  -n, --samples N       Timed samples per benchmark (default %u, max %u)\n"
+            "  -t, --sample-ms MS    Target duration of one sample (default %u)\n"
+            "  -w, --warmup-ms MS    Minimum warmup per benchmark (default %u)\n"
+            "  -j, --json            Print results as JSON\n"
+            "  -l, --list            List benchmarks and exit\n"
+            "  -h, --help\n"
+            "Filters select benchmarks whose name contains any of them.\n",
+            argv0, bench_samples, BENCH_MAX_SAMPLES, bench_sample_ms, bench_warmup_ms);
+}
+
+int main(int argc, char** argv) {
+    static const struct option long_options[] = {
+        { "samples", required_argument, NULL, 'n' },
+        { "sample-ms", required_argument, NULL, 't' },
+        { "warmup-ms", required_argument, NULL, 'w' },
+        { "json", no_argument, NULL, 'j' },
+        { "list", no_argument, NULL, 'l' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+
+    bool json = false;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:t:w:jlh", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'n':
+                bench_samples = (unsigned)strtoul(optarg, NULL, 10);
+                if (bench_samples < 1 || bench_samples > BENCH_MAX_SAMPLES) {
+                    fprintf(stderr, "Samples must be 1..%u\n", BENCH_MAX_SAMPLES);
+                    return 2;
+                }
+                break;
+            case 't':
+                bench_sample_ms = (unsigned)strtoul(optarg, NULL, 10);
+                break;
+            case 'w':
+                bench_warmup_ms = (unsigned)strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                json = true;
+                break;
+            case 'l':
+                for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+                    printf("%s\n", bench_cases[i].name);
+                }
+                return 0;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+    char** filters = argv + optind;
+    int filter_count = argc - optind;
+
+    // Firmware code logs through the simulator; keep it off the results
+    sim_options.log_level = ESP_LOG_NONE;
+    sim_system_init();
+
+    if (json) {
+        printf("[\n");
+    } else {
+        printf("%-24s %-8s %10s %10s %10s %8s %12s\n",
+               "benchmark", "unit", "min", "median", "mean", "stddev", "samples");
+    }
+    bool first = true;
+    for (size_t i = 0; i < BENCH_CASE_COUNT; i++) {
+        const bench_case_t* c = &bench_cases[i];
+        if (!bench_selected(c, filters, filter_count)) {
+            continue;
+        }
+        bench_result_t r = bench_measure(c);
+        if (json) {
+            printf("%s  {\"name\": \"%s\", \"unit\": \"ns/%s\", \"min\": %.3f, \"median\": %.3f, "
+                   "\"mean\": %.3f, \"stddev\": %.3f, \"samples\": %u, \"iterations\": %llu}",
+                   first ? "" : ",\n", c->name, c->unit, r.min, r.median, r.mean, r.stddev,
+                   r.samples, (unsigned long long)r.iterations);
+        } else {
+            char unit[16];
+            char samples[24];
+            snprintf(unit, sizeof(unit), "ns/%s", c->unit);
+            snprintf(samples, sizeof(samples), "%ux%llu", r.samples, (unsigned long long)r.iterations);
+            printf("%-24s %-8s %10.2f %10.2f %10.2f %7.1f%% %12s\n",
+                   c->name, unit, r.min, r.median, r.mean,
+                   r.mean > 0 ? r.stddev / r.mean * 100 : 0, samples);
+        }
+        fflush(stdout);
+        first = false;
+    }
+    if (json) {
+        printf("\n]\n");
+    }
+    return 0;
+}
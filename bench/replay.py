@@ -0,0 +1,421 @@
+#!/usr/bin/env python3
+"""
+LucidConsole capture replay - play recorded UART traffic back at its original timing
+
+Capture files (.lcap) hold raw bytes plus the time between chunks, so real
+bursts such as boot floods or crash dumps can be replayed against new
+firmware. The format is described in main/uart/uart_replay.h:
+
+    header  "LCAP" | u16 version (1) | u16 flags (0)
+    record  u32 delta_us | u16 len | len payload bytes     (little-endian)
+
+Subcommands:
+
+    record  read a serial device or pty into a capture
+    import  turn a raw byte dump (e.g. GET /api/uart/capture) into a capture
+    info    summarize a capture
+    play    replay a capture into the bridge RX path while SSE and TCP
+            clients check that every byte reaches them
+
+play has two sources. With --source http the capture is POSTed to
+/api/uart/replay and the firmware schedules it on TX, which must loop back
+to RX (a jumper, or the simulator's --uart loopback). With --source pty
+this script writes the records into a serial adapter or the simulator's
+pty itself, with host timing.
+"""
+
+import argparse
+import json
+import os
+import select
+import shutil
+import signal
+import struct
+import subprocess
+import sys
+import termios
+import time
+import tty
+import urllib.error
+import urllib.request
+
+from bridge_bench import SseClient, TcpClient, PtySource, http_json, launch_sim, set_baud, stats_delta
+
+MAGIC = b'LCAP'
+VERSION = 1
+HEADER = struct.Struct('<4sHH')
+RECORD = struct.Struct('<IH')
+MAX_RECORD = 0xFFFF
+MAX_SPEED = 100
+
+
+def write_capture(path, records):
+    """records: iterable of (delta_us, payload); payloads over 64 KiB are split"""
+    count = 0
+    with open(path, 'wb') as f:
+        f.write(HEADER.pack(MAGIC, VERSION, 0))
+        for delta_us, payload in records:
+            for start in range(0, len(payload), MAX_RECORD):
+                f.write(RECORD.pack(min(delta_us, 0xFFFFFFFF), len(payload[start:start + MAX_RECORD])))
+                f.write(payload[start:start + MAX_RECORD])
+                delta_us = 0
+                count += 1
+    return count
+
+
+def read_capture(path):
+    """Returns [(delta_us, payload)]; raises ValueError on a bad file"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < HEADER.size:
+        raise ValueError('%s: too short for a capture' % path)
+    magic, version, _ = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError('%s: not a version %d capture' % (path, VERSION))
+    records = []
+    pos = HEADER.size
+    while pos < len(data):
+        if pos + RECORD.size > len(data):
+            raise ValueError('%s: truncated record header at %d' % (path, pos))
+        delta_us, length = RECORD.unpack_from(data, pos)
+        pos += RECORD.size
+        if pos + length > len(data):
+            raise ValueError('%s: truncated record at %d' % (path, pos))
+        records.append((delta_us, data[pos:pos + length]))
+        pos += length
+    return records
+
+
+def capture_info(records):
+    total = sum(len(p) for _, p in records)
+    span_us = sum(d for d, _ in records)
+    gaps = sorted(d for d, _ in records[1:])
+    # Peak rate: the densest 100 ms window of the capture
+    peak = 0
+    window = []
+    window_bytes = 0
+    clock = 0
+    for delta_us, payload in records:
+        clock += delta_us
+        window.append((clock, len(payload)))
+        window_bytes += len(payload)
+        while window[0][0] < clock - 100000:
+            window_bytes -= window.pop(0)[1]
+        peak = max(peak, window_bytes)
+    return {
+        'records': len(records),
+        'bytes': total,
+        'span_ms': round(span_us / 1000, 1),
+        'mean_bps': round(total / (span_us / 1e6), 1) if span_us else None,
+        'peak_100ms_bps': peak * 10,
+        'max_gap_ms': round(gaps[-1] / 1000, 1) if gaps else 0,
+        'median_gap_us': gaps[len(gaps) // 2] if gaps else 0,
+    }
+
+
+def cmd_record(args):
+    """Serial/pty to capture; every read() becomes one record"""
+    fd = os.open(args.device, os.O_RDONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        PtySource.set_speed(fd, args.baud)
+    records = []
+    total = 0
+    last = None
+    start = time.monotonic()
+    try:
+        while not args.duration or time.monotonic() - start < args.duration:
+            ready, _, _ = select.select([fd], [], [], 0.1)
+            if not ready:
+                continue
+            data = os.read(fd, 4096)
+            if not data:
+                break
+            now = time.monotonic_ns() // 1000
+            records.append((0 if last is None else now - last, data))
+            last = now
+            total += len(data)
+            if args.bytes and total >= args.bytes:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+    count = write_capture(args.capture, records)
+    print('%s: %d records, %d bytes' % (args.capture, count, total), file=sys.stderr)
+    return 0
+
+
+def cmd_import(args):
+    """Raw dump to capture: lines become records spaced at the line rate of --baud"""
+    with open(args.raw, 'rb') as f:
+        data = f.read()
+    records = []
+    delta_us = 0
+    pos = 0
+    while pos < len(data):
+        end = data.find(b'\n', pos, pos + args.max_record)
+        end = end + 1 if end >= 0 else min(pos + args.max_record, len(data))
+        records.append((delta_us, data[pos:end]))
+        # 10 bit times per byte (8N1); the next record starts when this one is off the wire
+        delta_us = (end - pos) * 10 * 1000000 // args.baud + args.gap_us
+        pos = end
+    count = write_capture(args.capture, records)
+    print('%s: %d records, %d bytes' % (args.capture, count, len(data)), file=sys.stderr)
+    return 0
+
+
+def cmd_info(args):
+    print(json.dumps(capture_info(read_capture(args.capture)), indent=2))
+    return 0
+
+
+class ByteChecker:
+    """Compares what a client receives with the capture payload, byte for byte"""
+
+    def __init__(self, expected):
+        self.expected = expected
+        self.received = 0
+        self.mismatch_at = None
+        self.first_us = None
+        self.last_us = None
+
+    def feed(self, data, recv_us):
+        if self.first_us is None:
+            self.first_us = recv_us
+        self.last_us = recv_us
+        if self.mismatch_at is None:
+            want = self.expected[self.received:self.received + len(data)]
+            if data != want:
+                self.mismatch_at = self.received + next(
+                    (i for i in range(min(len(data), len(want))) if data[i] != want[i]),
+                    min(len(data), len(want)))
+        self.received += len(data)
+
+    def done(self):
+        return self.received >= len(self.expected) or self.mismatch_at is not None
+
+    def report(self, _lines_sent):
+        return {
+            'received': self.received,
+            'expected': len(self.expected),
+            'match': self.mismatch_at is None and self.received == len(self.expected),
+            'first_mismatch': self.mismatch_at,
+            'receive_ms': round((self.last_us - self.first_us) / 1000, 1) if self.first_us else None,
+        }
+
+
+def replay_request(request, timeout):
+    try:
+        with urllib.request.urlopen(request, timeout=timeout) as response:
+            return response.status, json.loads(response.read())
+    except urllib.error.HTTPError as e:
+        text = e.read()
+        try:
+            return e.code, json.loads(text)
+        except ValueError:
+            return e.code, {'error': text.decode(errors='replace')}
+
+
+def post_replay(host, port, body, speed, timeout):
+    """Upload a capture, then poll until the replay task reports its outcome"""
+    url = 'http://%s:%d/api/uart/replay' % (host, port)
+    request = urllib.request.Request('%s?speed=%d' % (url, speed), data=body,
+                                     headers={'Content-Type': 'application/octet-stream'})
+    deadline = time.monotonic() + timeout
+    status, replay = replay_request(request, timeout)
+    if status != 202:
+        return status, replay
+    while replay.get('state') == 'running':
+        if time.monotonic() > deadline:
+            return status, dict(replay, error='timed out')
+        time.sleep(0.2)
+        status, replay = replay_request(url, 10)
+    return status, replay
+
+
+def play_pty(path, baud, records, speed):
+    """Host-timed playback into a serial device or pty; returns lateness stats"""
+    fd = os.open(path, os.O_WRONLY | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        PtySource.set_speed(fd, baud)
+    late = 0
+    max_late_us = 0
+    start = time.monotonic_ns() // 1000
+    due = start
+    try:
+        for delta_us, payload in records:
+            due += delta_us // speed
+            ahead = due - time.monotonic_ns() // 1000
+            if ahead > 0:
+                time.sleep(ahead / 1e6)
+            lag = time.monotonic_ns() // 1000 - due
+            max_late_us = max(max_late_us, lag)
+            late += lag > 1000
+            view = memoryview(payload)
+            while view:
+                view = view[os.write(fd, view):]
+        if os.isatty(fd):
+            # Closing with bytes still queued would hang up the line and lose them
+            termios.tcdrain(fd)
+    finally:
+        os.close(fd)
+    return {
+        'records': len(records),
+        'tx_bytes': sum(len(p) for _, p in records),
+        'elapsed_ms': round((time.monotonic_ns() // 1000 - start) / 1000, 1),
+        'late_records': late,
+        'max_late_us': max_late_us,
+    }
+
+
+def cmd_play(args):
+    records = read_capture(args.capture)
+    expected = b''.join(p for _, p in records)
+    info = capture_info(records)
+
+    sim_proc = None
+    sim_dir = None
+    if args.sim:
+        sim_proc, sim_dir = launch_sim(args)
+        if args.source == 'pty' and not args.pty:
+            args.pty = os.path.join(sim_dir, 'uart.pty')
+
+    try:
+        if args.baud:
+            set_baud(args.host, args.rfc2217_port, args.baud)
+        stats_before = http_json(args.host, args.http_port, '/api/uart/stats')
+
+        clients = []
+        for i in range(args.sse):
+            clients.append(SseClient('sse%d' % i, args.host, args.http_port,
+                                     ByteChecker(expected), args.sse_query))
+        for i in range(args.tcp):
+            clients.append(TcpClient('tcp%d' % i, args.host, args.tcp_port, ByteChecker(expected)))
+        for client in clients:
+            client.start()
+        for client in clients:
+            client.connected.wait(5)
+        time.sleep(0.5)             # Let the bridge register every cursor
+
+        if args.source == 'http':
+            with open(args.capture, 'rb') as f:
+                body = f.read()
+            timeout = info['span_ms'] / 1000 / args.speed + 60
+            status, replay = post_replay(args.host, args.http_port, body, args.speed, timeout)
+        else:
+            status, replay = None, play_pty(args.pty, args.baud, records, args.speed)
+
+        deadline = time.monotonic() + args.drain
+        while time.monotonic() < deadline and not all(c.checker.done() for c in clients):
+            time.sleep(0.1)
+        for client in clients:
+            client.stop.set()
+        for client in clients:
+            client.join(2)
+
+        stats_after = http_json(args.host, args.http_port, '/api/uart/stats')
+        reports = [c.report(0) for c in clients]
+        result = {
+            'label': args.label,
+            'timestamp': time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+            'capture': dict(info, file=os.path.basename(args.capture)),
+            'source': args.source,
+            'speed': args.speed,
+            'replay': replay,
+            'clients': reports,
+            'device': stats_delta(stats_before, stats_after),
+        }
+        if status is not None:
+            result['http_status'] = status
+    finally:
+        if sim_proc:
+            sim_proc.send_signal(signal.SIGTERM)
+            try:
+                sim_proc.wait(5)
+            except subprocess.TimeoutExpired:
+                sim_proc.kill()
+            shutil.rmtree(sim_dir, ignore_errors=True)
+
+    ok = all(r['match'] for r in reports) and (status in (None, 200))
+    if args.source == 'http':
+        ok = ok and replay.get('state') == 'done' and bool(replay.get('rx_verified'))
+    result['ok'] = ok
+
+    text = json.dumps(result, indent=2)
+    if args.out:
+        with open(args.out, 'w') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+    return 0 if ok else 1
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='LucidConsole capture record/replay')
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    record = commands.add_parser('record', help='Record a serial device or pty into a capture')
+    record.add_argument('device', help='Serial device or pty to read')
+    record.add_argument('capture', help='Output .lcap file')
+    record.add_argument('--baud', type=int, default=115200, help='Serial speed (ignored by a pty)')
+    record.add_argument('--duration', type=float, default=0, help='Stop after this many seconds (0 = Ctrl-C)')
+    record.add_argument('--bytes', type=int, default=0, help='Stop after this many bytes')
+
+    raw = commands.add_parser('import', help='Convert a raw byte dump into a capture')
+    raw.add_argument('raw', help='Raw file, e.g. a /api/uart/capture download')
+    raw.add_argument('capture', help='Output .lcap file')
+    raw.add_argument('--baud', type=int, default=115200, help='Line rate the records are spaced at')
+    raw.add_argument('--gap-us', type=int, default=0, help='Extra idle time after every record')
+    raw.add_argument('--max-record', type=int, default=1024, help='Longest record when no newline comes')
+
+    info = commands.add_parser('info', help='Summarize a capture')
+    info.add_argument('capture')
+
+    play = commands.add_parser('play', help='Replay a capture and check every client got it intact')
+    play.add_argument('capture')
+    play.add_argument('--speed', type=int, default=1, help='Time scale, 1 (real time) to %d' % MAX_SPEED)
+    play.add_argument('--source', choices=('http', 'pty'), default='http',
+                      help='http: POST /api/uart/replay, TX looped to RX; pty: write a serial device/pty')
+    play.add_argument('--pty', metavar='PATH', help='Serial device or pty (default: the launched simulator\'s)')
+    play.add_argument('--host', default='127.0.0.1', help='Device or simulator address')
+    play.add_argument('--http-port', type=int, default=8080,
+                      help='HTTP port (8080 = simulator default, 80 on a device)')
+    play.add_argument('--tcp-port', type=int, default=2323, help='Raw TCP bridge port')
+    play.add_argument('--rfc2217-port', type=int, default=2217, help='RFC 2217 port used by --baud')
+    play.add_argument('--baud', type=int, help='Pin the UART to this baud first (default 115200 with --sim)')
+    play.add_argument('--sim', metavar='BINARY', help='Launch this simulator build for the run')
+    play.add_argument('--sim-pace', choices=('on', 'off'), help='Passed to the simulator as --pace')
+    play.add_argument('--sse', type=int, default=1, help='Concurrent SSE clients')
+    play.add_argument('--tcp', type=int, default=1, help='Concurrent raw TCP clients')
+    play.add_argument('--sse-query', default='', help='Extra stream query, e.g. "policy=drop-client"')
+    play.add_argument('--drain', type=float, default=2.0, help='Seconds to wait for clients after the replay')
+    play.add_argument('--label', default='', help='Free-form run label stored in the result')
+    play.add_argument('--out', metavar='FILE', help='Write the JSON result here (default: stdout)')
+    args = parser.parse_args()
+
+    if args.command == 'play':
+        if not 1 <= args.speed <= MAX_SPEED:
+            parser.error('--speed must be 1 to %d' % MAX_SPEED)
+        if args.source == 'pty' and not args.pty and not args.sim:
+            parser.error('--source pty needs --pty PATH or --sim')
+        if args.sim and args.http_port < 80:
+            parser.error('--sim maps port 80 to --http-port, which must be >= 80')
+        if args.sim and args.baud is None:
+            args.baud = 115200
+    return args
+
+
+def main():
+    args = parse_args()
+    handler = {'record': cmd_record, 'import': cmd_import, 'info': cmd_info, 'play': cmd_play}
+    try:
+        return handler[args.command](args)
+    except (OSError, ValueError, RuntimeError) as e:
+        print('error: %s' % e, file=sys.stderr)
+        return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -2,10 +2,20 @@
 CFLAGS += -I$(CURDIR)/../../boards/$(BOARD)
 
 # Include subdirectories for headers
-COMPONENT_ADD_INCLUDEDIRS := . bus hardware display wifi web uart
+COMPONENT_ADD_INCLUDEDIRS := . bus hardware display wifi web uart tcp
 
 # All source files including subdirectories
-COMPONENT_SRCDIRS := . bus hardware display wifi web uart
+COMPONENT_SRCDIRS := . bus hardware display wifi web uart tcp
+
+# Dashboard page: inlined, minified and gzipped into a header at build time
+DASHBOARD_DIR := $(COMPONENT_PATH)/web/dashboard
+CFLAGS += -I$(COMPONENT_BUILD_DIR)
+COMPONENT_EXTRA_CLEAN := dashboard_assets.h
+
+web/web_server.o: dashboard_assets.h
+
+dashboard_assets.h: $(wildcard $(DASHBOARD_DIR)/*) $(COMPONENT_PATH)/../scripts/gen_dashboard.py
+	$(PYTHON) $(COMPONENT_PATH)/../scripts/gen_dashboard.py $(DASHBOARD_DIR) $@
 
 # Component dependencies - add SSD1306 and fonts libraries
 COMPONENT_DEPENDS := ssd1306 fonts
@@ -75,6 +75,46 @@
 #define CONFIG_UART_RX_PIN       3      // GPIO3 (RX)
 #define CONFIG_UART_BUFFER_SIZE  1024   // UART buffer size
 
+/**
+ * Automatic Baud-Rate Detection
+ * 
+ * Set to 1 to sweep candidate rates at boot (115200, 74880, 921600, ...)
+ * and lock onto the one producing clean console text.
+ * CONFIG_UART_BAUD_RATE is used until a rate locks, and is restored if
+ * none does. TX is held while the sweep runs, which lasts about 70 s
+ * on a silent target, so leave this off for targets with a known rate.
+ */
+#define CONFIG_UART_AUTOBAUD     0
+
+/**
+ * Software Flow Control
+ * 
+ * Set to 1 for targets that honor XON/XOFF: the bridge holds the target
+ * off while network clients lag instead of dropping bytes, and pauses
+ * its own TX when the target sends XOFF. 0x11/0x13 are then removed
+ * from the RX stream, so leave this off for binary protocols.
+ */
+#define CONFIG_UART_XONXOFF      0
+
+/**
+ * Compressed RX History
+ * 
+ * Set to 1 to keep older console output as LZSS-compressed blocks
+ * (8 KB store, typically 3-5x that of text). The RX ring then shrinks
+ * from 16 KB to 8 KB, since it no longer has to serve as scrollback.
+ * Served by /api/uart/history and used to fill gaps on SSE resume.
+ */
+#define CONFIG_UART_HISTORY      1
+
+/**
+ * Persistent Capture
+ * 
+ * Set to 1 to append all RX data to the "capture" flash partition so it
+ * survives reboots; download it from /api/uart/capture. Needs a board
+ * partition table with a capture partition (see partitions_ota.csv).
+ */
+#define CONFIG_UART_CAPTURE      1
+
 // ========================================
 // WIFI CONFIGURATION
 // ========================================
@@ -26,6 +26,10 @@
 
 // UART bridge system
 #include "uart/uart_bridge.h"
+#include "uart/trigger_engine.h"
+#include "uart/lz_history.h"
+#include "uart/flash_capture.h"
+#include "tcp/tcp_bridge.h"
 
 static const char* TAG = "LUCIDUART";
 
@@ -145,6 +149,10 @@ static void status_logging_task(void* pvParameters) {
         uptime_seconds = xTaskGetTickCount() * portTICK_PERIOD_MS / 1000;
         update_count++;
         
+        // Debug level only: the log shares UART0 with the bridged target
+        ESP_LOGD(TAG, "Status #%u: uptime %u s, heap %u bytes",
+                 update_count, uptime_seconds, esp_get_free_heap_size());
+        
         vTaskDelay(pdMS_TO_TICKS(1000)); // Update every 1 second
     }
 }
@@ -172,19 +180,43 @@ void app_main(void) {
     
     // Initialize UART bridge system
     uart_bridge_config_t uart_config = {
-        .baud_rate = 115200,
+        .baud_rate = CONFIG_UART_BAUD_RATE,
         .data_bits = UART_DATA_8_BITS,
         .parity = UART_PARITY_DISABLE,
         .stop_bits = UART_STOP_BITS_1,
         .echo_enabled = false,
-        .timestamp_enabled = false
+        .timestamp_enabled = true,         // Device-side line stamps for SSE clients
+        .irq_profile = UART_BRIDGE_IRQ_AUTO,    // Low-latency below 460800 baud
+        .xonxoff_enabled = CONFIG_UART_XONXOFF
     };
     ESP_ERROR_CHECK(uart_bridge_init(&uart_config));
     ESP_ERROR_CHECK(uart_bridge_start());
     
-    // Connect web server to UART bridge
+    #if CONFIG_UART_AUTOBAUD
+    // Targets boot at mixed rates; lock onto whichever one is talking
+    uart_bridge_autobaud_start(NULL, 0);
+    #endif
+    
+    // On-device pattern matching; idle until patterns arrive via /api/triggers
+    ESP_ERROR_CHECK(trigger_engine_init());
+    
+    #if CONFIG_UART_HISTORY
+    // Compressed scrollback behind the RX ring
+    ESP_ERROR_CHECK(lz_history_init());
+    #endif
+    
+    #if CONFIG_UART_CAPTURE
+    // Flash log archive; boards without a capture partition run without it
+    if (flash_capture_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Persistent capture disabled");
+    }
+    #endif
+    
+    // Connect web server to UART bridge (SSE clients read their own RX cursors)
     web_server_set_uart_callbacks(uart_bridge_get_rx_count, uart_bridge_get_tx_count);
-    ESP_ERROR_CHECK(uart_bridge_set_rx_callback(web_server_broadcast_uart_data));
+    
+    // Raw TCP serial port for nc/socat/screen
+    ESP_ERROR_CHECK(tcp_bridge_init());
     
     #if CONFIG_ENABLE_OLED_DISPLAY
     // OLED initialization
@@ -0,0 +1,551 @@
+/*
+ * RFC 2217 - LucidConsole Telnet COM Port Control Implementation
+ * Telnet option negotiation, IAC escaping and COM-PORT-OPTION commands
+ */
+
+#include "rfc2217.h"
+#include "../uart/uart_bridge.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char* TAG = "RFC2217";
+
+// Telnet options we understand
+#define TELNET_OPT_BINARY       0
+#define TELNET_OPT_SGA          3
+#define TELNET_OPT_COM_PORT     44
+
+#define OPT_BIT_BINARY          0x01
+#define OPT_BIT_SGA             0x02
+#define OPT_BIT_COM_PORT        0x04
+
+// COM-PORT-OPTION commands (client -> server; server replies add 100)
+#define CPO_SIGNATURE           0
+#define CPO_SET_BAUDRATE        1
+#define CPO_SET_DATASIZE        2
+#define CPO_SET_PARITY          3
+#define CPO_SET_STOPSIZE        4
+#define CPO_SET_CONTROL         5
+#define CPO_FLOWCONTROL_SUSPEND 8
+#define CPO_FLOWCONTROL_RESUME  9
+#define CPO_SET_LINESTATE_MASK  10
+#define CPO_SET_MODEMSTATE_MASK 11
+#define CPO_PURGE_DATA          12
+#define CPO_SERVER_OFFSET       100
+
+// Parser states
+enum {
+    PARSE_DATA = 0,
+    PARSE_IAC,
+    PARSE_OPTION,
+    PARSE_SUBNEG,
+    PARSE_SUBNEG_IAC,
+};
+
+// Line settings recorded in rfc2217_session_t.pending_mask
+#define PENDING_BAUD            0x01
+#define PENDING_DATASIZE        0x02
+#define PENDING_PARITY          0x04
+#define PENDING_STOPSIZE        0x08
+#define PENDING_XONXOFF         0x10
+
+static const char signature[] = "LucidConsole ESP8266";
+
+/**
+ * @brief Append raw bytes to the reply buffer
+ */
+static void reply_put(rfc2217_session_t* s, const uint8_t* data, size_t len) {
+    if (s->reply_len + len > sizeof(s->reply)) {
+        ESP_LOGW(TAG, "Reply buffer full, dropping %u bytes", (unsigned)len);
+        return;
+    }
+    memcpy(s->reply + s->reply_len, data, len);
+    s->reply_len += len;
+}
+
+/**
+ * @brief Queue IAC <command> <option>
+ */
+static void reply_negotiate(rfc2217_session_t* s, uint8_t command, uint8_t option) {
+    const uint8_t msg[] = { TELNET_IAC, command, option };
+    reply_put(s, msg, sizeof(msg));
+}
+
+/**
+ * @brief Queue IAC SB COM-PORT-OPTION <command> <value...> IAC SE
+ */
+static void reply_subneg(rfc2217_session_t* s, uint8_t command, const uint8_t* value, size_t len) {
+    const uint8_t head[] = { TELNET_IAC, TELNET_SB, TELNET_OPT_COM_PORT, command };
+    const uint8_t tail[] = { TELNET_IAC, TELNET_SE };
+    
+    reply_put(s, head, sizeof(head));
+    for (size_t i = 0; i < len; i++) {
+        // Values are IAC-escaped inside subnegotiation too
+        if (value[i] == TELNET_IAC) {
+            reply_put(s, &value[i], 1);
+        }
+        reply_put(s, &value[i], 1);
+    }
+    reply_put(s, tail, sizeof(tail));
+}
+
+static uint8_t option_bit(uint8_t option) {
+    switch (option) {
+        case TELNET_OPT_BINARY:   return OPT_BIT_BINARY;
+        case TELNET_OPT_SGA:      return OPT_BIT_SGA;
+        case TELNET_OPT_COM_PORT: return OPT_BIT_COM_PORT;
+        default:                  return 0;
+    }
+}
+
+/**
+ * @brief Handle WILL/WONT/DO/DONT without negotiation loops
+ */
+static void handle_option(rfc2217_session_t* s, uint8_t command, uint8_t option) {
+    uint8_t bit = option_bit(option);
+    
+    switch (command) {
+        case TELNET_DO:
+            if (!bit) {
+                reply_negotiate(s, TELNET_WONT, option);
+            } else if (!(s->local_opts & bit)) {
+                s->local_opts |= bit;
+                reply_negotiate(s, TELNET_WILL, option);
+            }
+            break;
+            
+        case TELNET_DONT:
+            if (s->local_opts & bit) {
+                s->local_opts &= ~bit;
+                reply_negotiate(s, TELNET_WONT, option);
+            }
+            break;
+            
+        case TELNET_WILL:
+            // The client never performs COM-PORT-OPTION for us
+            if (!bit || bit == OPT_BIT_COM_PORT) {
+                reply_negotiate(s, TELNET_DONT, option);
+            } else if (!(s->remote_opts & bit)) {
+                s->remote_opts |= bit;
+                reply_negotiate(s, TELNET_DO, option);
+            }
+            break;
+            
+        case TELNET_WONT:
+            if (s->remote_opts & bit) {
+                s->remote_opts &= ~bit;
+                reply_negotiate(s, TELNET_DONT, option);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Copy the settings named in mask from one configuration to another
+ */
+static void overlay_config(uart_bridge_config_t* config, const uart_bridge_config_t* from, uint8_t mask) {
+    if (mask & PENDING_BAUD) {
+        config->baud_rate = from->baud_rate;
+    }
+    if (mask & PENDING_DATASIZE) {
+        config->data_bits = from->data_bits;
+    }
+    if (mask & PENDING_PARITY) {
+        config->parity = from->parity;
+    }
+    if (mask & PENDING_STOPSIZE) {
+        config->stop_bits = from->stop_bits;
+    }
+    if (mask & PENDING_XONXOFF) {
+        config->xonxoff_enabled = from->xonxoff_enabled;
+    }
+}
+
+/**
+ * @brief Configuration as the client sees it: active plus not yet applied
+ */
+static void session_config(const rfc2217_session_t* s, uart_bridge_config_t* config) {
+    uart_bridge_get_config(config);
+    overlay_config(config, &s->pending, s->pending_mask);
+}
+
+/**
+ * @brief Record a requested setting for rfc2217_apply_pending
+ */
+static void request_config(rfc2217_session_t* s, const uart_bridge_config_t* config, uint8_t mask) {
+    overlay_config(&s->pending, config, mask);
+    s->pending_mask |= mask;
+}
+
+static uint8_t datasize_to_wire(uart_word_length_t bits) {
+    return 5 + (uint8_t)(bits - UART_DATA_5_BITS);
+}
+
+static uint8_t parity_to_wire(uart_parity_t parity) {
+    switch (parity) {
+        case UART_PARITY_ODD:  return 2;
+        case UART_PARITY_EVEN: return 3;
+        default:               return 1;
+    }
+}
+
+static uint8_t stopsize_to_wire(uart_stop_bits_t stop) {
+    switch (stop) {
+        case UART_STOP_BITS_2:   return 2;
+        case UART_STOP_BITS_1_5: return 3;
+        default:                 return 1;
+    }
+}
+
+/**
+ * @brief Reply to a SET-BAUDRATE, -DATASIZE, -PARITY or -STOPSIZE
+ */
+static void reply_line_setting(rfc2217_session_t* s, uint8_t command, const uart_bridge_config_t* config) {
+    uint8_t value[4];
+    size_t len = 1;
+    
+    switch (command) {
+        case CPO_SET_BAUDRATE:
+            value[0] = config->baud_rate >> 24;
+            value[1] = config->baud_rate >> 16;
+            value[2] = config->baud_rate >> 8;
+            value[3] = config->baud_rate;
+            len = 4;
+            break;
+        case CPO_SET_DATASIZE:
+            value[0] = datasize_to_wire(config->data_bits);
+            break;
+        case CPO_SET_PARITY:
+            // MARK/SPACE are not supported; reply with what is active
+            value[0] = parity_to_wire(config->parity);
+            break;
+        default:
+            value[0] = stopsize_to_wire(config->stop_bits);
+            break;
+    }
+    reply_subneg(s, command + CPO_SERVER_OFFSET, value, len);
+}
+
+/**
+ * @brief Reply now, or once the setting is applied if one is pending
+ */
+static void confirm_line_setting(rfc2217_session_t* s, uint8_t command, uint8_t mask,
+                                 const uart_bridge_config_t* config) {
+    if (s->pending_mask & mask) {
+        s->confirm_mask |= mask;
+    } else {
+        reply_line_setting(s, command, config);
+    }
+}
+
+/**
+ * @brief Switch XON/XOFF flow control (shared by both directions)
+ */
+static void set_xonxoff(rfc2217_session_t* s, bool enabled) {
+    uart_bridge_config_t config;
+    session_config(s, &config);
+    if (config.xonxoff_enabled != enabled) {
+        config.xonxoff_enabled = enabled;
+        request_config(s, &config, PENDING_XONXOFF);
+    }
+}
+
+/**
+ * @brief Handle SET-CONTROL (flow control, break, DTR, RTS)
+ */
+static uint8_t handle_set_control(rfc2217_session_t* s, uint8_t value) {
+    uart_bridge_config_t config;
+    session_config(s, &config);
+    
+    switch (value) {
+        case 0: case 3:
+            return config.xonxoff_enabled ? 2 : 1;      // No hardware flow control pins
+        case 1: case 2:
+            set_xonxoff(s, value == 2);
+            return value;
+        case 4: case 5: case 6:
+            return 6;       // BREAK not supported, always off
+        case 7:
+            return s->dtr ? 8 : 9;
+        case 8: case 9:
+            s->dtr = (value == 8);
+            return value;
+        case 10:
+            return s->rts ? 11 : 12;
+        case 11: case 12:
+            s->rts = (value == 11);
+            return value;
+        case 13: case 16:
+            return config.xonxoff_enabled ? 15 : 14;
+        case 14: case 15:
+            set_xonxoff(s, value == 15);
+            return value;
+        default:
+            return value;
+    }
+}
+
+/**
+ * @brief Handle one complete COM-PORT-OPTION subnegotiation
+ */
+static void handle_com_port(rfc2217_session_t* s, uint8_t command, const uint8_t* value, size_t len) {
+    uart_bridge_config_t config;
+    session_config(s, &config);
+    uint8_t reply = command + CPO_SERVER_OFFSET;
+    
+    switch (command) {
+        case CPO_SIGNATURE:
+            if (len == 0) {
+                reply_subneg(s, reply, (const uint8_t*)signature, sizeof(signature) - 1);
+            } else {
+                ESP_LOGI(TAG, "Client signature: %.*s", (int)len, (const char*)value);
+            }
+            break;
+            
+        case CPO_SET_BAUDRATE: {
+            if (len < 4) {
+                break;
+            }
+            uint32_t baud = ((uint32_t)value[0] << 24) | ((uint32_t)value[1] << 16) |
+                            ((uint32_t)value[2] << 8) | value[3];
+            if (baud != 0) {
+                // Recorded even when unchanged, so applying it pins the rate
+                // if auto-baud happens to be probing it right now
+                config.baud_rate = baud;
+                request_config(s, &config, PENDING_BAUD);
+            }
+            confirm_line_setting(s, command, PENDING_BAUD, &config);
+            break;
+        }
+            
+        case CPO_SET_DATASIZE:
+            if (len >= 1 && value[0] >= 5 && value[0] <= 8 &&
+                value[0] != datasize_to_wire(config.data_bits)) {
+                config.data_bits = UART_DATA_5_BITS + (value[0] - 5);
+                request_config(s, &config, PENDING_DATASIZE);
+            }
+            confirm_line_setting(s, command, PENDING_DATASIZE, &config);
+            break;
+            
+        case CPO_SET_PARITY:
+            if (len >= 1 && value[0] >= 1 && value[0] <= 3 &&
+                value[0] != parity_to_wire(config.parity)) {
+                static const uart_parity_t map[] = {
+                    UART_PARITY_DISABLE, UART_PARITY_DISABLE, UART_PARITY_ODD, UART_PARITY_EVEN
+                };
+                config.parity = map[value[0]];
+                request_config(s, &config, PENDING_PARITY);
+            }
+            confirm_line_setting(s, command, PENDING_PARITY, &config);
+            break;
+            
+        case CPO_SET_STOPSIZE:
+            if (len >= 1 && value[0] >= 1 && value[0] <= 3 &&
+                value[0] != stopsize_to_wire(config.stop_bits)) {
+                static const uart_stop_bits_t map[] = {
+                    UART_STOP_BITS_1, UART_STOP_BITS_1, UART_STOP_BITS_2, UART_STOP_BITS_1_5
+                };
+                config.stop_bits = map[value[0]];
+                request_config(s, &config, PENDING_STOPSIZE);
+            }
+            confirm_line_setting(s, command, PENDING_STOPSIZE, &config);
+            break;
+            
+        case CPO_SET_CONTROL:
+            if (len >= 1) {
+                uint8_t current = handle_set_control(s, value[0]);
+                reply_subneg(s, reply, &current, 1);
+            }
+            break;
+            
+        case CPO_FLOWCONTROL_SUSPEND:
+            s->suspended = true;
+            break;
+            
+        case CPO_FLOWCONTROL_RESUME:
+            s->suspended = false;
+            break;
+            
+        case CPO_SET_LINESTATE_MASK:
+            if (len >= 1) {
+                s->linestate_mask = value[0];
+                reply_subneg(s, reply, &s->linestate_mask, 1);
+            }
+            break;
+            
+        case CPO_SET_MODEMSTATE_MASK:
+            if (len >= 1) {
+                s->modemstate_mask = value[0];
+                reply_subneg(s, reply, &s->modemstate_mask, 1);
+            }
+            break;
+            
+        case CPO_PURGE_DATA:
+            if (len >= 1 && value[0] >= 1 && value[0] <= 3) {
+                bool rx = (value[0] & 1) != 0;
+                uart_bridge_purge(rx, (value[0] & 2) != 0);
+                s->purge_rx |= rx;
+                reply_subneg(s, reply, value, 1);
+            }
+            break;
+            
+        default:
+            ESP_LOGD(TAG, "Unhandled COM-PORT-OPTION command %u", command);
+            break;
+    }
+}
+
+void rfc2217_session_init(rfc2217_session_t* session) {
+    memset(session, 0, sizeof(*session));
+    
+    // Offer our side up front; the client's DO/WILL replies are acknowledgements
+    session->local_opts = OPT_BIT_COM_PORT | OPT_BIT_BINARY | OPT_BIT_SGA;
+    session->remote_opts = OPT_BIT_BINARY;
+    session->dtr = true;
+    session->rts = true;
+    reply_negotiate(session, TELNET_WILL, TELNET_OPT_COM_PORT);
+    reply_negotiate(session, TELNET_WILL, TELNET_OPT_BINARY);
+    reply_negotiate(session, TELNET_DO, TELNET_OPT_BINARY);
+    reply_negotiate(session, TELNET_WILL, TELNET_OPT_SGA);
+}
+
+size_t rfc2217_decode(rfc2217_session_t* s, const uint8_t* in, size_t len, uint8_t* out) {
+    size_t out_len = 0;
+    
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = in[i];
+        
+        switch (s->parse_state) {
+            case PARSE_DATA:
+                if (b == TELNET_IAC) {
+                    s->parse_state = PARSE_IAC;
+                    break;
+                }
+                // Without BINARY the client sends CR as CR NUL
+                if (s->cr_seen && b == 0 && !(s->remote_opts & OPT_BIT_BINARY)) {
+                    s->cr_seen = false;
+                    break;
+                }
+                s->cr_seen = (b == '\r');
+                out[out_len++] = b;
+                break;
+                
+            case PARSE_IAC:
+                switch (b) {
+                    case TELNET_IAC:
+                        out[out_len++] = TELNET_IAC;
+                        s->parse_state = PARSE_DATA;
+                        break;
+                    case TELNET_WILL:
+                    case TELNET_WONT:
+                    case TELNET_DO:
+                    case TELNET_DONT:
+                        s->command = b;
+                        s->parse_state = PARSE_OPTION;
+                        break;
+                    case TELNET_SB:
+                        s->subneg_len = 0;
+                        s->subneg_overflow = false;
+                        s->parse_state = PARSE_SUBNEG;
+                        break;
+                    default:
+                        // NOP, GA, AYT and friends carry no payload
+                        s->parse_state = PARSE_DATA;
+                        break;
+                }
+                break;
+                
+            case PARSE_OPTION:
+                handle_option(s, s->command, b);
+                s->parse_state = PARSE_DATA;
+                break;
+                
+            case PARSE_SUBNEG:
+                if (b == TELNET_IAC) {
+                    s->parse_state = PARSE_SUBNEG_IAC;
+                } else if (s->subneg_len < sizeof(s->subneg)) {
+                    s->subneg[s->subneg_len++] = b;
+                } else {
+                    s->subneg_overflow = true;
+                }
+                break;
+                
+            case PARSE_SUBNEG_IAC:
+                if (b == TELNET_IAC) {
+                    if (s->subneg_len < sizeof(s->subneg)) {
+                        s->subneg[s->subneg_len++] = TELNET_IAC;
+                    }
+                    s->parse_state = PARSE_SUBNEG;
+                    break;
+                }
+                if (b == TELNET_SE && !s->subneg_overflow && s->subneg_len >= 2 &&
+                    s->subneg[0] == TELNET_OPT_COM_PORT) {
+                    handle_com_port(s, s->subneg[1], &s->subneg[2], s->subneg_len - 2);
+                }
+                s->parse_state = PARSE_DATA;
+                break;
+        }
+    }
+    
+    return out_len;
+}
+
+void rfc2217_apply_pending(rfc2217_session_t* session) {
+    if (session->pending_mask == 0) {
+        return;
+    }
+    
+    // An explicit setting from the client wins over auto-baud; cancelling
+    // first also restores the rate a running sweep was probing
+    uart_bridge_autobaud_cancel();
+    
+    uart_bridge_config_t config;
+    uart_bridge_get_config(&config);
+    uart_bridge_config_t requested = config;
+    overlay_config(&requested, &session->pending, session->pending_mask);
+    session->pending_mask = 0;
+    
+    if (memcmp(&requested, &config, sizeof(config)) == 0) {
+        return;
+    }
+    esp_err_t ret = uart_bridge_update_config(&requested);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "UART reconfiguration failed: %s", esp_err_to_name(ret));
+    }
+}
+
+void rfc2217_confirm_pending(rfc2217_session_t* session) {
+    static const struct {
+        uint8_t mask;
+        uint8_t command;
+    } settings[] = {
+        { PENDING_BAUD, CPO_SET_BAUDRATE },
+        { PENDING_DATASIZE, CPO_SET_DATASIZE },
+        { PENDING_PARITY, CPO_SET_PARITY },
+        { PENDING_STOPSIZE, CPO_SET_STOPSIZE },
+    };
+    
+    if (session->confirm_mask == 0) {
+        return;
+    }
+    
+    uart_bridge_config_t config;
+    uart_bridge_get_config(&config);
+    for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); i++) {
+        if (session->confirm_mask & settings[i].mask) {
+            reply_line_setting(session, settings[i].command, &config);
+        }
+    }
+    session->confirm_mask = 0;
+}
+
+void rfc2217_signal_flow(rfc2217_session_t* session, bool suspend) {
+    if (session->suspend_sent == suspend) {
+        return;
+    }
+    
+    session->suspend_sent = suspend;
+    reply_subneg(session,
+                 (suspend ? CPO_FLOWCONTROL_SUSPEND : CPO_FLOWCONTROL_RESUME) + CPO_SERVER_OFFSET,
+                 NULL, 0);
+}
@@ -0,0 +1,123 @@
+/*
+ * RFC 2217 - LucidConsole Telnet COM Port Control
+ * Telnet codec that lets pySerial rfc2217:// and ser2net clients
+ * change UART parameters in-band
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "../uart/uart_bridge.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// RFC 2217 server configuration
+#define LUCIDUART_RFC2217_PORT          2217    // Standard-ish RFC 2217 port
+#define LUCIDUART_RFC2217_MAX_CLIENTS   1       // One controlling client at a time
+#define RFC2217_REPLY_MAX               96      // Pending negotiation/reply bytes
+#define RFC2217_SUBNEG_MAX              16      // Longest accepted subnegotiation
+
+// Telnet protocol bytes
+#define TELNET_IAC      255
+#define TELNET_DONT     254
+#define TELNET_DO       253
+#define TELNET_WONT     252
+#define TELNET_WILL     251
+#define TELNET_SB       250
+#define TELNET_SE       240
+
+// Per-connection telnet/COM-PORT-OPTION state
+typedef struct {
+    uint8_t parse_state;            // Telnet parser state
+    uint8_t command;                // WILL/WONT/DO/DONT being parsed
+    uint8_t subneg[RFC2217_SUBNEG_MAX];
+    uint8_t subneg_len;
+    bool subneg_overflow;
+    bool cr_seen;                   // NVT CR NUL stripping
+
+    uint8_t local_opts;             // Options we agreed to perform (WILL)
+    uint8_t remote_opts;            // Options the client performs (DO)
+
+    bool suspended;                 // Client asked us to stop sending (FLOWCONTROL-SUSPEND)
+    bool suspend_sent;              // We asked the client to stop sending
+    bool purge_rx;                  // Client purged RX; transport should skip ahead
+    uint8_t linestate_mask;
+    uint8_t modemstate_mask;
+    bool dtr;                       // Emulated modem lines - UART0 has no DTR/RTS
+    bool rts;
+
+    uint8_t pending_mask;           // Line settings waiting for rfc2217_apply_pending
+    uart_bridge_config_t pending;   // Requested values of those settings
+    uint8_t confirm_mask;           // Line settings whose replies wait for rfc2217_confirm_pending
+
+    uint8_t reply[RFC2217_REPLY_MAX];   // Bytes to send to the client
+    size_t reply_len;
+} rfc2217_session_t;
+
+/**
+ * @brief Initialize a session and queue the server's option offers
+ *
+ * Offers COM-PORT-OPTION, BINARY and SUPPRESS-GO-AHEAD; the offers are
+ * left in session->reply for the transport to send.
+ *
+ * @param session Session state to initialize
+ */
+void rfc2217_session_init(rfc2217_session_t* session);
+
+/**
+ * @brief Decode bytes received from the network
+ *
+ * Strips telnet commands, unescapes IAC IAC and handles COM-PORT-OPTION
+ * requests. Line setting changes are only recorded; rfc2217_apply_pending()
+ * applies them and rfc2217_confirm_pending() replies to them. Other
+ * replies are appended to session->reply.
+ *
+ * @param session Session state
+ * @param in Bytes received from the client
+ * @param len Number of bytes received
+ * @param out Receives the UART payload (capacity of at least len bytes)
+ * @return Number of payload bytes written to out
+ */
+size_t rfc2217_decode(rfc2217_session_t* session, const uint8_t* in, size_t len, uint8_t* out);
+
+/**
+ * @brief Apply the line settings recorded by rfc2217_decode
+ *
+ * Cancels auto-baud and reconfigures the UART, which waits on the UART
+ * task, so the transport calls this without holding its own locks. Must
+ * be called from the task that runs rfc2217_decode for this session.
+ *
+ * @param session Session state
+ */
+void rfc2217_apply_pending(rfc2217_session_t* session);
+
+/**
+ * @brief Reply to the line settings handled by rfc2217_apply_pending
+ *
+ * Reports the values now active, so a client learns when a requested
+ * setting was not applied. Replies are appended to session->reply;
+ * call under the same lock as rfc2217_decode.
+ *
+ * @param session Session state
+ */
+void rfc2217_confirm_pending(rfc2217_session_t* session);
+
+/**
+ * @brief Queue a FLOWCONTROL-SUSPEND or -RESUME notification
+ *
+ * Tells the client to pause or resume sending because the bridge TX
+ * path is congested. Does nothing if the state is unchanged.
+ *
+ * @param session Session state
+ * @param suspend true to send SUSPEND, false to send RESUME
+ */
+void rfc2217_signal_flow(rfc2217_session_t* session, bool suspend);
+
+#ifdef __cplusplus
+}
+#endif
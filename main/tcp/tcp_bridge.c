@@ -0,0 +1,506 @@
+/*
+ * TCP Bridge - LucidConsole Raw Serial Socket Implementation
+ * Pipes UART RX/TX bytes directly over lwIP sockets
+ */
+
+#include "tcp_bridge.h"
+#include "rfc2217.h"
+#include "../uart/uart_bridge.h"
+#include "../uart/uart_latency.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "lwip/sockets.h"
+#include <string.h>
+#include <errno.h>
+
+static const char* TAG = "TCP_BRIDGE";
+
+#define TCP_SLOT_COUNT (LUCIDUART_TCP_MAX_CLIENTS + LUCIDUART_RFC2217_MAX_CLIENTS)
+
+// Stop reading client sockets above the high mark, resume below the low mark.
+// The backlog covers the bridge TX queue plus the driver buffer behind it.
+#define TCP_TX_HIGH_WATER   (LUCIDUART_TX_BUF_SIZE + LUCIDUART_TX_QUEUE_BYTES / 2)
+#define TCP_TX_LOW_WATER    (LUCIDUART_TX_BUF_SIZE / 4)
+
+// Client state - accept task adds/removes, RX task only writes
+typedef struct {
+    bool in_use;
+    int fd;
+    uart_bridge_consumer_t cursor;
+    rfc2217_session_t* session;     // NULL for raw clients
+    bool reconfiguring;             // Replies held until the UART settings are applied
+    uint8_t unsent[LUCIDUART_TCP_RECV_BUF]; // Payload the TX queue refused, retried first
+    size_t unsent_len;              // Socket is not read while this is nonzero
+} tcp_client_t;
+
+// Raw slots first, RFC 2217 slots after
+static tcp_client_t tcp_clients[TCP_SLOT_COUNT];
+static rfc2217_session_t rfc2217_sessions[LUCIDUART_RFC2217_MAX_CLIENTS];
+static SemaphoreHandle_t tcp_mutex = NULL;
+static TaskHandle_t tcp_accept_task_handle = NULL;
+static TaskHandle_t tcp_rx_task_handle = NULL;
+static int listen_fd = -1;
+static int rfc2217_listen_fd = -1;
+
+/**
+ * @brief Register an accepted socket as a bridge consumer
+ */
+static void tcp_client_add(int fd, bool rfc2217) {
+    int nodelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+    
+    int first = rfc2217 ? LUCIDUART_TCP_MAX_CLIENTS : 0;
+    int last = rfc2217 ? TCP_SLOT_COUNT : LUCIDUART_TCP_MAX_CLIENTS;
+    
+    xSemaphoreTake(tcp_mutex, portMAX_DELAY);
+    tcp_client_t* client = NULL;
+    for (int i = first; i < last; i++) {
+        if (!tcp_clients[i].in_use) {
+            client = &tcp_clients[i];
+            break;
+        }
+    }
+    
+    uart_bridge_consumer_t cursor;
+    if (!client || uart_bridge_consumer_open(rfc2217 ? "rfc2217" : "tcp", &cursor) != ESP_OK) {
+        xSemaphoreGive(tcp_mutex);
+        ESP_LOGW(TAG, "TCP connection rejected - max clients reached");
+        close(fd);
+        return;
+    }
+    
+    uart_bridge_consumer_set_coalesce(cursor, LUCIDUART_TCP_COALESCE_BYTES, LUCIDUART_TCP_COALESCE_US);
+    *client = (tcp_client_t){
+        .in_use = true,
+        .fd = fd,
+        .cursor = cursor,
+    };
+    if (rfc2217) {
+        client->session = &rfc2217_sessions[client - tcp_clients - LUCIDUART_TCP_MAX_CLIENTS];
+        rfc2217_session_init(client->session);
+    }
+    xSemaphoreGive(tcp_mutex);
+    
+    ESP_LOGI(TAG, "%s client connected (slot %d)", rfc2217 ? "RFC 2217" : "TCP",
+             (int)(client - tcp_clients));
+    xTaskNotifyGive(tcp_rx_task_handle);
+}
+
+/**
+ * @brief Close a client socket and release its cursor
+ */
+static void tcp_client_remove(tcp_client_t* client) {
+    xSemaphoreTake(tcp_mutex, portMAX_DELAY);
+    uart_bridge_consumer_close(client->cursor);
+    close(client->fd);
+    client->in_use = false;
+    xSemaphoreGive(tcp_mutex);
+    
+    ESP_LOGI(TAG, "TCP client disconnected (slot %d)", (int)(client - tcp_clients));
+}
+
+/**
+ * @brief Send queued telnet replies ahead of any ring data
+ * 
+ * @return true if reply bytes are still waiting because the socket is full
+ */
+static bool tcp_client_flush_reply(tcp_client_t* client) {
+    rfc2217_session_t* session = client->session;
+    
+    while (session->reply_len > 0) {
+        int sent = send(client->fd, session->reply, session->reply_len, MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            shutdown(client->fd, SHUT_RDWR);
+            session->reply_len = 0;
+            return false;
+        }
+        
+        session->reply_len -= sent;
+        memmove(session->reply, session->reply + sent, session->reply_len);
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Send pending ring data to one client straight from ring slices
+ * 
+ * RFC 2217 clients get data up to each IAC byte zero-copy; the IAC
+ * itself is queued doubled behind any pending replies.
+ *
+ * @return true if data is still waiting because the socket is full
+ */
+static bool tcp_client_drain(tcp_client_t* client) {
+    rfc2217_session_t* session = client->session;
+    const uint8_t* data;
+    size_t len;
+    
+    if (session) {
+        if (client->reconfiguring || tcp_client_flush_reply(client)) {
+            return true;
+        }
+        if (session->purge_rx) {
+            uart_bridge_consumer_seek(client->cursor, uart_bridge_get_rx_offset());
+            session->purge_rx = false;
+        }
+        if (session->suspended) {
+            return false;
+        }
+    }
+    
+    if (!uart_bridge_consumer_ready(client->cursor)) {
+        return false;
+    }
+    
+    while ((len = uart_bridge_consumer_peek(client->cursor, &data)) > 0) {
+        if (session) {
+            const uint8_t* iac = memchr(data, TELNET_IAC, len);
+            if (iac == data) {
+                const uint8_t escaped[] = { TELNET_IAC, TELNET_IAC };
+                if (session->reply_len + sizeof(escaped) > sizeof(session->reply)) {
+                    return true;
+                }
+                memcpy(session->reply + session->reply_len, escaped, sizeof(escaped));
+                session->reply_len += sizeof(escaped);
+                uart_bridge_consumer_advance(client->cursor, 1);
+                if (tcp_client_flush_reply(client)) {
+                    return true;
+                }
+                continue;
+            }
+            if (iac) {
+                len = iac - data;
+            }
+        }
+        
+        // Offset after peek's resync, for the latency sample
+        uart_bridge_consumer_stats_t cstats;
+        uart_bridge_consumer_get_stats(client->cursor, &cstats);
+        
+        int sent = send(client->fd, data, len, MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            // Let the accept task see EOF and clean up
+            shutdown(client->fd, SHUT_RDWR);
+            return false;
+        }
+        
+        uart_bridge_consumer_advance(client->cursor, sent);
+        uart_latency_record(session ? UART_LATENCY_RFC2217 : UART_LATENCY_TCP, cstats.read_offset);
+        if ((size_t)sent < len) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief UART -> network task
+ *
+ * Waits on all client cursors and pushes new bytes without blocking.
+ * A client that cannot keep up loses its oldest data via ring overrun.
+ */
+static void tcp_rx_task(void* pvParameters) {
+    while (1) {
+        uart_bridge_consumer_t cursors[TCP_SLOT_COUNT];
+        size_t cursor_count = 0;
+        bool backlog = false;
+        
+        xSemaphoreTake(tcp_mutex, portMAX_DELAY);
+        for (int i = 0; i < TCP_SLOT_COUNT; i++) {
+            tcp_client_t* client = &tcp_clients[i];
+            if (!client->in_use) {
+                continue;
+            }
+            backlog |= tcp_client_drain(client);
+            // Suspended clients let their cursor age out instead of waking us
+            if (!client->session || !client->session->suspended) {
+                cursors[cursor_count++] = client->cursor;
+            }
+        }
+        xSemaphoreGive(tcp_mutex);
+        
+        if (backlog) {
+            vTaskDelay(1);
+        } else if (cursor_count == 0) {
+            // Woken by the accept task on connect and FLOWCONTROL-RESUME
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        } else {
+            // Timeout picks up clients added while waiting
+            uart_bridge_consumer_wait_any(cursors, cursor_count, pdMS_TO_TICKS(100));
+        }
+    }
+}
+
+/**
+ * @brief Queue client bytes for the UART TX task
+ * 
+ * Each socket read becomes one TX message, so concurrent clients never
+ * interleave inside a read. The high-water mark normally keeps the queue
+ * from filling; when a burst from several clients fills it anyway, the
+ * bytes are kept and the socket is left unread until they are queued, so
+ * TCP flow control pushes back on the sender instead of bytes being lost.
+ */
+static void tcp_client_submit(tcp_client_t* client, const uint8_t* buf, size_t len) {
+    esp_err_t err = uart_bridge_tx_submit(buf, len, 0, NULL, NULL);
+    if (err == ESP_ERR_NO_MEM) {
+        if (buf != client->unsent) {
+            memcpy(client->unsent, buf, len);
+        }
+        client->unsent_len = len;
+        return;
+    }
+    
+    client->unsent_len = 0;
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Dropped %u client bytes: %s", (unsigned)len, esp_err_to_name(err));
+    }
+}
+
+/**
+ * @brief Feed bytes received from a client to the UART
+ */
+static void tcp_client_receive(tcp_client_t* client, uint8_t* buf, int len) {
+    if (!client->session) {
+        tcp_client_submit(client, buf, len);
+        return;
+    }
+    
+    // Decoding in place is safe: output never outgrows input
+    xSemaphoreTake(tcp_mutex, portMAX_DELAY);
+    bool was_suspended = client->session->suspended;
+    size_t payload = rfc2217_decode(client->session, buf, len, buf);
+    client->reconfiguring = client->session->pending_mask != 0;
+    if (!client->reconfiguring) {
+        tcp_client_flush_reply(client);
+    }
+    bool resumed = was_suspended && !client->session->suspended;
+    xSemaphoreGive(tcp_mutex);
+    
+    // Reconfiguring waits on the UART task, so it runs unlocked; the
+    // replies confirming it go out once the new settings are active
+    if (client->reconfiguring) {
+        rfc2217_apply_pending(client->session);
+        xSemaphoreTake(tcp_mutex, portMAX_DELAY);
+        rfc2217_confirm_pending(client->session);
+        client->reconfiguring = false;
+        tcp_client_flush_reply(client);
+        xSemaphoreGive(tcp_mutex);
+    }
+    
+    if (payload > 0) {
+        tcp_client_submit(client, buf, payload);
+    }
+    if (resumed) {
+        xTaskNotifyGive(tcp_rx_task_handle);
+    }
+}
+
+/**
+ * @brief Tell RFC 2217 clients to pause or resume sending
+ */
+static void tcp_signal_flow(bool suspend) {
+    xSemaphoreTake(tcp_mutex, portMAX_DELAY);
+    for (int i = LUCIDUART_TCP_MAX_CLIENTS; i < TCP_SLOT_COUNT; i++) {
+        if (tcp_clients[i].in_use) {
+            rfc2217_signal_flow(tcp_clients[i].session, suspend);
+            tcp_client_flush_reply(&tcp_clients[i]);
+        }
+    }
+    xSemaphoreGive(tcp_mutex);
+}
+
+/**
+ * @brief Accept + network -> UART task
+ * 
+ * While the UART TX backlog is above the high-water mark client sockets
+ * are left unread, so TCP flow control pushes back on the sender and
+ * RFC 2217 clients are told FLOWCONTROL-SUSPEND. A client whose last read
+ * did not fit in the TX queue stays unread until it does.
+ */
+static void tcp_accept_task(void* pvParameters) {
+    uint8_t recv_buf[LUCIDUART_TCP_RECV_BUF];
+    bool tx_busy = false;
+    
+    ESP_LOGI(TAG, "Raw TCP bridge listening on port %d, RFC 2217 on port %d",
+             LUCIDUART_TCP_PORT, LUCIDUART_RFC2217_PORT);
+    
+    while (1) {
+        bool retrying = false;
+        for (int i = 0; i < TCP_SLOT_COUNT; i++) {
+            tcp_client_t* client = &tcp_clients[i];
+            if (client->in_use && client->unsent_len > 0) {
+                tcp_client_submit(client, client->unsent, client->unsent_len);
+                retrying |= client->unsent_len > 0;
+            }
+        }
+        
+        uint32_t backlog = uart_bridge_get_tx_backlog();
+        if (!tx_busy && backlog > TCP_TX_HIGH_WATER) {
+            tx_busy = true;
+            tcp_signal_flow(true);
+        } else if (tx_busy && backlog < TCP_TX_LOW_WATER) {
+            tx_busy = false;
+            tcp_signal_flow(false);
+        }
+        
+        fd_set rfds;
+        FD_ZERO(&rfds);
+        FD_SET(listen_fd, &rfds);
+        FD_SET(rfc2217_listen_fd, &rfds);
+        int max_fd = (listen_fd > rfc2217_listen_fd) ? listen_fd : rfc2217_listen_fd;
+        
+        for (int i = 0; i < TCP_SLOT_COUNT && !tx_busy; i++) {
+            if (tcp_clients[i].in_use && tcp_clients[i].unsent_len == 0) {
+                FD_SET(tcp_clients[i].fd, &rfds);
+                if (tcp_clients[i].fd > max_fd) {
+                    max_fd = tcp_clients[i].fd;
+                }
+            }
+        }
+        
+        // Poll the backlog estimate and the TX queue while reads are paused
+        struct timeval busy_timeout = { .tv_sec = 0, .tv_usec = LUCIDUART_TCP_TX_POLL_MS * 1000 };
+        if (select(max_fd + 1, &rfds, NULL, NULL, (tx_busy || retrying) ? &busy_timeout : NULL) <= 0) {
+            continue;
+        }
+        
+        if (FD_ISSET(listen_fd, &rfds)) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                tcp_client_add(fd, false);
+            }
+        }
+        
+        if (FD_ISSET(rfc2217_listen_fd, &rfds)) {
+            int fd = accept(rfc2217_listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                tcp_client_add(fd, true);
+            }
+        }
+        
+        for (int i = 0; i < TCP_SLOT_COUNT; i++) {
+            tcp_client_t* client = &tcp_clients[i];
+            if (!client->in_use || !FD_ISSET(client->fd, &rfds)) {
+                continue;
+            }
+            
+            int len = recv(client->fd, recv_buf, sizeof(recv_buf), 0);
+            if (len <= 0) {
+                tcp_client_remove(client);
+                continue;
+            }
+            
+            tcp_client_receive(client, recv_buf, len);
+        }
+    }
+}
+
+/**
+ * @brief Create a listening socket on the given port
+ * 
+ * @return Socket descriptor, or -1 on failure
+ */
+static int tcp_listen(uint16_t port, int backlog) {
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "Failed to create socket: errno %d", errno);
+        return -1;
+    }
+    
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(fd, backlog) != 0) {
+        ESP_LOGE(TAG, "Failed to listen on port %d: errno %d", port, errno);
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+/**
+ * @brief Close both listening sockets
+ */
+static void tcp_close_listeners(void) {
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        listen_fd = -1;
+    }
+    if (rfc2217_listen_fd >= 0) {
+        close(rfc2217_listen_fd);
+        rfc2217_listen_fd = -1;
+    }
+}
+
+esp_err_t tcp_bridge_init(void) {
+    if (tcp_accept_task_handle) {
+        ESP_LOGW(TAG, "TCP bridge already running");
+        return ESP_OK;
+    }
+    
+    tcp_mutex = xSemaphoreCreateMutex();
+    if (!tcp_mutex) {
+        ESP_LOGE(TAG, "Failed to create TCP mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    listen_fd = tcp_listen(LUCIDUART_TCP_PORT, LUCIDUART_TCP_MAX_CLIENTS);
+    rfc2217_listen_fd = tcp_listen(LUCIDUART_RFC2217_PORT, LUCIDUART_RFC2217_MAX_CLIENTS);
+    if (listen_fd < 0 || rfc2217_listen_fd < 0) {
+        tcp_close_listeners();
+        return ESP_FAIL;
+    }
+    
+    BaseType_t task_created = xTaskCreate(tcp_rx_task, "tcp_rx",
+                                          LUCIDUART_TCP_TASK_STACK, NULL,
+                                          LUCIDUART_TCP_TASK_PRIORITY, &tcp_rx_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create TCP RX task");
+        tcp_close_listeners();
+        return ESP_FAIL;
+    }
+    
+    task_created = xTaskCreate(tcp_accept_task, "tcp_accept",
+                               LUCIDUART_TCP_TASK_STACK, NULL,
+                               LUCIDUART_TCP_TASK_PRIORITY, &tcp_accept_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create TCP accept task");
+        vTaskDelete(tcp_rx_task_handle);
+        tcp_rx_task_handle = NULL;
+        tcp_close_listeners();
+        return ESP_FAIL;
+    }
+    
+    return ESP_OK;
+}
+
+bool tcp_bridge_is_running(void) {
+    return tcp_accept_task_handle != NULL;
+}
+
+uint32_t tcp_bridge_get_client_count(void) {
+    uint32_t count = 0;
+    for (int i = 0; i < TCP_SLOT_COUNT; i++) {
+        if (tcp_clients[i].in_use) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,58 @@
+/*
+ * TCP Bridge - LucidConsole Raw Serial Socket
+ * Telnet-style TCP port that pipes UART bytes without HTTP/JSON/Base64
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// TCP server configuration
+#define LUCIDUART_TCP_PORT          2323    // Raw serial port (nc/socat/screen)
+#define LUCIDUART_TCP_MAX_CLIENTS   2       // Concurrent raw clients
+#define LUCIDUART_TCP_RECV_BUF      256     // Socket -> UART copy buffer
+#define LUCIDUART_TCP_TX_POLL_MS    10      // Retry interval while UART TX is backed up
+#define LUCIDUART_TCP_COALESCE_BYTES 128    // Flush once this much is pending...
+#define LUCIDUART_TCP_COALESCE_US   5000    // ...or this long after the first byte
+#define LUCIDUART_TCP_TASK_PRIORITY 4       // Below the UART task (5)
+#define LUCIDUART_TCP_TASK_STACK    3072
+
+/**
+ * @brief Initialize raw TCP serial server
+ * 
+ * Listens on LUCIDUART_TCP_PORT. Every client gets its own RX ring cursor
+ * and receives UART bytes unmodified with TCP_NODELAY set; bytes sent by
+ * the client are queued with uart_bridge_tx_submit(), one message per
+ * socket read.
+ * 
+ * Also listens on LUCIDUART_RFC2217_PORT for telnet COM-PORT-OPTION
+ * clients (pySerial rfc2217://, ser2net) that set baud rate, framing and
+ * purge in-band.
+ * 
+ * @return ESP_OK on success, error code on failure
+ */
+esp_err_t tcp_bridge_init(void);
+
+/**
+ * @brief Check if TCP server is running
+ * 
+ * @return true if the listener task is active, false otherwise
+ */
+bool tcp_bridge_is_running(void);
+
+/**
+ * @brief Get number of connected raw TCP and RFC 2217 clients
+ * 
+ * @return Connected client count
+ */
+uint32_t tcp_bridge_get_client_count(void);
+
+#ifdef __cplusplus
+}
+#endif
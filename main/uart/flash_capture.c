@@ -0,0 +1,443 @@
+/*
+ * Flash Capture - LucidConsole Persistent RX Capture Implementation
+ * Segment ring with a ping-pong index in the partition header
+ */
+
+#include "flash_capture.h"
+#include "uart_bridge.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_partition.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char* TAG = "FLASH_CAPTURE";
+
+#define CAP_INDEX_MAGIC     0x5041434C      // "LCAP"
+#define CAP_DATA_START      (LUCIDUART_CAPTURE_INDEX_SECTORS * SPI_FLASH_SEC_SIZE)
+#define CAP_ALIGN4(n)       (((n) + 3) & ~3u)
+
+// Index entry, appended when a segment is opened. Entries are written
+// once into erased slots, so the index sector is only erased after
+// CAP_INDEX_SLOTS segment opens.
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;
+    uint16_t boot;
+    uint16_t segments;          // Layout the entry was written for
+    uint32_t check;             // ~seq
+} cap_index_t;
+
+#define CAP_INDEX_SLOTS     (SPI_FLASH_SEC_SIZE / sizeof(cap_index_t))
+
+// Record header in a segment. Written after the payload, so a valid
+// header means the payload is complete; seq tells records from stale
+// data of the segment's previous rotation.
+typedef struct {
+    uint16_t len;
+    uint16_t len_check;         // ~len
+    uint32_t seq;
+} cap_record_t;
+
+_Static_assert(LUCIDUART_CAPTURE_SEGMENT_SIZE % SPI_FLASH_SEC_SIZE == 0,
+               "Segments must be erase-aligned");
+_Static_assert(LUCIDUART_CAPTURE_RECORD_MAX % 4 == 0 && LUCIDUART_CAPTURE_RECORD_MAX < 0xFFFF,
+               "Records are written in 4-byte units with a 16-bit length");
+
+static const esp_partition_t* cap_part = NULL;
+static SemaphoreHandle_t cap_mutex = NULL;     // Head segment and stats
+static TaskHandle_t cap_task_handle = NULL;
+static uint32_t cap_segments = 0;
+
+static uint32_t cap_head_seq = 0;      // Newest segment, 0 if none yet
+static bool cap_head_open = false;     // Head belongs to this boot and takes writes
+static uint32_t cap_head_pos = 0;      // Write offset in the head segment
+static uint32_t cap_head_erased = 0;   // Head segment bytes erased so far
+static uint32_t cap_index_sector = 0;
+static uint32_t cap_index_slot = 0;    // Next free entry in the active index sector
+static uint16_t cap_boot = 0;
+
+static uint32_t cap_bytes_written = 0;
+static uint32_t cap_records = 0;
+static uint32_t cap_sector_erases = 0;
+static uint32_t cap_write_errors = 0;
+static volatile bool cap_paused = false;
+
+// Writer page: record header followed by up to RECORD_MAX payload bytes
+static uint32_t cap_page[(sizeof(cap_record_t) + LUCIDUART_CAPTURE_RECORD_MAX) / 4];
+static size_t cap_fill = 0;
+
+static inline uint32_t cap_segment_addr(uint32_t seq) {
+    return CAP_DATA_START + (seq % cap_segments) * LUCIDUART_CAPTURE_SEGMENT_SIZE;
+}
+
+static inline uint32_t cap_oldest_seq(void) {
+    if (cap_head_seq == 0) {
+        return 0;
+    }
+    return (cap_head_seq >= cap_segments) ? cap_head_seq - cap_segments + 1 : 1;
+}
+
+/**
+ * @brief Recover the newest index entry from both index sectors
+ *
+ * Formats the index if neither holds a valid entry for this layout.
+ */
+static esp_err_t cap_index_load(void) {
+    uint32_t best_seq = 0;
+    uint16_t best_boot = 0;
+    uint32_t used[LUCIDUART_CAPTURE_INDEX_SECTORS] = {0};
+    
+    for (uint32_t s = 0; s < LUCIDUART_CAPTURE_INDEX_SECTORS; s++) {
+        cap_index_t entries[16];
+        for (uint32_t slot = 0; slot < CAP_INDEX_SLOTS; slot += 16) {
+            esp_err_t err = esp_partition_read(cap_part, s * SPI_FLASH_SEC_SIZE + slot * sizeof(cap_index_t),
+                                               entries, sizeof(entries));
+            if (err != ESP_OK) {
+                return err;
+            }
+            for (int i = 0; i < 16; i++) {
+                const cap_index_t* e = &entries[i];
+                if (e->magic != 0xFFFFFFFF || e->seq != 0xFFFFFFFF) {
+                    used[s] = slot + i + 1;
+                }
+                if (e->magic == CAP_INDEX_MAGIC && e->check == ~e->seq &&
+                    e->segments == cap_segments && e->seq > best_seq) {
+                    best_seq = e->seq;
+                    best_boot = e->boot;
+                    cap_index_sector = s;
+                }
+            }
+        }
+    }
+    
+    if (best_seq == 0) {
+        ESP_LOGI(TAG, "No capture index found, formatting");
+        esp_err_t err = esp_partition_erase_range(cap_part, 0, CAP_DATA_START);
+        if (err != ESP_OK) {
+            return err;
+        }
+        cap_index_sector = 0;
+        cap_index_slot = 0;
+        cap_head_seq = 0;
+        cap_boot = 0;
+        return ESP_OK;
+    }
+    
+    cap_index_slot = used[cap_index_sector];
+    cap_head_seq = best_seq;
+    cap_boot = best_boot;
+    return ESP_OK;
+}
+
+/**
+ * @brief Append an index entry, rotating to the other index sector when full
+ */
+static esp_err_t cap_index_append(uint32_t seq) {
+    if (cap_index_slot >= CAP_INDEX_SLOTS) {
+        // The full sector keeps the newest entries until the next rotation
+        uint32_t next = (cap_index_sector + 1) % LUCIDUART_CAPTURE_INDEX_SECTORS;
+        esp_err_t err = esp_partition_erase_range(cap_part, next * SPI_FLASH_SEC_SIZE, SPI_FLASH_SEC_SIZE);
+        if (err != ESP_OK) {
+            return err;
+        }
+        cap_index_sector = next;
+        cap_index_slot = 0;
+    }
+    
+    cap_index_t entry = {
+        .magic = CAP_INDEX_MAGIC,
+        .seq = seq,
+        .boot = cap_boot,
+        .segments = cap_segments,
+        .check = ~seq,
+    };
+    esp_err_t err = esp_partition_write(cap_part,
+                                        cap_index_sector * SPI_FLASH_SEC_SIZE + cap_index_slot * sizeof(entry),
+                                        &entry, sizeof(entry));
+    cap_index_slot++;
+    return err;
+}
+
+/**
+ * @brief Start the next segment, retiring the oldest one if the ring is full
+ *
+ * Only the first sector is erased here; the rest are erased as writes
+ * reach them, so no single flush stalls on a whole segment erase.
+ */
+static esp_err_t cap_segment_open(void) {
+    // Move the head first so readers stop trusting the segment being reused
+    xSemaphoreTake(cap_mutex, portMAX_DELAY);
+    uint32_t seq = ++cap_head_seq;
+    cap_head_open = true;
+    cap_head_pos = 0;
+    cap_head_erased = 0;
+    xSemaphoreGive(cap_mutex);
+    
+    esp_err_t err = esp_partition_erase_range(cap_part, cap_segment_addr(seq), SPI_FLASH_SEC_SIZE);
+    if (err == ESP_OK) {
+        cap_head_erased = SPI_FLASH_SEC_SIZE;
+        cap_sector_erases++;
+        err = cap_index_append(seq);
+    }
+    return err;
+}
+
+/**
+ * @brief Write the page buffer as one record
+ */
+static void cap_flush(void) {
+    if (cap_fill == 0) {
+        return;
+    }
+    
+    size_t payload = CAP_ALIGN4(cap_fill);
+    size_t total = sizeof(cap_record_t) + payload;
+    esp_err_t err = ESP_OK;
+    if (!cap_head_open || cap_head_pos + total > LUCIDUART_CAPTURE_SEGMENT_SIZE) {
+        err = cap_segment_open();
+    }
+    
+    uint32_t addr = cap_segment_addr(cap_head_seq);
+    while (err == ESP_OK && cap_head_erased < cap_head_pos + total) {
+        err = esp_partition_erase_range(cap_part, addr + cap_head_erased, SPI_FLASH_SEC_SIZE);
+        cap_head_erased += SPI_FLASH_SEC_SIZE;
+        cap_sector_erases++;
+    }
+    
+    cap_record_t* header = (cap_record_t*)cap_page;
+    *header = (cap_record_t){
+        .len = cap_fill,
+        .len_check = (uint16_t)~cap_fill,
+        .seq = cap_head_seq,
+    };
+    if (err == ESP_OK) {
+        err = esp_partition_write(cap_part, addr + cap_head_pos + sizeof(cap_record_t),
+                                  header + 1, payload);
+    }
+    if (err == ESP_OK) {
+        err = esp_partition_write(cap_part, addr + cap_head_pos, header, sizeof(cap_record_t));
+    }
+    
+    xSemaphoreTake(cap_mutex, portMAX_DELAY);
+    if (err == ESP_OK) {
+        cap_bytes_written += cap_fill;
+        cap_records++;
+    } else {
+        cap_write_errors++;
+    }
+    // Skip the space even on failure; a half-written record reads as the segment end
+    cap_head_pos += total;
+    xSemaphoreGive(cap_mutex);
+    
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Capture write failed: %s", esp_err_to_name(err));
+    }
+    cap_fill = 0;
+}
+
+/**
+ * @brief Capture task - batches the RX stream into flash records
+ */
+static void cap_task(void* pvParameters) {
+    uart_bridge_consumer_t cursor;
+    while (uart_bridge_consumer_open("capture", &cursor) != ESP_OK) {
+        ESP_LOGW(TAG, "No RX cursor free for capture, retrying");
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+    uart_bridge_consumer_set_coalesce(cursor, LUCIDUART_CAPTURE_RECORD_MAX,
+                                      LUCIDUART_CAPTURE_FLUSH_MS * 1000);
+    
+    uint8_t* page = (uint8_t*)cap_page + sizeof(cap_record_t);
+    TickType_t first_byte = 0;
+    
+    while (1) {
+        uart_bridge_consumer_wait(cursor, pdMS_TO_TICKS(LUCIDUART_CAPTURE_FLUSH_MS));
+        
+        const uint8_t* data;
+        size_t len = uart_bridge_consumer_peek(cursor, &data);
+        if (cap_paused) {
+            // Keep what came before the pause, skip the rest
+            cap_flush();
+            uart_bridge_consumer_advance(cursor, len);
+            continue;
+        }
+        if (len > LUCIDUART_CAPTURE_RECORD_MAX - cap_fill) {
+            len = LUCIDUART_CAPTURE_RECORD_MAX - cap_fill;
+        }
+        if (len) {
+            memcpy(page + cap_fill, data, len);
+            // Lapped while copying: drop the torn copy, peek resyncs
+            if (uart_bridge_consumer_advance(cursor, len) == ESP_OK) {
+                if (cap_fill == 0) {
+                    first_byte = xTaskGetTickCount();
+                }
+                cap_fill += len;
+            }
+        }
+        
+        if (cap_fill == LUCIDUART_CAPTURE_RECORD_MAX ||
+            (cap_fill && xTaskGetTickCount() - first_byte >= pdMS_TO_TICKS(LUCIDUART_CAPTURE_FLUSH_MS))) {
+            cap_flush();
+        }
+    }
+}
+
+esp_err_t flash_capture_init(void) {
+    if (cap_task_handle) {
+        return ESP_OK;
+    }
+    
+    cap_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, LUCIDUART_CAPTURE_SUBTYPE,
+                                        LUCIDUART_CAPTURE_PARTITION);
+    if (!cap_part) {
+        ESP_LOGW(TAG, "No '%s' partition in the partition table", LUCIDUART_CAPTURE_PARTITION);
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    cap_segments = 0;
+    if (cap_part->size > CAP_DATA_START) {
+        cap_segments = (cap_part->size - CAP_DATA_START) / LUCIDUART_CAPTURE_SEGMENT_SIZE;
+    }
+    // The full index sector must still name every live segment after a rotation
+    if (cap_segments > CAP_INDEX_SLOTS) {
+        cap_segments = CAP_INDEX_SLOTS;
+    }
+    if (cap_segments < 2) {
+        ESP_LOGE(TAG, "Capture partition too small (%u bytes)", cap_part->size);
+        cap_part = NULL;
+        return ESP_ERR_INVALID_SIZE;
+    }
+    
+    cap_mutex = xSemaphoreCreateMutex();
+    if (!cap_mutex) {
+        cap_part = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Earlier boots' segments stay readable; this boot opens its own
+    // segment on the first flush, so idle reboots cost no flash
+    esp_err_t err = cap_index_load();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read capture index: %s", esp_err_to_name(err));
+        cap_part = NULL;
+        return err;
+    }
+    cap_boot++;
+    
+    BaseType_t task_created = xTaskCreate(cap_task,
+                                          "capture_task",
+                                          LUCIDUART_CAPTURE_TASK_STACK,
+                                          NULL,
+                                          LUCIDUART_CAPTURE_TASK_PRIORITY,
+                                          &cap_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create capture task");
+        cap_part = NULL;
+        return ESP_FAIL;
+    }
+    
+    ESP_LOGI(TAG, "Capture ready: %u x %d KB segments, boot %u, %u segments held",
+             cap_segments, LUCIDUART_CAPTURE_SEGMENT_SIZE / 1024, cap_boot,
+             cap_head_seq ? cap_head_seq - cap_oldest_seq() + 1 : 0);
+    return ESP_OK;
+}
+
+esp_err_t flash_capture_first(flash_capture_pos_t* pos) {
+    if (!pos) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!cap_part) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    xSemaphoreTake(cap_mutex, portMAX_DELAY);
+    pos->seq = cap_oldest_seq();
+    pos->offset = 0;
+    xSemaphoreGive(cap_mutex);
+    return pos->seq ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+size_t flash_capture_read(flash_capture_pos_t* pos, uint8_t* buf, size_t max) {
+    if (!pos || !buf || max < LUCIDUART_CAPTURE_RECORD_MAX || !cap_part) {
+        return 0;
+    }
+    
+    while (1) {
+        xSemaphoreTake(cap_mutex, portMAX_DELAY);
+        uint32_t head = cap_head_seq;
+        uint32_t oldest = cap_oldest_seq();
+        xSemaphoreGive(cap_mutex);
+        
+        if (head == 0 || (int32_t)(pos->seq - head) > 0) {
+            return 0;
+        }
+        if ((int32_t)(pos->seq - oldest) < 0) {
+            // Reused under us; carry on from what is left
+            pos->seq = oldest;
+            pos->offset = 0;
+        }
+        
+        cap_record_t header;
+        uint32_t addr = cap_segment_addr(pos->seq) + pos->offset;
+        bool valid = pos->offset + sizeof(header) <= LUCIDUART_CAPTURE_SEGMENT_SIZE &&
+                     esp_partition_read(cap_part, addr, &header, sizeof(header)) == ESP_OK &&
+                     (header.len ^ header.len_check) == 0xFFFF &&
+                     header.len > 0 && header.len <= LUCIDUART_CAPTURE_RECORD_MAX &&
+                     header.seq == pos->seq;
+        if (!valid) {
+            // End of this segment; the head segment may still grow
+            if (pos->seq == head) {
+                return 0;
+            }
+            pos->seq++;
+            pos->offset = 0;
+            continue;
+        }
+        
+        if (esp_partition_read(cap_part, addr + sizeof(header), buf, header.len) != ESP_OK) {
+            return 0;
+        }
+        
+        // The writer may have started erasing this segment during the read
+        xSemaphoreTake(cap_mutex, portMAX_DELAY);
+        bool reused = (int32_t)(pos->seq - cap_oldest_seq()) < 0;
+        xSemaphoreGive(cap_mutex);
+        if (reused) {
+            continue;
+        }
+        
+        pos->offset += sizeof(header) + CAP_ALIGN4(header.len);
+        return header.len;
+    }
+}
+
+void flash_capture_set_paused(bool paused) {
+    cap_paused = paused;
+}
+
+esp_err_t flash_capture_get_stats(flash_capture_stats_t* stats) {
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!cap_part) {
+        return ESP_OK;
+    }
+    
+    xSemaphoreTake(cap_mutex, portMAX_DELAY);
+    stats->partition_size = cap_part->size;
+    stats->segment_size = LUCIDUART_CAPTURE_SEGMENT_SIZE;
+    stats->segments = cap_segments;
+    stats->oldest_seq = cap_oldest_seq();
+    stats->head_seq = cap_head_seq;
+    stats->boot = cap_boot;
+    stats->head_bytes = cap_head_open ? cap_head_pos : 0;
+    stats->bytes_written = cap_bytes_written;
+    stats->records = cap_records;
+    stats->sector_erases = cap_sector_erases;
+    stats->write_errors = cap_write_errors;
+    xSemaphoreGive(cap_mutex);
+    return ESP_OK;
+}
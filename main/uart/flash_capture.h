@@ -0,0 +1,108 @@
+/*
+ * Flash Capture - LucidConsole Persistent RX Capture
+ * Appends the RX stream to a dedicated flash partition in rotating segments
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Partition (see boards/<board>/partitions_ota.csv)
+#define LUCIDUART_CAPTURE_PARTITION         "capture"
+#define LUCIDUART_CAPTURE_SUBTYPE           0x40    // Custom data subtype
+
+// Layout: two ping-pong index sectors, then equal segments
+#define LUCIDUART_CAPTURE_INDEX_SECTORS     2
+#define LUCIDUART_CAPTURE_SEGMENT_SIZE      (32 * 1024)     // Erase-aligned
+#define LUCIDUART_CAPTURE_RECORD_MAX        1024    // Payload bytes per flash write
+
+#define LUCIDUART_CAPTURE_FLUSH_MS          2000    // Max time RX bytes wait in RAM
+#define LUCIDUART_CAPTURE_TASK_PRIORITY     3       // Below the transports (4)
+#define LUCIDUART_CAPTURE_TASK_STACK        2048
+
+// Position in the capture, for streaming reads
+typedef struct {
+    uint32_t seq;               // Segment sequence number
+    uint32_t offset;            // Byte offset of the next record in the segment
+} flash_capture_pos_t;
+
+// Capture statistics
+typedef struct {
+    uint32_t partition_size;
+    uint32_t segment_size;
+    uint32_t segments;          // Segments in the partition
+    uint32_t oldest_seq;        // Oldest segment still held (0 if none)
+    uint32_t head_seq;          // Segment being written
+    uint32_t boot;              // Boot number stamped on this boot's segments
+    uint32_t head_bytes;        // Bytes used in the head segment
+    uint32_t bytes_written;     // Payload bytes written this boot
+    uint32_t records;           // Flash writes this boot
+    uint32_t sector_erases;     // Data sector erases this boot
+    uint32_t write_errors;
+} flash_capture_stats_t;
+
+/**
+ * @brief Initialize the flash capture
+ *
+ * Recovers the segment index from the partition header (formatting the
+ * partition if it holds none), opens a fresh segment for this boot and
+ * starts the capture task. RX bytes are gathered in RAM and written as
+ * one record per LUCIDUART_CAPTURE_RECORD_MAX bytes or per
+ * LUCIDUART_CAPTURE_FLUSH_MS, so there are no per-byte flash operations.
+ * When the partition is full the oldest segment is erased and reused.
+ *
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the partition table
+ *         has no capture partition, or a flash error
+ */
+esp_err_t flash_capture_init(void);
+
+/**
+ * @brief Get the start of the oldest retained segment
+ *
+ * @param pos Receives the position
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if nothing is captured
+ */
+esp_err_t flash_capture_first(flash_capture_pos_t* pos);
+
+/**
+ * @brief Read the next record
+ *
+ * Walks records in write order across segments. If the writer has
+ * since reused the segment at pos, continues from the oldest one.
+ *
+ * @param pos Position to read from; advanced past the record
+ * @param buf Receives the payload
+ * @param max Capacity of buf, at least LUCIDUART_CAPTURE_RECORD_MAX
+ * @return Payload length, 0 once the reader has caught up with the writer
+ */
+size_t flash_capture_read(flash_capture_pos_t* pos, uint8_t* buf, size_t max);
+
+/**
+ * @brief Pause or resume capturing
+ *
+ * While paused the RX stream is skipped rather than stored, so bulk
+ * test traffic (see uart_selftest_start()) does not rotate real
+ * console history out of flash.
+ *
+ * @param paused true to pause, false to resume
+ */
+void flash_capture_set_paused(bool paused);
+
+/**
+ * @brief Get capture statistics
+ *
+ * @param stats Pointer to stats structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t flash_capture_get_stats(flash_capture_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,390 @@
+/*
+ * LZ History - LucidConsole Compressed Scrollback Implementation
+ * Per-block LZSS (flag byte + literals / 16-bit distance-length tokens)
+ */
+
+#include "lz_history.h"
+#include "uart_bridge.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include <string.h>
+#include <stdlib.h>
+
+static const char* TAG = "LZ_HISTORY";
+
+// Token: 10-bit distance - 1, 6-bit length - LZH_MIN_MATCH
+#define LZH_MIN_MATCH       3
+#define LZH_MAX_MATCH       (LZH_MIN_MATCH + 63)
+#define LZH_MAX_DIST        1024
+#define LZH_HASH_BITS       8
+#define LZH_CHAIN_MAX       16      // Candidates tried per position
+
+_Static_assert(LUCIDUART_HISTORY_BLOCK_SIZE <= LZH_MAX_DIST,
+               "Blocks must fit the 10-bit match distance");
+
+// Sealed block in the store
+typedef struct {
+    uint32_t offset;            // Stream offset of the first byte
+    uint32_t pos;               // Free-running store position
+    uint16_t raw_len;
+    uint16_t stored_len;
+    bool compressed;            // false: stored raw (did not shrink)
+} lzh_block_t;
+
+// Everything large lives in one allocation made at init
+typedef struct {
+    uint8_t store[LUCIDUART_HISTORY_STORE_SIZE];
+    uint8_t open_block[LUCIDUART_HISTORY_BLOCK_SIZE];  // Block being filled
+    uint8_t decoded[LUCIDUART_HISTORY_BLOCK_SIZE];     // Decoder output / compressor scratch, under mutex
+    uint16_t hash_head[1 << LZH_HASH_BITS];            // Last position + 1 per hash, 0 = none
+    uint16_t hash_prev[LUCIDUART_HISTORY_BLOCK_SIZE];
+} lzh_buffers_t;
+
+static lzh_buffers_t* lzh = NULL;
+static SemaphoreHandle_t lzh_mutex = NULL;     // Store, index, open block and decoded cache
+static TaskHandle_t lzh_task_handle = NULL;
+
+static lzh_block_t lzh_blocks[LUCIDUART_HISTORY_MAX_BLOCKS];
+static uint32_t lzh_block_head = 0;     // Blocks sealed (free-running)
+static uint32_t lzh_block_tail = 0;     // Oldest block still held
+static uint32_t lzh_store_head = 0;     // Free-running store write position
+static uint32_t lzh_open_offset = 0;    // Stream offset of open_block[0]
+static uint32_t lzh_open_len = 0;
+static uint32_t lzh_decoded_block = UINT32_MAX;    // Block held in decoded[]
+static uint32_t lzh_evicted = 0;
+
+static inline uint32_t lzh_hash(const uint8_t* p) {
+    return ((p[0] << 5) ^ (p[1] << 2) ^ p[2]) & ((1 << LZH_HASH_BITS) - 1);
+}
+
+/**
+ * @brief Compress one block
+ *
+ * Greedy LZSS with hash chains bounded to LZH_CHAIN_MAX candidates, so
+ * the cost per byte is bounded regardless of input.
+ *
+ * @return Compressed length, or 0 if it would not fit in out_max
+ */
+static size_t lzh_compress(const uint8_t* in, size_t len, uint8_t* out, size_t out_max) {
+    memset(lzh->hash_head, 0, sizeof(lzh->hash_head));
+    
+    size_t i = 0;
+    size_t o = 0;
+    size_t flag_pos = 0;
+    int flag_bit = 8;
+    
+    while (i < len) {
+        if (flag_bit == 8) {
+            if (o >= out_max) {
+                return 0;
+            }
+            flag_pos = o++;
+            out[flag_pos] = 0;
+            flag_bit = 0;
+        }
+        
+        size_t best_len = 0;
+        size_t best_dist = 0;
+        if (i + LZH_MIN_MATCH <= len) {
+            size_t max = (len - i < LZH_MAX_MATCH) ? len - i : LZH_MAX_MATCH;
+            uint16_t cand = lzh->hash_head[lzh_hash(&in[i])];
+            for (int chain = 0; cand && chain < LZH_CHAIN_MAX; chain++) {
+                size_t p = cand - 1;
+                size_t l = 0;
+                while (l < max && in[p + l] == in[i + l]) {
+                    l++;
+                }
+                if (l > best_len) {
+                    best_len = l;
+                    best_dist = i - p;
+                    if (l == max) {
+                        break;
+                    }
+                }
+                cand = lzh->hash_prev[p];
+            }
+        }
+        
+        if (best_len >= LZH_MIN_MATCH) {
+            if (o + 2 > out_max) {
+                return 0;
+            }
+            uint16_t token = ((best_dist - 1) << 6) | (best_len - LZH_MIN_MATCH);
+            out[o++] = token >> 8;
+            out[o++] = token & 0xff;
+            out[flag_pos] |= 1 << flag_bit;
+        } else {
+            if (o >= out_max) {
+                return 0;
+            }
+            out[o++] = in[i];
+            best_len = 1;
+        }
+        flag_bit++;
+        
+        // Index every position consumed so later matches can start inside this one
+        for (size_t end = i + best_len; i < end; i++) {
+            if (i + LZH_MIN_MATCH <= len) {
+                uint32_t h = lzh_hash(&in[i]);
+                lzh->hash_prev[i] = lzh->hash_head[h];
+                lzh->hash_head[h] = i + 1;
+            }
+        }
+    }
+    return o;
+}
+
+/**
+ * @brief Decompress one block
+ *
+ * @return Number of bytes produced (stops early on corrupt input)
+ */
+static size_t lzh_decompress(const uint8_t* in, size_t in_len, uint8_t* out, size_t out_len) {
+    size_t i = 0;
+    size_t o = 0;
+    uint8_t flags = 0;
+    int bit = 8;
+    
+    while (i < in_len && o < out_len) {
+        if (bit == 8) {
+            flags = in[i++];
+            bit = 0;
+            continue;
+        }
+        if (flags & (1 << bit)) {
+            if (i + 2 > in_len) {
+                break;
+            }
+            uint16_t token = (in[i] << 8) | in[i + 1];
+            i += 2;
+            size_t dist = (token >> 6) + 1;
+            size_t len = (token & 0x3f) + LZH_MIN_MATCH;
+            if (dist > o) {
+                break;
+            }
+            // Byte by byte: a match may overlap its own output
+            while (len-- && o < out_len) {
+                out[o] = out[o - dist];
+                o++;
+            }
+        } else {
+            out[o++] = in[i++];
+        }
+        bit++;
+    }
+    return o;
+}
+
+/**
+ * @brief Compress the open block and append it to the store
+ */
+static void lzh_seal(void) {
+    if (lzh_open_len == 0) {
+        return;
+    }
+    
+    // The decoded cache doubles as compressor output, so readers wait
+    xSemaphoreTake(lzh_mutex, portMAX_DELAY);
+    lzh_decoded_block = UINT32_MAX;
+    size_t packed_len = lzh_compress(lzh->open_block, lzh_open_len, lzh->decoded, lzh_open_len - 1);
+    bool compressed = packed_len > 0;
+    const uint8_t* data = compressed ? lzh->decoded : lzh->open_block;
+    size_t need = compressed ? packed_len : lzh_open_len;
+    
+    // Blocks are contiguous in the store; skip the tail if this one won't fit
+    uint32_t index = lzh_store_head % LUCIDUART_HISTORY_STORE_SIZE;
+    if (index + need > LUCIDUART_HISTORY_STORE_SIZE) {
+        lzh_store_head += LUCIDUART_HISTORY_STORE_SIZE - index;
+        index = 0;
+    }
+    while (lzh_block_tail != lzh_block_head &&
+           (lzh_store_head + need - lzh_blocks[lzh_block_tail % LUCIDUART_HISTORY_MAX_BLOCKS].pos >
+                LUCIDUART_HISTORY_STORE_SIZE ||
+            lzh_block_head - lzh_block_tail == LUCIDUART_HISTORY_MAX_BLOCKS)) {
+        lzh_block_tail++;
+        lzh_evicted++;
+    }
+    
+    memcpy(&lzh->store[index], data, need);
+    lzh_blocks[lzh_block_head % LUCIDUART_HISTORY_MAX_BLOCKS] = (lzh_block_t){
+        .offset = lzh_open_offset,
+        .pos = lzh_store_head,
+        .raw_len = lzh_open_len,
+        .stored_len = need,
+        .compressed = compressed,
+    };
+    lzh_block_head++;
+    lzh_store_head += need;
+    
+    lzh_open_offset += lzh_open_len;
+    lzh_open_len = 0;
+    xSemaphoreGive(lzh_mutex);
+}
+
+/**
+ * @brief History task - copies the RX stream into blocks
+ */
+static void lzh_task(void* pvParameters) {
+    uart_bridge_consumer_t cursor;
+    while (uart_bridge_consumer_open("history", &cursor) != ESP_OK) {
+        ESP_LOGW(TAG, "No RX cursor free for history, retrying");
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+    // Batch wakeups; nothing here is latency sensitive
+    uart_bridge_consumer_set_coalesce(cursor, LUCIDUART_HISTORY_BLOCK_SIZE / 4, 200000);
+    lzh_open_offset = uart_bridge_get_rx_offset();
+    
+    while (1) {
+        uart_bridge_consumer_wait(cursor, portMAX_DELAY);
+        
+        const uint8_t* data;
+        size_t len = uart_bridge_consumer_peek(cursor, &data);
+        uart_bridge_consumer_stats_t cstats;
+        if (len == 0 || uart_bridge_consumer_get_stats(cursor, &cstats) != ESP_OK) {
+            continue;
+        }
+        
+        // Overrun gap: close the block so offsets inside it stay exact
+        if (cstats.read_offset != lzh_open_offset + lzh_open_len) {
+            lzh_seal();
+            xSemaphoreTake(lzh_mutex, portMAX_DELAY);
+            lzh_open_offset = cstats.read_offset;
+            xSemaphoreGive(lzh_mutex);
+        }
+        
+        size_t room = LUCIDUART_HISTORY_BLOCK_SIZE - lzh_open_len;
+        if (len > room) {
+            len = room;
+        }
+        xSemaphoreTake(lzh_mutex, portMAX_DELAY);
+        memcpy(&lzh->open_block[lzh_open_len], data, len);
+        lzh_open_len += len;
+        xSemaphoreGive(lzh_mutex);
+        
+        // Lapped while copying: the copy may be torn, so take it back
+        if (uart_bridge_consumer_advance(cursor, len) != ESP_OK) {
+            xSemaphoreTake(lzh_mutex, portMAX_DELAY);
+            lzh_open_len -= len;
+            xSemaphoreGive(lzh_mutex);
+            continue;
+        }
+        
+        if (lzh_open_len == LUCIDUART_HISTORY_BLOCK_SIZE) {
+            lzh_seal();
+        }
+    }
+}
+
+esp_err_t lz_history_init(void) {
+    if (lzh_task_handle) {
+        return ESP_OK;
+    }
+    
+    lzh = calloc(1, sizeof(lzh_buffers_t));
+    lzh_mutex = xSemaphoreCreateMutex();
+    if (!lzh || !lzh_mutex) {
+        ESP_LOGE(TAG, "Failed to allocate history store");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    BaseType_t task_created = xTaskCreate(lzh_task,
+                                          "lzh_task",
+                                          LUCIDUART_HISTORY_TASK_STACK,
+                                          NULL,
+                                          LUCIDUART_HISTORY_TASK_PRIORITY,
+                                          &lzh_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create history task");
+        return ESP_FAIL;
+    }
+    
+    ESP_LOGI(TAG, "Compressed history ready (%d byte store, %d byte blocks)",
+             LUCIDUART_HISTORY_STORE_SIZE, LUCIDUART_HISTORY_BLOCK_SIZE);
+    return ESP_OK;
+}
+
+size_t lz_history_read(uint32_t* offset, uint8_t* buf, size_t max) {
+    if (!offset || !buf || max == 0 || !lzh_task_handle) {
+        return 0;
+    }
+    
+    xSemaphoreTake(lzh_mutex, portMAX_DELAY);
+    
+    // First block holding *offset, or the first one after it
+    const uint8_t* src = NULL;
+    uint32_t start = 0;
+    uint32_t avail = 0;
+    for (uint32_t b = lzh_block_tail; b != lzh_block_head; b++) {
+        const lzh_block_t* block = &lzh_blocks[b % LUCIDUART_HISTORY_MAX_BLOCKS];
+        if ((int32_t)(*offset - (block->offset + block->raw_len)) >= 0) {
+            continue;
+        }
+        
+        if (lzh_decoded_block != b) {
+            const uint8_t* stored = &lzh->store[block->pos % LUCIDUART_HISTORY_STORE_SIZE];
+            if (block->compressed) {
+                lzh_decompress(stored, block->stored_len, lzh->decoded, block->raw_len);
+            } else {
+                memcpy(lzh->decoded, stored, block->raw_len);
+            }
+            lzh_decoded_block = b;
+        }
+        src = lzh->decoded;
+        start = block->offset;
+        avail = block->raw_len;
+        break;
+    }
+    
+    // Then the block still being filled
+    if (!src && lzh_open_len && (int32_t)(*offset - (lzh_open_offset + lzh_open_len)) < 0) {
+        src = lzh->open_block;
+        start = lzh_open_offset;
+        avail = lzh_open_len;
+    }
+    
+    size_t copied = 0;
+    if (src) {
+        if ((int32_t)(*offset - start) < 0) {
+            *offset = start;
+        }
+        uint32_t skip = *offset - start;
+        copied = avail - skip;
+        if (copied > max) {
+            copied = max;
+        }
+        memcpy(buf, src + skip, copied);
+    }
+    
+    xSemaphoreGive(lzh_mutex);
+    return copied;
+}
+
+esp_err_t lz_history_get_stats(lz_history_stats_t* stats) {
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!lzh_task_handle) {
+        return ESP_OK;
+    }
+    
+    xSemaphoreTake(lzh_mutex, portMAX_DELAY);
+    uint32_t sealed_raw = 0;
+    for (uint32_t b = lzh_block_tail; b != lzh_block_head; b++) {
+        const lzh_block_t* block = &lzh_blocks[b % LUCIDUART_HISTORY_MAX_BLOCKS];
+        sealed_raw += block->raw_len;
+        stats->stored_bytes += block->stored_len;
+    }
+    stats->oldest_offset = (lzh_block_tail != lzh_block_head) ?
+                           lzh_blocks[lzh_block_tail % LUCIDUART_HISTORY_MAX_BLOCKS].offset :
+                           lzh_open_offset;
+    stats->end_offset = lzh_open_offset + lzh_open_len;
+    stats->raw_bytes = sealed_raw + lzh_open_len;
+    stats->blocks = lzh_block_head - lzh_block_tail;
+    stats->evicted_blocks = lzh_evicted;
+    stats->ratio_x100 = stats->stored_bytes ? (uint32_t)((uint64_t)sealed_raw * 100 / stats->stored_bytes) : 0;
+    xSemaphoreGive(lzh_mutex);
+    return ESP_OK;
+}
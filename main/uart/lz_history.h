@@ -0,0 +1,76 @@
+/*
+ * LZ History - LucidConsole Compressed Scrollback
+ * Keeps RX history beyond the hot ring as independently compressed blocks
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// History store configuration
+#define LUCIDUART_HISTORY_BLOCK_SIZE    1024    // Raw bytes per block (<= 1024: 10-bit match distances)
+#define LUCIDUART_HISTORY_STORE_SIZE    8192    // Compressed store bytes
+#define LUCIDUART_HISTORY_MAX_BLOCKS    64      // Block index entries
+#define LUCIDUART_HISTORY_TASK_PRIORITY 3       // Below the transports (4)
+#define LUCIDUART_HISTORY_TASK_STACK    2048
+
+// History statistics
+typedef struct {
+    uint32_t oldest_offset;     // Stream offset of the oldest retained byte
+    uint32_t end_offset;        // Stream offset just past the newest retained byte
+    uint32_t raw_bytes;         // Bytes retained (may be less than end - oldest after gaps)
+    uint32_t stored_bytes;      // Store bytes holding them
+    uint32_t blocks;            // Sealed blocks in the store
+    uint32_t evicted_blocks;    // Blocks dropped to make room
+    uint32_t ratio_x100;        // raw_bytes / stored_bytes * 100 over sealed blocks
+} lz_history_stats_t;
+
+/**
+ * @brief Initialize the compressed history
+ *
+ * Allocates the store and starts a task that copies the RX stream from
+ * its own ring cursor into LUCIDUART_HISTORY_BLOCK_SIZE blocks. Each
+ * full block is LZSS-compressed on its own (window = block), so any
+ * block can be decoded without its predecessors and the decoder needs
+ * no state beyond its output buffer. The oldest blocks are evicted
+ * when the store is full.
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM, or ESP_FAIL if the task
+ *         could not be created
+ */
+esp_err_t lz_history_init(void);
+
+/**
+ * @brief Read retained history
+ *
+ * Decompresses on demand. If *offset is older than the oldest retained
+ * byte, or falls in a gap left by an RX cursor overrun, it is moved
+ * forward to the next retained byte.
+ *
+ * @param offset Stream offset to read from; set to the offset of the
+ *               first byte returned
+ * @param buf Receives the bytes
+ * @param max Capacity of buf
+ * @return Number of bytes returned, 0 if nothing is retained at or
+ *         after *offset
+ */
+size_t lz_history_read(uint32_t* offset, uint8_t* buf, size_t max);
+
+/**
+ * @brief Get history statistics
+ *
+ * @param stats Pointer to stats structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t lz_history_get_stats(lz_history_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
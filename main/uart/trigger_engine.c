@@ -0,0 +1,448 @@
+/*
+ * Trigger Engine - LucidConsole On-Device Pattern Matching Implementation
+ * Byte-class DFA built from the pattern set, fed from its own RX cursor
+ */
+
+#include "trigger_engine.h"
+#include "uart_bridge.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+static const char* TAG = "TRIGGER";
+
+// Bytes scanned per mutex hold, so readers never wait long
+#define TRIGGER_SLICE_MAX       512
+
+// Recent bytes for before-context (power of two, covers context + match)
+#define TRIGGER_HISTORY_SIZE    128
+#define TRIGGER_HISTORY_MASK    (TRIGGER_HISTORY_SIZE - 1)
+_Static_assert(TRIGGER_HISTORY_SIZE >= LUCIDUART_TRIGGER_CONTEXT_BEFORE + LUCIDUART_TRIGGER_PATTERN_MAX,
+               "TRIGGER_HISTORY_SIZE too small for the before-context");
+
+// Complete DFA: next state = delta[state * classes + class_of[byte]].
+// State ids are bytes, which caps total pattern length at 254.
+typedef struct {
+    uint8_t* delta;             // states x classes, one allocation with out
+    uint8_t* out;               // Per state: mask of patterns ending here
+    uint16_t states;
+    uint16_t classes;
+    uint8_t class_of[256];
+} trigger_automaton_t;
+
+static SemaphoreHandle_t trigger_mutex = NULL;     // Automaton, scan state and events
+static TaskHandle_t trigger_task_handle = NULL;
+static uart_bridge_consumer_t trigger_cursor = -1;
+
+static trigger_automaton_t automaton = {0};
+static char patterns[LUCIDUART_TRIGGER_MAX_PATTERNS][LUCIDUART_TRIGGER_PATTERN_MAX + 1];
+static uint8_t pattern_lens[LUCIDUART_TRIGGER_MAX_PATTERNS];
+static trigger_engine_stats_t trigger_stats = {0};
+
+// Scanner state (trigger task)
+static uint8_t scan_state = 0;
+static uint8_t history[TRIGGER_HISTORY_SIZE];
+static uint32_t history_len = 0;        // Bytes pushed since the last reset
+static bool event_open = false;         // Event still collecting after-context
+static uint8_t event_after = 0;
+static trigger_event_t event_building;
+
+// Finished events
+static trigger_event_t events[LUCIDUART_TRIGGER_EVENTS];
+static uint32_t event_seq = 0;
+
+/**
+ * @brief Build a complete DFA from the pattern set
+ *
+ * Bytes that occur in no pattern share class 0, so the table is only as
+ * wide as the patterns' alphabet. The trie is turned into a DFA in BFS
+ * order: a missing edge copies the edge of the state's failure link,
+ * whose row is already complete because it is shallower.
+ */
+static esp_err_t automaton_build(const char (*pats)[LUCIDUART_TRIGGER_PATTERN_MAX + 1],
+                                 const uint8_t* lens, size_t count, bool ignore_case,
+                                 trigger_automaton_t* a) {
+    memset(a->class_of, 0, sizeof(a->class_of));
+    a->delta = NULL;
+    a->out = NULL;
+    
+    uint16_t classes = 1;
+    size_t total = 0;
+    for (size_t p = 0; p < count; p++) {
+        for (size_t i = 0; i < lens[p]; i++) {
+            uint8_t b = (uint8_t)pats[p][i];
+            if (ignore_case) {
+                b = tolower(b);
+            }
+            if (!a->class_of[b]) {
+                a->class_of[b] = classes++;
+            }
+        }
+        total += lens[p];
+    }
+    if (ignore_case) {
+        for (int c = 'a'; c <= 'z'; c++) {
+            a->class_of[toupper(c)] = a->class_of[c];
+        }
+    }
+    
+    size_t max_states = total + 1;
+    if (max_states > 255 || max_states * classes > LUCIDUART_TRIGGER_TABLE_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    
+    uint8_t* delta = calloc(max_states * classes + max_states, 1);
+    if (!delta) {
+        return ESP_ERR_NO_MEM;
+    }
+    uint8_t* out = delta + max_states * classes;
+    
+    // Trie - while building, 0 means no edge (the root is never a child)
+    uint16_t states = 1;
+    for (size_t p = 0; p < count; p++) {
+        uint8_t s = 0;
+        for (size_t i = 0; i < lens[p]; i++) {
+            uint8_t c = a->class_of[(uint8_t)pats[p][i]];
+            uint8_t* edge = &delta[s * classes + c];
+            if (!*edge) {
+                *edge = states++;
+            }
+            s = *edge;
+        }
+        out[s] |= 1 << p;
+    }
+    
+    // Failure links, breadth first
+    uint8_t fail[255];
+    uint8_t queue[255];
+    size_t head = 0;
+    size_t tail = 0;
+    for (uint16_t c = 0; c < classes; c++) {
+        uint8_t t = delta[c];
+        if (t) {
+            fail[t] = 0;
+            queue[tail++] = t;
+        }
+    }
+    while (head < tail) {
+        uint8_t s = queue[head++];
+        out[s] |= out[fail[s]];
+        for (uint16_t c = 0; c < classes; c++) {
+            uint8_t* edge = &delta[s * classes + c];
+            uint8_t via_fail = delta[fail[s] * classes + c];
+            if (*edge) {
+                fail[*edge] = via_fail;
+                queue[tail++] = *edge;
+            } else {
+                *edge = via_fail;
+            }
+        }
+    }
+    
+    a->delta = delta;
+    a->out = out;
+    a->states = states;
+    a->classes = classes;
+    return ESP_OK;
+}
+
+/**
+ * @brief Publish the event being built (caller holds trigger_mutex)
+ */
+static void trigger_finish(void) {
+    if (!event_open) {
+        return;
+    }
+    event_building.seq = ++event_seq;
+    events[event_seq % LUCIDUART_TRIGGER_EVENTS] = event_building;
+    trigger_stats.last_seq = event_seq;
+    event_open = false;
+    
+    ESP_LOGD(TAG, "Trigger %u: pattern %u at offset %u", event_building.seq,
+             event_building.pattern, event_building.offset);
+}
+
+/**
+ * @brief Forget scan position (pattern change or lost bytes)
+ */
+static void trigger_scan_reset(void) {
+    trigger_finish();
+    scan_state = 0;
+    history_len = 0;
+}
+
+/**
+ * @brief Start an event for a match ending at stream offset end
+ *
+ * Before-context comes from the history and stops at the previous line
+ * break; after-context is appended as further bytes arrive.
+ */
+static void trigger_begin(uint8_t pattern, uint32_t end) {
+    trigger_finish();
+    
+    uint8_t len = pattern_lens[pattern];
+    uint32_t before = 0;
+    uint32_t held = (history_len < TRIGGER_HISTORY_SIZE) ? history_len : TRIGGER_HISTORY_SIZE;
+    while (before < LUCIDUART_TRIGGER_CONTEXT_BEFORE && before + len < held) {
+        uint8_t b = history[(history_len - len - before - 1) & TRIGGER_HISTORY_MASK];
+        if (b == '\n' || b == '\r') {
+            break;
+        }
+        before++;
+    }
+    
+    trigger_event_t* e = &event_building;
+    e->pattern = pattern;
+    e->offset = end + 1 - len;
+    e->match_start = before;
+    e->match_len = len;
+    e->context_len = before + len;
+    for (uint32_t i = 0; i < e->context_len; i++) {
+        e->context[i] = history[(history_len - e->context_len + i) & TRIGGER_HISTORY_MASK];
+    }
+    if (uart_bridge_get_arrival_time(end, &e->time_us) != ESP_OK) {
+        e->time_us = esp_timer_get_time();
+    }
+    
+    event_open = true;
+    event_after = 0;
+    trigger_stats.total_matches++;
+    trigger_stats.matches[pattern]++;
+}
+
+/**
+ * @brief Run the automaton over a slice (caller holds trigger_mutex)
+ *
+ * @param data Slice of the RX ring
+ * @param len Slice length
+ * @param offset Stream offset of data[0]
+ */
+static void trigger_scan(const uint8_t* data, size_t len, uint32_t offset) {
+    const uint8_t* delta = automaton.delta;
+    const uint8_t* out = automaton.out;
+    const uint8_t* class_of = automaton.class_of;
+    uint16_t classes = automaton.classes;
+    uint8_t s = scan_state;
+    
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = data[i];
+        history[history_len++ & TRIGGER_HISTORY_MASK] = b;
+        
+        if (event_open) {
+            if (b == '\n' || b == '\r') {
+                trigger_finish();
+            } else {
+                event_building.context[event_building.context_len++] = b;
+                if (++event_after >= LUCIDUART_TRIGGER_CONTEXT_AFTER) {
+                    trigger_finish();
+                }
+            }
+        }
+        
+        s = delta[s * classes + class_of[b]];
+        if (out[s]) {
+            for (uint8_t p = 0; p < LUCIDUART_TRIGGER_MAX_PATTERNS; p++) {
+                if (out[s] & (1 << p)) {
+                    trigger_begin(p, offset + i);
+                }
+            }
+        }
+    }
+    
+    scan_state = s;
+    trigger_stats.bytes_scanned += len;
+}
+
+/**
+ * @brief Trigger scanner task
+ *
+ * Holds an RX ring cursor only while a pattern set is installed.
+ */
+static void trigger_task(void* pvParameters) {
+    while (1) {
+        bool active = trigger_engine_active();
+        if (active && trigger_cursor < 0) {
+            if (uart_bridge_consumer_open("trigger", &trigger_cursor) != ESP_OK) {
+                ESP_LOGW(TAG, "No RX cursor free for triggers, retrying");
+                trigger_cursor = -1;
+                vTaskDelay(pdMS_TO_TICKS(1000));
+                continue;
+            }
+        } else if (!active && trigger_cursor >= 0) {
+            uart_bridge_consumer_close(trigger_cursor);
+            trigger_cursor = -1;
+        }
+        
+        if (trigger_cursor < 0) {
+            // Woken by trigger_engine_set_patterns()
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        
+        if (!uart_bridge_consumer_wait(trigger_cursor, pdMS_TO_TICKS(LUCIDUART_TRIGGER_CONTEXT_MS))) {
+            // Line went idle - publish without waiting for more context
+            xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+            trigger_finish();
+            xSemaphoreGive(trigger_mutex);
+            continue;
+        }
+        
+        const uint8_t* data;
+        size_t len = uart_bridge_consumer_peek(trigger_cursor, &data);
+        uart_bridge_consumer_stats_t cstats;
+        if (len == 0 || uart_bridge_consumer_get_stats(trigger_cursor, &cstats) != ESP_OK) {
+            continue;
+        }
+        if (len > TRIGGER_SLICE_MAX) {
+            len = TRIGGER_SLICE_MAX;
+        }
+        
+        xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+        if (automaton.delta) {
+            trigger_scan(data, len, cstats.read_offset);
+        }
+        xSemaphoreGive(trigger_mutex);
+        
+        // Lapped while scanning: the slice was overwritten, start clean
+        if (uart_bridge_consumer_advance(trigger_cursor, len) != ESP_OK) {
+            xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+            trigger_scan_reset();
+            xSemaphoreGive(trigger_mutex);
+        }
+    }
+}
+
+esp_err_t trigger_engine_init(void) {
+    if (trigger_task_handle) {
+        return ESP_OK;
+    }
+    
+    trigger_mutex = xSemaphoreCreateMutex();
+    if (!trigger_mutex) {
+        ESP_LOGE(TAG, "Failed to create trigger mutex");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    BaseType_t task_created = xTaskCreate(trigger_task,
+                                          "trigger_task",
+                                          LUCIDUART_TRIGGER_TASK_STACK,
+                                          NULL,
+                                          LUCIDUART_TRIGGER_TASK_PRIORITY,
+                                          &trigger_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create trigger task");
+        return ESP_FAIL;
+    }
+    
+    ESP_LOGI(TAG, "Trigger engine ready");
+    return ESP_OK;
+}
+
+esp_err_t trigger_engine_set_patterns(const char* const* new_patterns, size_t count, bool ignore_case) {
+    if (!trigger_mutex) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (count > LUCIDUART_TRIGGER_MAX_PATTERNS || (count && !new_patterns)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t p = 0; p < count; p++) {
+        size_t len = new_patterns[p] ? strlen(new_patterns[p]) : 0;
+        if (len == 0 || len > LUCIDUART_TRIGGER_PATTERN_MAX) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    // Build outside the lock; a rejected set leaves the current one running
+    char staged[LUCIDUART_TRIGGER_MAX_PATTERNS][LUCIDUART_TRIGGER_PATTERN_MAX + 1] = {0};
+    uint8_t staged_lens[LUCIDUART_TRIGGER_MAX_PATTERNS];
+    for (size_t p = 0; p < count; p++) {
+        strncpy(staged[p], new_patterns[p], LUCIDUART_TRIGGER_PATTERN_MAX);
+        staged_lens[p] = strlen(staged[p]);
+    }
+    
+    trigger_automaton_t built = {0};
+    if (count) {
+        esp_err_t ret = automaton_build(staged, staged_lens, count, ignore_case, &built);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Pattern set rejected: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    
+    xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+    trigger_scan_reset();
+    free(automaton.delta);
+    automaton = built;
+    memcpy(patterns, staged, sizeof(patterns));
+    memcpy(pattern_lens, staged_lens, count);
+    
+    memset(trigger_stats.matches, 0, sizeof(trigger_stats.matches));
+    trigger_stats.total_matches = 0;
+    trigger_stats.pattern_count = count;
+    trigger_stats.ignore_case = ignore_case;
+    trigger_stats.states = automaton.states;
+    trigger_stats.classes = automaton.classes;
+    xSemaphoreGive(trigger_mutex);
+    
+    xTaskNotifyGive(trigger_task_handle);
+    
+    ESP_LOGI(TAG, "%u trigger patterns installed (%u states, %u byte classes)",
+             (unsigned)count, automaton.states, automaton.classes);
+    return ESP_OK;
+}
+
+esp_err_t trigger_engine_get_pattern(uint8_t index, char* buf, size_t size) {
+    if (!buf || size == 0 || !trigger_mutex) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    if (index < trigger_stats.pattern_count) {
+        strncpy(buf, patterns[index], size - 1);
+        buf[size - 1] = '\0';
+        ret = ESP_OK;
+    }
+    xSemaphoreGive(trigger_mutex);
+    return ret;
+}
+
+bool trigger_engine_get_event(uint32_t after_seq, trigger_event_t* event) {
+    if (!event || !trigger_mutex) {
+        return false;
+    }
+    
+    xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+    uint32_t oldest = (event_seq > LUCIDUART_TRIGGER_EVENTS) ? event_seq - LUCIDUART_TRIGGER_EVENTS + 1 : 1;
+    uint32_t seq = (after_seq + 1 > oldest) ? after_seq + 1 : oldest;
+    bool found = (seq <= event_seq);
+    if (found) {
+        *event = events[seq % LUCIDUART_TRIGGER_EVENTS];
+    }
+    xSemaphoreGive(trigger_mutex);
+    return found;
+}
+
+esp_err_t trigger_engine_get_stats(trigger_engine_stats_t* stats) {
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!trigger_mutex) {
+        memset(stats, 0, sizeof(*stats));
+        return ESP_OK;
+    }
+    
+    xSemaphoreTake(trigger_mutex, portMAX_DELAY);
+    *stats = trigger_stats;
+    xSemaphoreGive(trigger_mutex);
+    return ESP_OK;
+}
+
+bool trigger_engine_active(void) {
+    return automaton.delta != NULL;
+}
@@ -0,0 +1,125 @@
+/*
+ * Trigger Engine - LucidConsole On-Device Pattern Matching
+ * Aho-Corasick matcher run incrementally over the UART RX stream
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pattern set limits
+#define LUCIDUART_TRIGGER_MAX_PATTERNS      8       // One match-mask bit each
+#define LUCIDUART_TRIGGER_PATTERN_MAX       32      // Bytes per pattern
+#define LUCIDUART_TRIGGER_TABLE_MAX         8192    // Transition table bytes (states x byte classes)
+
+// Match context: bytes before the match (same line only) and after it
+// (up to the end of line, or until the line goes idle)
+#define LUCIDUART_TRIGGER_CONTEXT_BEFORE    48
+#define LUCIDUART_TRIGGER_CONTEXT_AFTER     48
+#define LUCIDUART_TRIGGER_CONTEXT_MS        100     // Idle time that ends the after-context
+#define LUCIDUART_TRIGGER_CONTEXT_MAX       (LUCIDUART_TRIGGER_CONTEXT_BEFORE + \
+                                             LUCIDUART_TRIGGER_PATTERN_MAX + \
+                                             LUCIDUART_TRIGGER_CONTEXT_AFTER)
+
+#define LUCIDUART_TRIGGER_EVENTS            8       // Finished events kept for readers
+#define LUCIDUART_TRIGGER_TASK_PRIORITY     4       // Below the UART task (5)
+#define LUCIDUART_TRIGGER_TASK_STACK        2560
+
+// One match with its surrounding bytes
+typedef struct {
+    uint32_t seq;               // Increments per event, starting at 1
+    uint8_t pattern;            // Index into the pattern set
+    uint32_t offset;            // RX stream offset of the match's first byte
+    int64_t time_us;            // esp_timer time the match's last byte arrived
+    uint8_t match_start;        // Position of the match within context
+    uint8_t match_len;
+    uint8_t context_len;
+    uint8_t context[LUCIDUART_TRIGGER_CONTEXT_MAX];
+} trigger_event_t;
+
+// Engine statistics
+typedef struct {
+    uint8_t pattern_count;
+    bool ignore_case;
+    uint16_t states;            // Automaton states
+    uint16_t classes;           // Byte equivalence classes
+    uint64_t bytes_scanned;
+    uint32_t total_matches;
+    uint32_t matches[LUCIDUART_TRIGGER_MAX_PATTERNS];
+    uint32_t last_seq;          // seq of the newest finished event
+} trigger_engine_stats_t;
+
+/**
+ * @brief Initialize the trigger engine
+ *
+ * Starts the scanner task. It holds no RX ring cursor until a pattern
+ * set is installed.
+ *
+ * @return ESP_OK on success, error code on failure
+ */
+esp_err_t trigger_engine_init(void);
+
+/**
+ * @brief Replace the pattern set
+ *
+ * Builds an Aho-Corasick automaton over byte equivalence classes, so
+ * scanning costs one table lookup per byte however many patterns are
+ * set. Matches are found across RX chunk boundaries without buffering
+ * lines. Per-pattern counters restart from zero.
+ *
+ * @param patterns NUL-terminated patterns (copied)
+ * @param count Number of patterns, 0 to stop matching
+ * @param ignore_case Match ASCII letters case-insensitively
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG for an empty, too long
+ *         or too many patterns, ESP_ERR_INVALID_SIZE if the automaton
+ *         would exceed LUCIDUART_TRIGGER_TABLE_MAX, ESP_ERR_NO_MEM
+ */
+esp_err_t trigger_engine_set_patterns(const char* const* patterns, size_t count, bool ignore_case);
+
+/**
+ * @brief Copy one pattern of the current set
+ *
+ * @param index Pattern index
+ * @param buf Receives the NUL-terminated pattern
+ * @param size Size of buf
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND for an unused index
+ */
+esp_err_t trigger_engine_get_pattern(uint8_t index, char* buf, size_t size);
+
+/**
+ * @brief Get the oldest kept event newer than a sequence number
+ *
+ * Readers keep the last seq they saw; events older than the newest
+ * LUCIDUART_TRIGGER_EVENTS are skipped.
+ *
+ * @param after_seq Last sequence number already seen (0 for none)
+ * @param event Receives the event
+ * @return true if an event was returned
+ */
+bool trigger_engine_get_event(uint32_t after_seq, trigger_event_t* event);
+
+/**
+ * @brief Get trigger engine statistics
+ *
+ * @param stats Pointer to stats structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t trigger_engine_get_stats(trigger_engine_stats_t* stats);
+
+/**
+ * @brief Check whether a pattern set is installed
+ *
+ * @return true if the engine is matching
+ */
+bool trigger_engine_active(void);
+
+#ifdef __cplusplus
+}
+#endif
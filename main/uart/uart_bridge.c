@@ -6,10 +6,15 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
 #include "uart_bridge.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
+#include "esp_timer.h"
 #include <string.h>
+#include <stdlib.h>
+#include <math.h>
 
 static const char* TAG = "UART_BRIDGE";
 
@@ -23,11 +28,851 @@ static uart_bridge_stats_t bridge_stats = {0};
 static TaskHandle_t uart_rx_task_handle = NULL;
 static QueueHandle_t uart_event_queue = NULL;
 
+// Stop and reconfiguration requests run on the UART task between two
+// reads. The event posted to wake it is a type the driver never sends.
+#define BRIDGE_CTRL_EVENT   UART_EVENT_MAX
+
+typedef enum {
+    BRIDGE_CTRL_RECONFIG,
+    BRIDGE_CTRL_STOP,
+} bridge_ctrl_op_t;
+
+static SemaphoreHandle_t ctrl_mutex = NULL;     // One request in flight
+static volatile bool ctrl_pending = false;
+static volatile bool ctrl_done = false;
+static bridge_ctrl_op_t ctrl_op;
+static uart_bridge_config_t ctrl_config;
+static esp_err_t ctrl_result;
+static TaskHandle_t ctrl_waiter = NULL;
+
+// Counters are written from the UART task and every sender task, so
+// 64-bit updates and snapshots happen inside a critical section
+#define STATS_ADD(field, n) do {        \
+    portENTER_CRITICAL();               \
+    bridge_stats.field += (n);          \
+    portEXIT_CRITICAL();                \
+} while (0)
+
+// EWMA byte-rate meter, sampled about once per second
+typedef struct {
+    float ewma_1s;
+    float ewma_10s;
+    float ewma_60s;
+    float peak_1s;
+    uint64_t mark;              // Counter value at the last sample
+} rate_meter_t;
+
+static rate_meter_t rx_meter = {0};
+static rate_meter_t tx_meter = {0};
+static int64_t stats_epoch = 0;         // esp_timer time of init / last reset
+static int64_t stats_sample_stamp = 0;  // esp_timer time of the last sample
+static uint32_t stats_sample_events = 0;
+
+// Auto-baud detection
+static const uint32_t autobaud_default_rates[] = {
+    115200, 74880, 921600, 9600, 57600, 230400, 460800,
+};
+static uint32_t autobaud_rates[LUCIDUART_AUTOBAUD_MAX_CANDIDATES];
+static size_t autobaud_rate_count = 0;
+static volatile bool autobaud_cancel = false;
+static uart_bridge_autobaud_status_t autobaud_status = {0};
+static TaskHandle_t autobaud_task_handle = NULL;
+
+// While a sweep runs, every byte is scored but only bytes received at
+// autobaud_publish_baud reach the ring. The first AUTOBAUD_KEEP_SIZE bytes
+// of each other probe are kept, and the best window is published when its
+// rate locks. TX is held until the sweep ends.
+#define AUTOBAUD_SCRATCH_SIZE   128
+#define AUTOBAUD_KEEP_SIZE      512
+static volatile bool autobaud_sweeping = false;
+static volatile uint32_t autobaud_publish_baud = 0;
+static uint8_t autobaud_scratch[AUTOBAUD_SCRATCH_SIZE];
+static uint8_t* autobaud_keep = NULL;   // Current probe, then best window
+static size_t autobaud_probe_len = 0;
+static volatile size_t autobaud_best_len = 0;
+static volatile uint32_t autobaud_total = 0;
+static volatile uint32_t autobaud_printable_count = 0;
+
+// TX backlog estimate (bytes written minus bytes drained at line rate)
+static uint32_t tx_backlog = 0;
+static int64_t tx_backlog_stamp = 0;
+
+// Asynchronous TX queue: payload bytes sit in tx_arena in submission
+// order and tx_queue carries one descriptor per message to the TX task
+typedef struct {
+    uint32_t offset;            // Arena offset of the first byte (free-running)
+    uint32_t length;
+    uint32_t generation;        // tx_generation at submit; stale after a TX purge
+    uart_bridge_tx_done_t done;
+    void* ctx;
+} tx_msg_t;
+
+static uint8_t tx_arena[LUCIDUART_TX_QUEUE_BYTES];
+static volatile uint32_t tx_arena_head = 0;     // End of the last queued message
+static volatile uint32_t tx_arena_tail = 0;     // End of the last completed message
+static volatile uint32_t tx_generation = 0;
+static QueueHandle_t tx_queue = NULL;
+static SemaphoreHandle_t tx_submit_mutex = NULL;    // Serializes submitters
+static SemaphoreHandle_t tx_write_mutex = NULL;     // Held while writing or reconfiguring the driver
+static SemaphoreHandle_t tx_space_sem = NULL;       // Given each time a message completes
+static TaskHandle_t uart_tx_task_handle = NULL;
+
+// Software flow control (xonxoff_enabled)
+static bool flow_rx_throttled = false;          // XOFF sent to the target, XON not yet
+static volatile bool flow_tx_paused = false;    // Target sent XOFF
+static volatile uint8_t flow_pending = 0;       // XON/XOFF for the TX task to write next
+static int64_t flow_rx_since = 0;
+static int64_t flow_tx_since = 0;
+static int64_t flow_rx_throttled_us = 0;
+static int64_t flow_tx_paused_us = 0;
+
 // Data callback for forwarding UART data to network clients
 static void (*rx_data_callback)(const uint8_t* data, size_t length) = NULL;
 
-// Internal buffers
-static uint8_t rx_buffer[LUCIDUART_RX_BUF_SIZE];
+// RX ring buffer - written once by the UART task, read by all consumers.
+// Offsets are free-running 32-bit stream positions; the ring index is
+// offset & LUCIDUART_RX_RING_MASK.
+#define LUCIDUART_RX_RING_MASK      (LUCIDUART_RX_RING_SIZE - 1)
+_Static_assert((LUCIDUART_RX_RING_SIZE & LUCIDUART_RX_RING_MASK) == 0,
+               "LUCIDUART_RX_RING_SIZE must be a power of two");
+
+static uint8_t rx_ring[LUCIDUART_RX_RING_SIZE];
+static volatile uint32_t rx_ring_head = 0;      // Next offset to be written
+static volatile uint32_t rx_ring_reserve = 0;   // End of region being written
+static bool rx_ring_filled = false;             // Ring has wrapped at least once
+
+// Line-start index - appended by the UART task, searched by transports.
+// Times are stored as the low 32 bits of esp_timer to halve the index.
+#define LUCIDUART_RX_LINE_MASK      (LUCIDUART_RX_LINE_INDEX_SIZE - 1)
+_Static_assert((LUCIDUART_RX_LINE_INDEX_SIZE & LUCIDUART_RX_LINE_MASK) == 0,
+               "LUCIDUART_RX_LINE_INDEX_SIZE must be a power of two");
+
+typedef struct {
+    uint32_t offset;
+    uint32_t time_lo;
+} rx_stamp_t;
+
+static rx_stamp_t rx_lines[LUCIDUART_RX_LINE_INDEX_SIZE];
+static volatile uint32_t rx_line_head = 0;      // Total lines stamped
+static bool rx_line_open = false;               // Inside a line already stamped
+static bool rx_line_cr = false;                 // Last byte was CR (CRLF is one break)
+
+// Arrival index - one entry per ring fill, for end-to-end latency
+#define LUCIDUART_RX_CHUNK_MASK     (LUCIDUART_RX_CHUNK_INDEX_SIZE - 1)
+_Static_assert((LUCIDUART_RX_CHUNK_INDEX_SIZE & LUCIDUART_RX_CHUNK_MASK) == 0,
+               "LUCIDUART_RX_CHUNK_INDEX_SIZE must be a power of two");
+
+static rx_stamp_t rx_chunks[LUCIDUART_RX_CHUNK_INDEX_SIZE];
+static volatile uint32_t rx_chunk_head = 0;     // Total fills stamped
+
+typedef struct {
+    bool in_use;
+    const char* name;
+    uint32_t read_offset;
+    uint32_t overruns;
+    uint32_t dropped_bytes;
+    
+    // Coalescing: flush at min_bytes or max_delay_us after the first byte
+    uint32_t coalesce_bytes;
+    uint32_t coalesce_us;
+    int64_t pending_since;      // Arrival time of first unflushed byte (writer)
+    uint32_t flush_end;         // Offset the current flush runs to
+    uint32_t batches;
+    uint32_t batched_bytes;
+    uint32_t max_batch;
+} rx_consumer_t;
+
+static rx_consumer_t rx_consumers[LUCIDUART_MAX_CONSUMERS];
+static EventGroupHandle_t rx_consumer_events = NULL;   // One bit per consumer
+static EventBits_t rx_consumer_mask = 0;               // Bits of open consumers
+
+/**
+ * @brief Resynchronize a cursor the writer has lapped
+ * 
+ * Moves the cursor to the oldest byte still intact in the ring and
+ * records the skipped bytes against the consumer.
+ * 
+ * @return true if the cursor was lapped
+ */
+static bool rx_consumer_resync(rx_consumer_t* c) {
+    uint32_t oldest = rx_ring_reserve - LUCIDUART_RX_RING_SIZE;
+    if ((int32_t)(c->read_offset - oldest) >= 0) {
+        return false;
+    }
+    c->overruns++;
+    c->dropped_bytes += oldest - c->read_offset;
+    c->read_offset = oldest;
+    return true;
+}
+
+/**
+ * @brief Decide whether a consumer's pending data should be flushed now
+ * 
+ * Once a flush starts it runs to the head captured at that moment, so
+ * the tail of a batch is never held back by the threshold.
+ * 
+ * @param c Consumer
+ * @param wait_ticks Receives ticks until the deadline if not ready
+ * @return true if the consumer should read now
+ */
+static bool rx_consumer_ready(rx_consumer_t* c, TickType_t* wait_ticks) {
+    uint32_t head = rx_ring_head;
+    uint32_t pending = head - c->read_offset;
+    
+    *wait_ticks = portMAX_DELAY;
+    if (pending == 0) {
+        return false;
+    }
+    if ((int32_t)(c->flush_end - c->read_offset) > 0) {
+        return true;
+    }
+    
+    if (pending < c->coalesce_bytes) {
+        int64_t left_us = c->pending_since + c->coalesce_us - esp_timer_get_time();
+        if (left_us > 0) {
+            // Round up; the deadline is only as fine as the tick
+            *wait_ticks = (left_us + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000);
+            return false;
+        }
+    }
+    
+    if (pending > LUCIDUART_RX_RING_SIZE) {
+        pending = LUCIDUART_RX_RING_SIZE;
+    }
+    c->flush_end = head;
+    c->batches++;
+    c->batched_bytes += pending;
+    if (pending > c->max_batch) {
+        c->max_batch = pending;
+    }
+    return true;
+}
+
+/**
+ * @brief Stamp line starts in freshly read data
+ * 
+ * A line starts at the first byte that is not CR or LF after a break, so
+ * boundaries split across reads are handled by the carried state.
+ */
+static void rx_line_scan(uint32_t offset, const uint8_t* data, size_t len, int64_t stamp) {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = data[i];
+        if (b == '\n' || b == '\r') {
+            rx_line_open = false;
+            rx_line_cr = (b == '\r');
+            continue;
+        }
+        rx_line_cr = false;
+        if (!rx_line_open) {
+            rx_lines[rx_line_head & LUCIDUART_RX_LINE_MASK] = (rx_stamp_t){
+                .offset = offset + i,
+                .time_lo = (uint32_t)stamp,
+            };
+            rx_line_head++;
+            rx_line_open = true;
+        }
+    }
+}
+
+/**
+ * @brief Largest number of unread bytes across open consumers
+ */
+static uint32_t rx_ring_max_lag(void) {
+    uint32_t head = rx_ring_head;
+    uint32_t lag = 0;
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        if (rx_consumers[i].in_use && head - rx_consumers[i].read_offset > lag) {
+            lag = head - rx_consumers[i].read_offset;
+        }
+    }
+    return lag;
+}
+
+/**
+ * @brief Wake the TX task to write a flow-control character
+ */
+static void flow_wake_tx(void) {
+    if (!uart_tx_task_handle) {
+        return;
+    }
+    // A zero-length descriptor wakes the task if it is idle on the queue
+    // (if the queue is full it is busy and checks between chunks)...
+    tx_msg_t wake = {0};
+    xQueueSendToFront(tx_queue, &wake, 0);
+    // ...and a notification wakes it if the target has paused it
+    xTaskNotifyGive(uart_tx_task_handle);
+}
+
+/**
+ * @brief Send XOFF/XON as the slowest consumer crosses the watermarks
+ * 
+ * The character is written by the TX task ahead of queued data, so
+ * callers never block on the UART. Also releases the target when flow
+ * control is switched off while it is held.
+ */
+static void flow_rx_update(void) {
+    bool enabled = current_config.xonxoff_enabled;
+    if (!enabled && !flow_rx_throttled) {
+        return;
+    }
+    
+    uint32_t lag = rx_ring_max_lag();
+    int64_t now = esp_timer_get_time();
+    uint8_t send = 0;
+    
+    portENTER_CRITICAL();
+    if (!flow_rx_throttled && enabled && lag > LUCIDUART_XOFF_HIGH_WATER) {
+        flow_rx_throttled = true;
+        flow_rx_since = now;
+        bridge_stats.flow_xoff_sent++;
+        send = LUCIDUART_XOFF;
+    } else if (flow_rx_throttled && (!enabled || lag < LUCIDUART_XOFF_LOW_WATER)) {
+        flow_rx_throttled = false;
+        flow_rx_throttled_us += now - flow_rx_since;
+        send = LUCIDUART_XON;
+    }
+    if (send) {
+        // Replaces a character the TX task has not written yet
+        flow_pending = send;
+    }
+    portEXIT_CRITICAL();
+    
+    if (send) {
+        flow_wake_tx();
+    }
+}
+
+/**
+ * @brief Pause or resume the TX queue on XOFF/XON from the target
+ */
+static void flow_tx_set(bool paused) {
+    int64_t now = esp_timer_get_time();
+    
+    portENTER_CRITICAL();
+    if (paused && !flow_tx_paused) {
+        flow_tx_paused = true;
+        flow_tx_since = now;
+        bridge_stats.flow_xoff_received++;
+    } else if (!paused && flow_tx_paused) {
+        flow_tx_paused = false;
+        flow_tx_paused_us += now - flow_tx_since;
+    }
+    portEXIT_CRITICAL();
+    
+    if (!paused && uart_tx_task_handle) {
+        xTaskNotifyGive(uart_tx_task_handle);
+    }
+}
+
+/**
+ * @brief Remove XON/XOFF from freshly read data and apply them to TX
+ * 
+ * @return Number of data bytes left, compacted in place
+ */
+static size_t flow_rx_strip(uint8_t* data, size_t len) {
+    size_t out = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] == LUCIDUART_XOFF) {
+            flow_tx_set(true);
+        } else if (data[i] == LUCIDUART_XON) {
+            flow_tx_set(false);
+        } else {
+            data[out++] = data[i];
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Check if a byte looks like console text
+ */
+static bool autobaud_printable(uint8_t b) {
+    return (b >= 0x20 && b < 0x7F) || b == '\r' || b == '\n' || b == '\t';
+}
+
+/**
+ * @brief Add received bytes to the auto-baud score
+ * 
+ * @param keep Also append them to the current probe window
+ */
+static void autobaud_score(const uint8_t* data, size_t length, bool keep) {
+    uint32_t printable = 0;
+    for (size_t i = 0; i < length; i++) {
+        printable += autobaud_printable(data[i]);
+    }
+    
+    portENTER_CRITICAL();
+    autobaud_printable_count += printable;
+    autobaud_total += length;
+    if (keep && autobaud_keep && autobaud_probe_len < AUTOBAUD_KEEP_SIZE) {
+        size_t n = AUTOBAUD_KEEP_SIZE - autobaud_probe_len;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(autobaud_keep + autobaud_probe_len, data, n);
+        autobaud_probe_len += n;
+    }
+    portEXIT_CRITICAL();
+}
+
+/**
+ * @brief Read buffered UART data received at a probe rate into the score
+ * 
+ * @return Number of bytes read from the driver (0 if nothing was read)
+ */
+static int autobaud_fill(size_t wanted) {
+    size_t bytes_to_read = (wanted < sizeof(autobaud_scratch)) ? wanted : sizeof(autobaud_scratch);
+    int bytes_read = uart_read_bytes(LUCIDUART_UART_NUM, autobaud_scratch,
+                                     bytes_to_read, pdMS_TO_TICKS(100));
+    if (bytes_read <= 0) {
+        return 0;
+    }
+    
+    autobaud_score(autobaud_scratch, bytes_read, true);
+    return bytes_read;
+}
+
+/**
+ * @brief Publish bytes already written at the ring head
+ * 
+ * Records their stamps, advances the head and wakes consumers. The
+ * region must have been claimed through rx_ring_reserve.
+ */
+static void rx_ring_commit(uint32_t head, size_t index, int bytes_read, int64_t stamp) {
+    // Stamps go in before the bytes are published so readers see both
+    if (current_config.timestamp_enabled) {
+        uint32_t lines_before = rx_line_head;
+        rx_line_scan(head, &rx_ring[index], bytes_read, stamp);
+        STATS_ADD(rx_lines, rx_line_head - lines_before);
+    }
+    
+    rx_chunks[rx_chunk_head & LUCIDUART_RX_CHUNK_MASK] = (rx_stamp_t){
+        .offset = head,
+        .time_lo = (uint32_t)stamp,
+    };
+    rx_chunk_head++;
+    
+    rx_ring_head = head + bytes_read;
+    rx_ring_reserve = rx_ring_head;
+    if (rx_ring_head >= LUCIDUART_RX_RING_SIZE) {
+        rx_ring_filled = true;
+    }
+    
+    // Wake a consumer on its first unflushed byte (to arm its deadline)
+    // and when its byte threshold is crossed - not on every read
+    EventBits_t wake = 0;
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        rx_consumer_t* c = &rx_consumers[i];
+        if (!c->in_use) {
+            continue;
+        }
+        uint32_t before = head - c->read_offset;
+        if (before == 0) {
+            c->pending_since = stamp;
+        }
+        if (before == 0 || before + bytes_read >= c->coalesce_bytes) {
+            wake |= (EventBits_t)1 << i;
+        }
+    }
+    if (wake & rx_consumer_mask) {
+        xEventGroupSetBits(rx_consumer_events, wake & rx_consumer_mask);
+    }
+    
+    // Forward to legacy callback directly from the ring
+    if (rx_data_callback) {
+        rx_data_callback(&rx_ring[index], bytes_read);
+    }
+}
+
+/**
+ * @brief Copy bytes that were not read straight from the driver into the ring
+ */
+static void rx_ring_publish(const uint8_t* data, size_t length, int64_t stamp) {
+    while (length > 0) {
+        uint32_t head = rx_ring_head;
+        size_t index = head & LUCIDUART_RX_RING_MASK;
+        size_t n = LUCIDUART_RX_RING_SIZE - index;
+        if (n > length) {
+            n = length;
+        }
+        
+        rx_ring_reserve = head + n;
+        memcpy(&rx_ring[index], data, n);
+        rx_ring_commit(head, index, n, stamp);
+        data += n;
+        length -= n;
+    }
+}
+
+/**
+ * @brief Read buffered UART data straight into the RX ring
+ * 
+ * Reads at most up to the end of the ring so every read lands in one
+ * contiguous region, then publishes the new head and wakes consumers.
+ * 
+ * @return Number of bytes read from the driver (0 if nothing was read);
+ *         XON/XOFF removed by flow control are included
+ */
+static int rx_ring_fill(size_t wanted, int64_t stamp) {
+    bool sweeping = autobaud_sweeping;
+    if (sweeping && current_config.baud_rate != autobaud_publish_baud) {
+        return autobaud_fill(wanted);
+    }
+    
+    uint32_t head = rx_ring_head;
+    size_t index = head & LUCIDUART_RX_RING_MASK;
+    size_t space = LUCIDUART_RX_RING_SIZE - index;
+    size_t bytes_to_read = (wanted < space) ? wanted : space;
+    
+    // Claim the region first so readers treat it as overwritten
+    rx_ring_reserve = head + bytes_to_read;
+    int bytes_read = uart_read_bytes(LUCIDUART_UART_NUM, &rx_ring[index],
+                                     bytes_to_read, pdMS_TO_TICKS(100));
+    if (bytes_read <= 0) {
+        rx_ring_reserve = head;
+        return 0;
+    }
+    
+    int bytes_received = bytes_read;
+    if (current_config.xonxoff_enabled) {
+        bytes_read = flow_rx_strip(&rx_ring[index], bytes_read);
+        if (bytes_read == 0) {
+            rx_ring_reserve = head;
+            return bytes_received;
+        }
+    }
+    
+    // The configured rate is probed like any other, but its bytes are kept
+    if (sweeping) {
+        autobaud_score(&rx_ring[index], bytes_read, false);
+    }
+    
+    rx_ring_commit(head, index, bytes_read, stamp);
+    return bytes_received;
+}
+
+/**
+ * @brief Resolve the RX interrupt profile to concrete thresholds
+ * 
+ * Fills rx_full_thresh / rx_timeout_symbols for preset profiles and
+ * clamps custom values to the 7-bit hardware fields. The FIFO threshold
+ * is also kept at or above LUCIDUART_IRQ_MIN_FULL, the lowest one the
+ * event queue is sized for.
+ */
+static void uart_irq_resolve(uart_bridge_config_t* config) {
+    uart_bridge_irq_profile_t profile = config->irq_profile;
+    if (profile == UART_BRIDGE_IRQ_AUTO) {
+        profile = (config->baud_rate >= LUCIDUART_IRQ_HIGH_BAUD) ?
+                  UART_BRIDGE_IRQ_HIGH_THROUGHPUT : UART_BRIDGE_IRQ_LOW_LATENCY;
+    }
+    
+    switch (profile) {
+        case UART_BRIDGE_IRQ_LOW_LATENCY:
+            config->rx_full_thresh = LUCIDUART_IRQ_LOWLAT_FULL;
+            config->rx_timeout_symbols = LUCIDUART_IRQ_LOWLAT_TOUT;
+            break;
+            
+        case UART_BRIDGE_IRQ_HIGH_THROUGHPUT:
+            config->rx_full_thresh = LUCIDUART_IRQ_THROUGHPUT_FULL;
+            config->rx_timeout_symbols = LUCIDUART_IRQ_THROUGHPUT_TOUT;
+            break;
+            
+        default:
+            config->rx_full_thresh = (config->rx_full_thresh < LUCIDUART_IRQ_MIN_FULL) ? LUCIDUART_IRQ_MIN_FULL :
+                                     (config->rx_full_thresh > 127) ? 127 : config->rx_full_thresh;
+            config->rx_timeout_symbols = (config->rx_timeout_symbols < 1) ? 1 :
+                                         (config->rx_timeout_symbols > 127) ? 127 : config->rx_timeout_symbols;
+            break;
+    }
+}
+
+/**
+ * @brief Program RX FIFO full threshold and idle timeout
+ */
+static esp_err_t uart_apply_intr_config(void) {
+    uart_intr_config_t intr_config = {
+        .intr_enable_mask = UART_RXFIFO_FULL_INT_ENA_M | UART_RXFIFO_TOUT_INT_ENA_M |
+                            UART_FRM_ERR_INT_ENA_M | UART_PARITY_ERR_INT_ENA_M |
+                            UART_RXFIFO_OVF_INT_ENA_M,
+        .rxfifo_full_thresh = current_config.rx_full_thresh,
+        .rx_timeout_thresh = current_config.rx_timeout_symbols,
+        .txfifo_empty_intr_thresh = 10,
+    };
+    
+    esp_err_t ret = uart_intr_config(LUCIDUART_UART_NUM, &intr_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to configure UART interrupts: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    ESP_LOGI(TAG, "RX interrupts: full at %u bytes, timeout %u symbols",
+             current_config.rx_full_thresh, current_config.rx_timeout_symbols);
+    return ESP_OK;
+}
+
+/**
+ * @brief Feed one sample into a rate meter
+ * 
+ * Smoothing factors come from the actual sample interval, so a late
+ * sample is weighted correctly rather than assumed to be one second.
+ */
+static void rate_meter_sample(rate_meter_t* meter, uint64_t total, float dt) {
+    float rate = (float)(total - meter->mark) / dt;
+    meter->mark = total;
+    
+    meter->ewma_1s += (1.0f - expf(-dt / 1.0f)) * (rate - meter->ewma_1s);
+    meter->ewma_10s += (1.0f - expf(-dt / 10.0f)) * (rate - meter->ewma_10s);
+    meter->ewma_60s += (1.0f - expf(-dt / 60.0f)) * (rate - meter->ewma_60s);
+    if (rate > meter->peak_1s) {
+        meter->peak_1s = rate;
+    }
+}
+
+static void rate_meter_export(const rate_meter_t* meter, uart_bridge_rate_t* rate) {
+    rate->rate_1s = (uint32_t)(meter->ewma_1s + 0.5f);
+    rate->rate_10s = (uint32_t)(meter->ewma_10s + 0.5f);
+    rate->rate_60s = (uint32_t)(meter->ewma_60s + 0.5f);
+    rate->peak_1s = (uint32_t)(meter->peak_1s + 0.5f);
+}
+
+/**
+ * @brief Sample rate meters, events/s and uptime once per second
+ */
+static void stats_sample(void) {
+    int64_t now = esp_timer_get_time();
+    int64_t elapsed = now - stats_sample_stamp;
+    if (elapsed < 1000000) {
+        return;
+    }
+    
+    portENTER_CRITICAL();
+    uint64_t rx_total = bridge_stats.rx_bytes;
+    uint64_t tx_total = bridge_stats.tx_bytes;
+    uint32_t events_total = bridge_stats.rx_events;
+    portEXIT_CRITICAL();
+    
+    uint32_t events = events_total - stats_sample_events;
+    uint32_t bytes = rx_total - rx_meter.mark;
+    float dt = elapsed / 1000000.0f;
+    rate_meter_sample(&rx_meter, rx_total, dt);
+    rate_meter_sample(&tx_meter, tx_total, dt);
+    
+    portENTER_CRITICAL();
+    bridge_stats.rx_events_per_sec = (uint64_t)events * 1000000 / elapsed;
+    bridge_stats.rx_bytes_per_event = events ? bytes / events : 0;
+    bridge_stats.bridge_uptime = (now - stats_epoch) / 1000000;
+    rate_meter_export(&rx_meter, &bridge_stats.rx_rate);
+    rate_meter_export(&tx_meter, &bridge_stats.tx_rate);
+    portEXIT_CRITICAL();
+    
+    stats_sample_stamp = now;
+    stats_sample_events = events_total;
+}
+
+/**
+ * @brief Reset counters, meters and the uptime epoch
+ */
+static void stats_reset(void) {
+    portENTER_CRITICAL();
+    uint32_t baud = bridge_stats.current_baud;
+    bool active = bridge_stats.bridge_active;
+    memset(&bridge_stats, 0, sizeof(bridge_stats));
+    bridge_stats.current_baud = baud;
+    bridge_stats.bridge_active = active;
+    
+    // Throttle time restarts from now if flow control is holding either side
+    int64_t now = esp_timer_get_time();
+    flow_rx_throttled_us = 0;
+    flow_tx_paused_us = 0;
+    flow_rx_since = now;
+    flow_tx_since = now;
+    portEXIT_CRITICAL();
+    
+    memset(&rx_meter, 0, sizeof(rx_meter));
+    memset(&tx_meter, 0, sizeof(tx_meter));
+    stats_epoch = now;
+    stats_sample_stamp = stats_epoch;
+    stats_sample_events = 0;
+}
+
+/**
+ * @brief Move everything buffered in the driver into the RX ring
+ */
+static void rx_drain_driver(int64_t event_time) {
+    size_t buffered_size = 0;
+    uart_get_buffered_data_len(LUCIDUART_UART_NUM, &buffered_size);
+    while (buffered_size > 0) {
+        // A read may stop at the ring end, so loop to wrap
+        int bytes_read = rx_ring_fill(buffered_size, event_time);
+        if (bytes_read <= 0) {
+            break;
+        }
+        
+        STATS_ADD(rx_bytes, bytes_read);
+        buffered_size -= bytes_read;
+        
+        ESP_LOGD(TAG, "UART RX: %d bytes", bytes_read);
+    }
+}
+
+/**
+ * @brief Apply a configuration to the driver
+ * 
+ * Bytes already handed to the driver for TX leave at the old settings
+ * and everything received so far is moved into the RX ring first, so a
+ * switch loses nothing; the hardware FIFO keeps receiving meanwhile.
+ * The driver stays installed: its event queue is sized for
+ * LUCIDUART_IRQ_MIN_FULL, the lowest FIFO threshold uart_irq_resolve()
+ * lets through, so a change only reprograms the divider, the frame
+ * format and the interrupt thresholds, and a baud-only change skips the
+ * frame format.
+ * Runs on the UART task while the bridge is active, so nothing reads
+ * the driver concurrently.
+ */
+static esp_err_t uart_apply_config(const uart_bridge_config_t* config) {
+    uart_bridge_config_t next = *config;
+    uart_irq_resolve(&next);
+    bool same_format = next.data_bits == current_config.data_bits &&
+                       next.parity == current_config.parity &&
+                       next.stop_bits == current_config.stop_bits;
+    
+    xSemaphoreTake(tx_write_mutex, portMAX_DELAY);
+    uart_wait_tx_done(LUCIDUART_UART_NUM, pdMS_TO_TICKS(LUCIDUART_RECONFIG_TX_WAIT_MS));
+    rx_drain_driver(esp_timer_get_time());
+    
+    // Time only the window in which RX is not being serviced
+    int64_t start = esp_timer_get_time();
+    current_config = next;
+    bridge_stats.current_baud = next.baud_rate;
+    
+    esp_err_t ret;
+    if (same_format) {
+        ret = uart_set_baudrate(LUCIDUART_UART_NUM, current_config.baud_rate);
+    } else {
+        // Apply new UART parameters (ESP8266 compatible)
+        uart_config_t uart_config = {
+            .baud_rate = current_config.baud_rate,
+            .data_bits = current_config.data_bits,
+            .parity = current_config.parity,
+            .stop_bits = current_config.stop_bits,
+            .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+            // Note: source_clk not available in ESP8266 SDK
+        };
+        ret = uart_param_config(LUCIDUART_UART_NUM, &uart_config);
+    }
+    if (ret == ESP_OK) {
+        ret = uart_apply_intr_config();
+    }
+    
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+    xSemaphoreGive(tx_write_mutex);
+    
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to update UART config: %s", esp_err_to_name(ret));
+    }
+    
+    portENTER_CRITICAL();
+    bridge_stats.reconfigs++;
+    bridge_stats.reconfig_last_us = elapsed;
+    if (elapsed > bridge_stats.reconfig_max_us) {
+        bridge_stats.reconfig_max_us = elapsed;
+    }
+    portEXIT_CRITICAL();
+    
+    // Switching flow control off releases both directions
+    if (!current_config.xonxoff_enabled) {
+        flow_tx_set(false);
+    }
+    flow_rx_update();
+    return ret;
+}
+
+/**
+ * @brief Hand a stop or reconfiguration request to the UART task and wait
+ * 
+ * The task acknowledges with a task notification once the request has
+ * been applied (or, for a stop, once it has left the driver), so no
+ * caller has to sleep and hope. Notifications meant for the caller's
+ * own loop that arrive meanwhile are handed back afterwards.
+ * On timeout the request is withdrawn if the task has not picked it up
+ * yet; if it has, the caller waits for it to finish, so the shared
+ * request is never reused while the task is still applying it.
+ */
+static esp_err_t bridge_ctrl_request(bridge_ctrl_op_t op, const uart_bridge_config_t* config) {
+    xSemaphoreTake(ctrl_mutex, portMAX_DELAY);
+    ctrl_op = op;
+    if (config) {
+        ctrl_config = *config;
+    }
+    ctrl_waiter = xTaskGetCurrentTaskHandle();
+    ctrl_done = false;
+    ctrl_pending = true;
+    
+    // Ahead of queued data events: the task drains the driver buffer itself
+    uart_event_t event = { .type = BRIDGE_CTRL_EVENT };
+    TickType_t timeout = pdMS_TO_TICKS(LUCIDUART_RECONFIG_TIMEOUT_MS);
+    TickType_t start = xTaskGetTickCount();
+    xQueueSendToFront(uart_event_queue, &event, timeout);
+    
+    uint32_t stray = 0;
+    TickType_t waited;
+    while (!ctrl_done && (waited = xTaskGetTickCount() - start) < timeout) {
+        if (ulTaskNotifyTake(pdTRUE, timeout - waited) && !ctrl_done) {
+            stray++;
+        }
+    }
+    
+    portENTER_CRITICAL();
+    bool taken = !ctrl_pending;
+    ctrl_pending = false;
+    portEXIT_CRITICAL();
+    
+    // Picked up late: the task is applying it and will finish
+    while (taken && !ctrl_done) {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)) && !ctrl_done) {
+            stray++;
+        }
+    }
+    if (stray) {
+        xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+    }
+    
+    esp_err_t ret = ctrl_done ? ctrl_result : ESP_ERR_TIMEOUT;
+    xSemaphoreGive(ctrl_mutex);
+    return ret;
+}
+
+/**
+ * @brief Serve a pending control request on the UART task
+ */
+static void bridge_ctrl_handle(void) {
+    // Taken atomically so a requester that timed out cannot withdraw it
+    portENTER_CRITICAL();
+    bool taken = ctrl_pending;
+    ctrl_pending = false;
+    portEXIT_CRITICAL();
+    if (!taken) {
+        return;
+    }
+    
+    if (ctrl_op == BRIDGE_CTRL_STOP) {
+        // Keep what arrived up to now; acknowledged once the loop exits
+        rx_drain_driver(esp_timer_get_time());
+        bridge_active = false;
+        return;
+    }
+    
+    ctrl_result = uart_apply_config(&ctrl_config);
+    
+    // A sweep locked here: what it heard at this rate goes out first
+    if (autobaud_best_len && current_config.baud_rate == autobaud_publish_baud) {
+        rx_ring_publish(autobaud_keep + AUTOBAUD_KEEP_SIZE, autobaud_best_len,
+                        esp_timer_get_time());
+        autobaud_best_len = 0;
+    }
+    ctrl_done = true;
+    xTaskNotifyGive(ctrl_waiter);
+}
 
 /**
  * @brief UART event handling task
@@ -37,53 +882,38 @@ static uint8_t rx_buffer[LUCIDUART_RX_BUF_SIZE];
  */
 static void uart_event_task(void* pvParameters) {
     uart_event_t event;
-    size_t buffered_size;
     
     ESP_LOGI(TAG, "UART event task started");
-    bridge_stats.bridge_uptime = 0;
     
     while (bridge_active) {
         // Wait for UART event
         if (xQueueReceive(uart_event_queue, (void*)&event, pdMS_TO_TICKS(100))) {
+            // Taken at event time so line stamps don't include our own latency
+            int64_t event_time = esp_timer_get_time();
+            
             switch (event.type) {
                 case UART_DATA:
                     // Data received from UART - forward to network clients
-                    uart_get_buffered_data_len(LUCIDUART_UART_NUM, &buffered_size);
-                    if (buffered_size > 0) {
-                        size_t bytes_to_read = (buffered_size < sizeof(rx_buffer)) ? 
-                                               buffered_size : sizeof(rx_buffer);
-                        
-                        int bytes_read = uart_read_bytes(LUCIDUART_UART_NUM, rx_buffer, 
-                                                        bytes_to_read, pdMS_TO_TICKS(100));
-                        
-                        if (bytes_read > 0) {
-                            bridge_stats.rx_bytes += bytes_read;
-                            
-                            // Forward to network clients via callback
-                            if (rx_data_callback) {
-                                rx_data_callback(rx_buffer, bytes_read);
-                            }
-                            
-                            ESP_LOGD(TAG, "UART RX: %d bytes (total: %u)", 
-                                    bytes_read, bridge_stats.rx_bytes);
-                        }
-                    }
+                    STATS_ADD(rx_events, 1);
+                    rx_drain_driver(event_time);
                     break;
                     
                 case UART_FIFO_OVF:
                     ESP_LOGW(TAG, "UART FIFO overflow");
-                    bridge_stats.rx_errors++;
+                    STATS_ADD(rx_fifo_overflows, 1);
+                    STATS_ADD(rx_errors, 1);
                     uart_flush_input(LUCIDUART_UART_NUM);
                     xQueueReset(uart_event_queue);
                     break;
                     
                 case UART_BUFFER_FULL:
                     ESP_LOGW(TAG, "UART ring buffer full");
-                    bridge_stats.rx_errors++;
+                    STATS_ADD(rx_buffer_full, 1);
+                    STATS_ADD(rx_errors, 1);
                     uart_flush_input(LUCIDUART_UART_NUM);
                     xQueueReset(uart_event_queue);
                     break;
-                    
+                
                 // Note: UART_BREAK not available in ESP8266 SDK
                 // case UART_BREAK:
                 //     ESP_LOGD(TAG, "UART break detected");
@@ -91,32 +921,219 @@ static void uart_event_task(void* pvParameters) {
                     
                 case UART_PARITY_ERR:
                     ESP_LOGW(TAG, "UART parity error");
-                    bridge_stats.rx_errors++;
+                    STATS_ADD(rx_parity_errors, 1);
+                    STATS_ADD(rx_errors, 1);
                     break;
                     
                 case UART_FRAME_ERR:
                     ESP_LOGW(TAG, "UART frame error");
-                    bridge_stats.rx_errors++;
+                    STATS_ADD(rx_frame_errors, 1);
+                    STATS_ADD(rx_errors, 1);
+                    break;
+                    
+                case BRIDGE_CTRL_EVENT:
+                    // Wakeup only; the request is picked up below
                     break;
                     
                 default:
-                    ESP_LOGD(TAG, "UART event: %d", event.type);
+                    ESP_LOGD(TAG, "UART event: %d", (int)event.type);
                     break;
             }
         }
         
-        // Update uptime counter
-        static uint32_t uptime_counter = 0;
-        if (++uptime_counter >= 10) {  // Every ~1 second (100ms * 10)
-            bridge_stats.bridge_uptime++;
-            uptime_counter = 0;
+        // Checked every pass, so a request survives a queue reset
+        if (ctrl_pending) {
+            bridge_ctrl_handle();
         }
+        
+        // Queue timeout bounds this to ~100 ms late
+        stats_sample();
+        flow_rx_update();
     }
     
     ESP_LOGI(TAG, "UART event task ended");
+    
+    // Out of the driver; uart_bridge_stop() may return now
+    if (ctrl_op == BRIDGE_CTRL_STOP && !ctrl_done) {
+        ctrl_result = ESP_OK;
+        ctrl_done = true;
+        xTaskNotifyGive(ctrl_waiter);
+    }
     vTaskDelete(NULL);
 }
 
+/**
+ * @brief Drain the TX backlog estimate by the time elapsed at line rate
+ */
+static void tx_backlog_update(void) {
+    int64_t now = esp_timer_get_time();
+    // ~10 bits per character on the wire
+    uint64_t drained = (uint64_t)(now - tx_backlog_stamp) * current_config.baud_rate / 10000000ULL;
+    
+    if (drained > 0) {
+        tx_backlog = (drained >= tx_backlog) ? 0 : tx_backlog - (uint32_t)drained;
+        tx_backlog_stamp = now;
+    }
+}
+
+/**
+ * @brief Write a pending XON/XOFF ahead of queued data
+ */
+static void flow_send_pending(void) {
+    portENTER_CRITICAL();
+    uint8_t c = flow_pending;
+    flow_pending = 0;
+    portEXIT_CRITICAL();
+    
+    if (c) {
+        xSemaphoreTake(tx_write_mutex, portMAX_DELAY);
+        uart_write_bytes(LUCIDUART_UART_NUM, (const char*)&c, 1);
+        xSemaphoreGive(tx_write_mutex);
+    }
+}
+
+/**
+ * @brief Hold the TX task while the target has sent XOFF
+ * 
+ * Returns early if flow control is switched off, the bridge stops or
+ * the message is purged, so a target that never sends XON cannot wedge
+ * the queue for good.
+ */
+static void flow_tx_wait(uint32_t generation) {
+    while (flow_tx_paused && current_config.xonxoff_enabled &&
+           bridge_active && generation == tx_generation) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        // Our own XON/XOFF still goes out while paused
+        flow_send_pending();
+    }
+}
+
+/**
+ * @brief Hold the TX task while auto-baud detection sweeps
+ * 
+ * Bytes written at a probe rate would reach the target as garbage.
+ */
+static void autobaud_tx_wait(uint32_t generation) {
+    while (autobaud_sweeping && bridge_active && generation == tx_generation) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+    }
+}
+
+/**
+ * @brief UART TX task
+ * 
+ * Writes queued messages to the driver one at a time, so a slow line
+ * only ever blocks this task. Messages queued before a TX purge, or
+ * while the bridge is stopped, are completed without being written.
+ * Writes are split into LUCIDUART_TX_CHUNK pieces so XON/XOFF in either
+ * direction takes effect within one chunk.
+ */
+static void uart_tx_task(void* pvParameters) {
+    tx_msg_t msg;
+    
+    while (1) {
+        if (xQueueReceive(tx_queue, &msg, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        
+        flow_send_pending();
+        if (msg.length == 0) {
+            // Flow-control wakeup only
+            continue;
+        }
+        
+        esp_err_t result = ESP_ERR_INVALID_STATE;
+        size_t written = 0;
+        
+        while (written < msg.length) {
+            autobaud_tx_wait(msg.generation);
+            flow_tx_wait(msg.generation);
+            if (!bridge_active || msg.generation != tx_generation) {
+                break;
+            }
+            
+            uint32_t index = (msg.offset + written) & (LUCIDUART_TX_QUEUE_BYTES - 1);
+            size_t chunk = msg.length - written;
+            if (chunk > LUCIDUART_TX_QUEUE_BYTES - index) {
+                chunk = LUCIDUART_TX_QUEUE_BYTES - index;
+            }
+            if (chunk > LUCIDUART_TX_CHUNK) {
+                chunk = LUCIDUART_TX_CHUNK;
+            }
+            
+            xSemaphoreTake(tx_write_mutex, portMAX_DELAY);
+            int sent = uart_write_bytes(LUCIDUART_UART_NUM, (const char*)&tx_arena[index], chunk);
+            xSemaphoreGive(tx_write_mutex);
+            if (sent <= 0) {
+                result = ESP_FAIL;
+                break;
+            }
+            written += sent;
+            
+            flow_send_pending();
+        }
+        if (written == msg.length) {
+            result = ESP_OK;
+        }
+        
+        portENTER_CRITICAL();
+        if (written > 0) {
+            tx_backlog_update();
+            tx_backlog += written;
+            bridge_stats.tx_bytes += written;
+        }
+        // Release the arena space before waking blocked submitters
+        tx_arena_tail = msg.offset + msg.length;
+        portEXIT_CRITICAL();
+        xSemaphoreGive(tx_space_sem);
+        
+        if (result == ESP_FAIL) {
+            STATS_ADD(tx_errors, 1);
+            ESP_LOGW(TAG, "UART TX failed");
+        }
+        
+        if (msg.done) {
+            msg.done(msg.ctx, result, written);
+        }
+    }
+}
+
+/**
+ * @brief Create the TX queue and its task (kept across deinit/init cycles)
+ */
+static esp_err_t tx_queue_create(void) {
+    if (uart_tx_task_handle) {
+        return ESP_OK;
+    }
+    
+    if (!tx_queue) {
+        tx_queue = xQueueCreate(LUCIDUART_TX_QUEUE_DEPTH, sizeof(tx_msg_t));
+    }
+    if (!tx_submit_mutex) {
+        tx_submit_mutex = xSemaphoreCreateMutex();
+    }
+    if (!tx_write_mutex) {
+        tx_write_mutex = xSemaphoreCreateMutex();
+    }
+    if (!tx_space_sem) {
+        tx_space_sem = xSemaphoreCreateBinary();
+    }
+    if (!tx_queue || !tx_submit_mutex || !tx_write_mutex || !tx_space_sem) {
+        ESP_LOGE(TAG, "Failed to create TX queue");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (xTaskCreate(uart_tx_task, "uart_tx_task",
+                    LUCIDUART_TX_TASK_STACK,
+                    NULL,
+                    LUCIDUART_TX_TASK_PRIORITY,
+                    &uart_tx_task_handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create UART TX task");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
 esp_err_t uart_bridge_init(const uart_bridge_config_t* config) {
     if (bridge_initialized) {
         ESP_LOGW(TAG, "UART bridge already initialized");
@@ -125,6 +1142,28 @@ esp_err_t uart_bridge_init(const uart_bridge_config_t* config) {
     
     // Initialize UART bridge
     
+    // Consumer wakeup bits (kept across deinit/init cycles)
+    if (!rx_consumer_events) {
+        rx_consumer_events = xEventGroupCreate();
+        if (!rx_consumer_events) {
+            ESP_LOGE(TAG, "Failed to create consumer event group");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    if (!ctrl_mutex) {
+        ctrl_mutex = xSemaphoreCreateMutex();
+        if (!ctrl_mutex) {
+            ESP_LOGE(TAG, "Failed to create control mutex");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    esp_err_t ret = tx_queue_create();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
     // Set default configuration if none provided
     if (config) {
         current_config = *config;
@@ -135,9 +1174,11 @@ esp_err_t uart_bridge_init(const uart_bridge_config_t* config) {
             .parity = UART_PARITY_DISABLE,
             .stop_bits = UART_STOP_BITS_1,
             .echo_enabled = false,
-            .timestamp_enabled = false
+            .timestamp_enabled = false,
+            .irq_profile = UART_BRIDGE_IRQ_AUTO,
         };
     }
+    uart_irq_resolve(&current_config);
     
     // UART configuration (ESP8266 compatible)
     uart_config_t uart_config = {
@@ -150,7 +1191,7 @@ esp_err_t uart_bridge_init(const uart_bridge_config_t* config) {
     };
     
     // Install UART driver
-    esp_err_t ret = uart_driver_install(LUCIDUART_UART_NUM, 
+    ret = uart_driver_install(LUCIDUART_UART_NUM, 
                                         LUCIDUART_RX_BUF_SIZE, 
                                         LUCIDUART_TX_BUF_SIZE, 
                                         LUCIDUART_QUEUE_SIZE, 
@@ -168,11 +1209,17 @@ esp_err_t uart_bridge_init(const uart_bridge_config_t* config) {
         return ret;
     }
     
+    ret = uart_apply_intr_config();
+    if (ret != ESP_OK) {
+        uart_driver_delete(LUCIDUART_UART_NUM);
+        return ret;
+    }
+    
     // Note: ESP8266 UART0 pins are fixed (GPIO1=TX, GPIO3=RX)
     // uart_set_pin() is not available in ESP8266 SDK
     
     // Reset statistics
-    memset(&bridge_stats, 0, sizeof(bridge_stats));
+    stats_reset();
     bridge_stats.current_baud = current_config.baud_rate;
     
     bridge_initialized = true;
@@ -223,17 +1270,19 @@ esp_err_t uart_bridge_stop(void) {
         return ESP_OK;
     }
     
-    // Stop UART bridge
+    // Stop UART bridge; the task drains pending RX and exits before we return
+    esp_err_t ret = ESP_OK;
+    if (uart_rx_task_handle && xTaskGetCurrentTaskHandle() != uart_rx_task_handle) {
+        ret = bridge_ctrl_request(BRIDGE_CTRL_STOP, NULL);
+    }
     
     bridge_active = false;
     bridge_stats.bridge_active = false;
+    uart_rx_task_handle = NULL;
     
-    // Wait for task to terminate
-    if (uart_rx_task_handle) {
-        // Task will self-delete when bridge_active becomes false
-        uart_rx_task_handle = NULL;
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "UART task did not acknowledge stop: %s", esp_err_to_name(ret));
     }
-    
     ESP_LOGI(TAG, "UART bridge stopped");
     return ESP_OK;
 }
@@ -249,8 +1298,10 @@ esp_err_t uart_bridge_deinit(void) {
     
     // Deinitialize UART bridge
     
-    // Delete UART driver
+    // Delete UART driver (not while the TX task is writing to it)
+    xSemaphoreTake(tx_write_mutex, portMAX_DELAY);
     esp_err_t ret = uart_driver_delete(LUCIDUART_UART_NUM);
+    xSemaphoreGive(tx_write_mutex);
     if (ret != ESP_OK) {
         ESP_LOGW(TAG, "Failed to delete UART driver: %s", esp_err_to_name(ret));
     }
@@ -264,20 +1315,97 @@ esp_err_t uart_bridge_deinit(void) {
 }
 
 int uart_bridge_send(const uint8_t* data, size_t length) {
-    if (!bridge_active || !data || length == 0) {
+    if (!data || length == 0) {
         return -1;
     }
     
-    int bytes_sent = uart_write_bytes(LUCIDUART_UART_NUM, (const char*)data, length);
-    if (bytes_sent > 0) {
-        bridge_stats.tx_bytes += bytes_sent;
-        ESP_LOGD(TAG, "UART TX: %d bytes (total: %u)", bytes_sent, bridge_stats.tx_bytes);
-    } else {
-        bridge_stats.tx_errors++;
-        ESP_LOGW(TAG, "UART TX failed");
+    size_t queued = 0;
+    while (queued < length) {
+        size_t chunk = length - queued;
+        if (chunk > LUCIDUART_TX_QUEUE_BYTES) {
+            chunk = LUCIDUART_TX_QUEUE_BYTES;
+        }
+        if (uart_bridge_tx_submit(data + queued, chunk, portMAX_DELAY, NULL, NULL) != ESP_OK) {
+            break;
+        }
+        queued += chunk;
+    }
+    
+    return queued > 0 ? (int)queued : -1;
+}
+
+esp_err_t uart_bridge_tx_submit(const uint8_t* data, size_t length, TickType_t wait,
+                                uart_bridge_tx_done_t done, void* ctx) {
+    if (!data || length == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (length > LUCIDUART_TX_QUEUE_BYTES) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (!bridge_active || !tx_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // One submitter at a time keeps arena order and descriptor order equal
+    TickType_t start = xTaskGetTickCount();
+    if (xSemaphoreTake(tx_submit_mutex, wait) != pdTRUE) {
+        STATS_ADD(tx_queue_full, 1);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    while (tx_arena_head - tx_arena_tail + length > LUCIDUART_TX_QUEUE_BYTES ||
+           uxQueueSpacesAvailable(tx_queue) == 0) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= wait) {
+            xSemaphoreGive(tx_submit_mutex);
+            STATS_ADD(tx_queue_full, 1);
+            return ESP_ERR_NO_MEM;
+        }
+        xSemaphoreTake(tx_space_sem, (wait == portMAX_DELAY) ? portMAX_DELAY : wait - elapsed);
+    }
+    
+    uint32_t index = tx_arena_head & (LUCIDUART_TX_QUEUE_BYTES - 1);
+    size_t first = LUCIDUART_TX_QUEUE_BYTES - index;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(&tx_arena[index], data, first);
+    memcpy(tx_arena, data + first, length - first);
+    
+    tx_msg_t msg = {
+        .offset = tx_arena_head,
+        .length = length,
+        .generation = tx_generation,
+        .done = done,
+        .ctx = ctx,
+    };
+    tx_arena_head += length;
+    xQueueSend(tx_queue, &msg, 0);
+    xSemaphoreGive(tx_submit_mutex);
+    
+    STATS_ADD(tx_messages, 1);
+    ESP_LOGD(TAG, "UART TX queued: %u bytes", (unsigned)length);
+    return ESP_OK;
+}
+
+esp_err_t uart_bridge_tx_flush(TickType_t timeout) {
+    if (!tx_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    TickType_t start = xTaskGetTickCount();
+    while (tx_arena_tail != tx_arena_head) {
+        if (xTaskGetTickCount() - start >= timeout) {
+            return ESP_ERR_TIMEOUT;
+        }
+        vTaskDelay(1);
     }
     
-    return bytes_sent;
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    if (elapsed >= timeout) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return uart_wait_tx_done(LUCIDUART_UART_NUM, timeout - elapsed);
 }
 
 esp_err_t uart_bridge_set_rx_callback(void (*callback)(const uint8_t* data, size_t length)) {
@@ -286,21 +1414,335 @@ esp_err_t uart_bridge_set_rx_callback(void (*callback)(const uint8_t* data, size
     return ESP_OK;
 }
 
+esp_err_t uart_bridge_consumer_open(const char* name, uart_bridge_consumer_t* consumer) {
+    if (!consumer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int slot = -1;
+    portENTER_CRITICAL();
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        if (!rx_consumers[i].in_use) {
+            rx_consumers[i] = (rx_consumer_t){
+                .in_use = true,
+                .name = name ? name : "anon",
+                .read_offset = rx_ring_head,
+                .flush_end = rx_ring_head,
+            };
+            rx_consumer_mask |= (EventBits_t)1 << i;
+            slot = i;
+            break;
+        }
+    }
+    portEXIT_CRITICAL();
+    
+    if (slot < 0) {
+        ESP_LOGW(TAG, "No free RX consumer slot for %s", name ? name : "anon");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (rx_consumer_events) {
+        xEventGroupClearBits(rx_consumer_events, (EventBits_t)1 << slot);
+    }
+    
+    *consumer = slot;
+    ESP_LOGI(TAG, "RX consumer %d opened (%s)", slot, rx_consumers[slot].name);
+    return ESP_OK;
+}
+
+esp_err_t uart_bridge_consumer_close(uart_bridge_consumer_t consumer) {
+    if (consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS || !rx_consumers[consumer].in_use) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    portENTER_CRITICAL();
+    rx_consumers[consumer].in_use = false;
+    rx_consumer_mask &= ~((EventBits_t)1 << consumer);
+    portEXIT_CRITICAL();
+    
+    const rx_consumer_t* c = &rx_consumers[consumer];
+    ESP_LOGI(TAG, "RX consumer %d closed (%s, overruns: %u, avg batch: %u bytes)", consumer,
+             c->name, c->overruns, c->batches ? c->batched_bytes / c->batches : 0);
+    
+    // The closed cursor may have been the one holding the target off
+    if (flow_rx_throttled) {
+        flow_rx_update();
+    }
+    return ESP_OK;
+}
+
+size_t uart_bridge_consumer_peek(uart_bridge_consumer_t consumer, const uint8_t** data) {
+    if (consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS || !data) {
+        return 0;
+    }
+    
+    rx_consumer_t* c = &rx_consumers[consumer];
+    if (!c->in_use) {
+        return 0;
+    }
+    
+    rx_consumer_resync(c);
+    
+    uint32_t head = rx_ring_head;
+    size_t available = head - c->read_offset;
+    size_t index = c->read_offset & LUCIDUART_RX_RING_MASK;
+    size_t contiguous = LUCIDUART_RX_RING_SIZE - index;
+    
+    *data = &rx_ring[index];
+    return (available < contiguous) ? available : contiguous;
+}
+
+esp_err_t uart_bridge_consumer_advance(uart_bridge_consumer_t consumer, size_t length) {
+    if (consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS || !rx_consumers[consumer].in_use) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    rx_consumer_t* c = &rx_consumers[consumer];
+    
+    // The writer may have lapped us while the slice was being read
+    if (rx_consumer_resync(c)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    uint32_t available = rx_ring_head - c->read_offset;
+    c->read_offset += (length < available) ? length : available;
+    
+    if (flow_rx_throttled) {
+        flow_rx_update();
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_bridge_consumer_seek(uart_bridge_consumer_t consumer, uint32_t offset) {
+    if (consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS || !rx_consumers[consumer].in_use) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    rx_consumer_t* c = &rx_consumers[consumer];
+    uint32_t head = rx_ring_head;
+    // Nothing older than offset 0 exists before the ring has filled once
+    uint32_t oldest = rx_ring_filled ? rx_ring_reserve - LUCIDUART_RX_RING_SIZE : 0;
+    
+    if ((int32_t)(offset - head) > 0) {
+        c->read_offset = head;
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if ((int32_t)(offset - oldest) < 0) {
+        c->read_offset = oldest;
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    c->read_offset = offset;
+    return ESP_OK;
+}
+
+uint32_t uart_bridge_get_rx_offset(void) {
+    return rx_ring_head;
+}
+
+esp_err_t uart_bridge_consumer_set_coalesce(uart_bridge_consumer_t consumer,
+                                            uint32_t min_bytes, uint32_t max_delay_us) {
+    if (consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS || !rx_consumers[consumer].in_use) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // A threshold the ring can never hold would only ever flush on the deadline
+    if (min_bytes > LUCIDUART_RX_RING_SIZE / 2) {
+        min_bytes = LUCIDUART_RX_RING_SIZE / 2;
+    }
+    
+    rx_consumers[consumer].coalesce_bytes = min_bytes;
+    rx_consumers[consumer].coalesce_us = max_delay_us;
+    return ESP_OK;
+}
+
+bool uart_bridge_consumer_ready(uart_bridge_consumer_t consumer) {
+    if (consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS || !rx_consumers[consumer].in_use) {
+        return false;
+    }
+    
+    TickType_t wait_ticks;
+    return rx_consumer_ready(&rx_consumers[consumer], &wait_ticks);
+}
+
+bool uart_bridge_consumer_wait(uart_bridge_consumer_t consumer, TickType_t timeout) {
+    return uart_bridge_consumer_wait_any(&consumer, 1, timeout);
+}
+
+bool uart_bridge_consumer_wait_any(const uart_bridge_consumer_t* consumers, size_t count,
+                                   TickType_t timeout) {
+    if (!consumers || count == 0) {
+        return false;
+    }
+    
+    EventBits_t bits = 0;
+    for (size_t i = 0; i < count; i++) {
+        uart_bridge_consumer_t id = consumers[i];
+        if (id >= 0 && id < LUCIDUART_MAX_CONSUMERS && rx_consumers[id].in_use) {
+            bits |= (EventBits_t)1 << id;
+        }
+    }
+    if (!bits) {
+        return false;
+    }
+    
+    TickType_t start = xTaskGetTickCount();
+    while (1) {
+        // Clear before checking so a write between check and wait is not missed
+        xEventGroupClearBits(rx_consumer_events, bits);
+        
+        TickType_t wait_ticks = portMAX_DELAY;
+        for (size_t i = 0; i < count; i++) {
+            uart_bridge_consumer_t id = consumers[i];
+            if (!(bits & ((EventBits_t)1 << id))) {
+                continue;
+            }
+            TickType_t deadline;
+            if (rx_consumer_ready(&rx_consumers[id], &deadline)) {
+                return true;
+            }
+            if (deadline < wait_ticks) {
+                wait_ticks = deadline;
+            }
+        }
+        
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout) {
+            return false;
+        }
+        if (timeout != portMAX_DELAY && timeout - elapsed < wait_ticks) {
+            wait_ticks = timeout - elapsed;
+        }
+        
+        xEventGroupWaitBits(rx_consumer_events, bits, pdTRUE, pdFALSE, wait_ticks);
+    }
+}
+
+size_t uart_bridge_get_line_stamps(uint32_t from, uint32_t to,
+                                   uart_bridge_line_stamp_t* stamps, size_t max) {
+    if (!stamps || max == 0) {
+        return 0;
+    }
+    
+    uint32_t head = rx_line_head;
+    uint32_t first = (head > LUCIDUART_RX_LINE_INDEX_SIZE) ? head - LUCIDUART_RX_LINE_INDEX_SIZE : 0;
+    
+    // Entries are in offset order; find the first one at or after from
+    uint32_t lo = first;
+    uint32_t hi = head;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if ((int32_t)(rx_lines[mid & LUCIDUART_RX_LINE_MASK].offset - from) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    
+    // Widen the stored low bits against the current time
+    int64_t now = esp_timer_get_time();
+    size_t count = 0;
+    for (uint32_t i = lo; i < head && count < max; i++) {
+        rx_stamp_t entry = rx_lines[i & LUCIDUART_RX_LINE_MASK];
+        if ((int32_t)(entry.offset - to) >= 0) {
+            break;
+        }
+        stamps[count].offset = entry.offset;
+        stamps[count].time_us = now - (uint32_t)((uint32_t)now - entry.time_lo);
+        count++;
+    }
+    
+    // Discard entries the UART task overwrote while we were copying
+    uint32_t oldest = rx_line_head - LUCIDUART_RX_LINE_INDEX_SIZE;
+    if (rx_line_head > LUCIDUART_RX_LINE_INDEX_SIZE && (int32_t)(oldest - lo) > 0) {
+        size_t stale = oldest - lo;
+        if (stale >= count) {
+            return 0;
+        }
+        memmove(stamps, stamps + stale, (count - stale) * sizeof(*stamps));
+        count -= stale;
+    }
+    
+    return count;
+}
+
+esp_err_t uart_bridge_get_arrival_time(uint32_t offset, int64_t* time_us) {
+    if (!time_us) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((int32_t)(offset - rx_ring_head) >= 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    // Newest fill starting at or before offset; fills are short, so scan back
+    uint32_t head = rx_chunk_head;
+    uint32_t first = (head > LUCIDUART_RX_CHUNK_INDEX_SIZE) ? head - LUCIDUART_RX_CHUNK_INDEX_SIZE : 0;
+    int64_t now = esp_timer_get_time();
+    for (uint32_t i = head; i > first; i--) {
+        rx_stamp_t entry = rx_chunks[(i - 1) & LUCIDUART_RX_CHUNK_MASK];
+        if ((int32_t)(offset - entry.offset) >= 0) {
+            // The oldest slot may have been overwritten while we scanned
+            if (i - 1 == first && rx_chunk_head != head) {
+                return ESP_ERR_NOT_FOUND;
+            }
+            *time_us = now - (uint32_t)((uint32_t)now - entry.time_lo);
+            return ESP_OK;
+        }
+    }
+    
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t uart_bridge_consumer_get_stats(uart_bridge_consumer_t consumer,
+                                         uart_bridge_consumer_stats_t* stats) {
+    if (!stats || consumer < 0 || consumer >= LUCIDUART_MAX_CONSUMERS ||
+        !rx_consumers[consumer].in_use) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const rx_consumer_t* c = &rx_consumers[consumer];
+    uint32_t pending = rx_ring_head - c->read_offset;
+    
+    stats->name = c->name;
+    stats->read_offset = c->read_offset;
+    stats->pending = (pending < LUCIDUART_RX_RING_SIZE) ? pending : LUCIDUART_RX_RING_SIZE;
+    stats->overruns = c->overruns;
+    stats->dropped_bytes = c->dropped_bytes;
+    stats->batches = c->batches;
+    stats->batched_bytes = c->batched_bytes;
+    stats->max_batch = c->max_batch;
+    return ESP_OK;
+}
+
 esp_err_t uart_bridge_get_stats(uart_bridge_stats_t* stats) {
     if (!stats) {
         return ESP_ERR_INVALID_ARG;
     }
     
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL();
     *stats = bridge_stats;
+    stats->tx_queued = tx_arena_head - tx_arena_tail;
+    stats->flow_rx_throttled = flow_rx_throttled;
+    stats->flow_tx_paused = flow_tx_paused;
+    int64_t rx_throttled_us = flow_rx_throttled_us + (flow_rx_throttled ? now - flow_rx_since : 0);
+    int64_t tx_paused_us = flow_tx_paused_us + (flow_tx_paused ? now - flow_tx_since : 0);
+    portEXIT_CRITICAL();
+    
+    stats->flow_rx_throttled_ms = (uint32_t)(rx_throttled_us / 1000);
+    stats->flow_tx_paused_ms = (uint32_t)(tx_paused_us / 1000);
+    
+    stats->active_consumers = 0;
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        if (rx_consumers[i].in_use) {
+            stats->active_consumers++;
+        }
+    }
     return ESP_OK;
 }
 
 esp_err_t uart_bridge_reset_stats(void) {
-    bridge_stats.rx_bytes = 0;
-    bridge_stats.tx_bytes = 0;
-    bridge_stats.rx_errors = 0;
-    bridge_stats.tx_errors = 0;
-    bridge_stats.bridge_uptime = 0;
+    stats_reset();
     
     ESP_LOGI(TAG, "Statistics reset");
     return ESP_OK;
@@ -310,44 +1752,256 @@ esp_err_t uart_bridge_update_config(const uart_bridge_config_t* config) {
     if (!config) {
         return ESP_ERR_INVALID_ARG;
     }
+    if (!bridge_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
     
     ESP_LOGI(TAG, "Updating UART configuration (baud: %u)", config->baud_rate);
     
-    bool was_active = bridge_active;
+    // Applied by the UART task between two reads while it is running
+    esp_err_t ret;
+    if (bridge_active && uart_rx_task_handle && xTaskGetCurrentTaskHandle() != uart_rx_task_handle) {
+        ret = bridge_ctrl_request(BRIDGE_CTRL_RECONFIG, config);
+    } else {
+        ret = uart_apply_config(config);
+    }
     
-    // Stop bridge if active
-    if (was_active) {
-        uart_bridge_stop();
-        vTaskDelay(pdMS_TO_TICKS(100)); // Allow task to terminate
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "UART configuration updated (%u us)", bridge_stats.reconfig_last_us);
+    }
+    return ret;
+}
+
+esp_err_t uart_bridge_get_config(uart_bridge_config_t* config) {
+    if (!config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *config = current_config;
+    return ESP_OK;
+}
+
+esp_err_t uart_bridge_purge(bool rx, bool tx) {
+    if (!bridge_initialized) {
+        return ESP_ERR_INVALID_STATE;
     }
     
-    // Update configuration
-    current_config = *config;
-    bridge_stats.current_baud = config->baud_rate;
+    if (rx) {
+        uart_flush_input(LUCIDUART_UART_NUM);
+    }
+    if (tx) {
+        // The TX task completes stale messages without writing them
+        tx_generation++;
+    }
     
-    // Apply new UART parameters (ESP8266 compatible)
-    uart_config_t uart_config = {
-        .baud_rate = config->baud_rate,
-        .data_bits = config->data_bits,
-        .parity = config->parity,
-        .stop_bits = config->stop_bits,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
-        // Note: source_clk not available in ESP8266 SDK
+    ESP_LOGI(TAG, "Purged %s%s", rx ? "RX " : "", tx ? "TX" : "");
+    return ESP_OK;
+}
+
+uint32_t uart_bridge_get_tx_backlog(void) {
+    portENTER_CRITICAL();
+    tx_backlog_update();
+    uint32_t backlog = tx_backlog + (tx_arena_head - tx_arena_tail);
+    portEXIT_CRITICAL();
+    return backlog;
+}
+
+/**
+ * @brief Listen at one rate and score what arrives
+ * 
+ * A wrong rate turns text into high-bit garbage and framing errors. The
+ * driver reports one error event per burst, so each event is weighted
+ * like several bad bytes.
+ * 
+ * @return Score 0-100, or -1 if too few bytes arrived to judge
+ */
+static int autobaud_try_rate(uint32_t baud) {
+    uart_bridge_config_t config = current_config;
+    config.baud_rate = baud;
+    if (uart_bridge_update_config(&config) != ESP_OK) {
+        return -1;
+    }
+    autobaud_status.baud_rate = baud;
+    
+    // Drop what straddled the switch, unless it is being published
+    if (baud != autobaud_publish_baud) {
+        uart_flush_input(LUCIDUART_UART_NUM);
+    }
+    portENTER_CRITICAL();
+    autobaud_total = 0;
+    autobaud_printable_count = 0;
+    autobaud_probe_len = 0;
+    portEXIT_CRITICAL();
+    uint32_t errors_before = bridge_stats.rx_errors;
+    
+    vTaskDelay(pdMS_TO_TICKS(LUCIDUART_AUTOBAUD_WINDOW_MS));
+    
+    uint32_t errors = bridge_stats.rx_errors - errors_before;
+    portENTER_CRITICAL();
+    uint32_t total = autobaud_total;
+    uint32_t printable = autobaud_printable_count;
+    portEXIT_CRITICAL();
+    
+    if (total < LUCIDUART_AUTOBAUD_MIN_BYTES) {
+        return -1;
+    }
+    
+    int score = printable * 100 / (total + errors * 8);
+    ESP_LOGD(TAG, "Auto-baud %u: %u bytes, %u printable, %u errors, score %d",
+             baud, total, printable, errors, score);
+    return score;
+}
+
+/**
+ * @brief Auto-baud detection task
+ * 
+ * Sweeps all candidates each round and locks the best one, so a rate
+ * that merely happens to produce a few printable bytes does not win
+ * over the real one. Bytes at the original rate are published as they
+ * arrive; those at other rates only when their rate locks, limited to
+ * the first AUTOBAUD_KEEP_SIZE of the winning window.
+ */
+static void autobaud_task(void* pvParameters) {
+    uint32_t original_baud = autobaud_publish_baud;
+    
+    // Second half holds the best window of the round
+    autobaud_keep = malloc(2 * AUTOBAUD_KEEP_SIZE);
+    if (!autobaud_keep) {
+        ESP_LOGW(TAG, "No memory to keep probe windows, locking window is dropped");
+    }
+    ESP_LOGI(TAG, "Auto-baud detection started (%u candidates)", (unsigned)autobaud_rate_count);
+    
+    for (uint32_t round = 0; round < LUCIDUART_AUTOBAUD_MAX_ROUNDS && !autobaud_cancel; round++) {
+        int best_score = -1;
+        uint32_t best_baud = 0;
+        size_t best_len = 0;
+        
+        for (size_t i = 0; i < autobaud_rate_count && !autobaud_cancel; i++) {
+            int score = autobaud_try_rate(autobaud_rates[i]);
+            if (score > best_score) {
+                best_score = score;
+                best_baud = autobaud_rates[i];
+                
+                // Bytes below the snapshot stay put until the next probe
+                portENTER_CRITICAL();
+                best_len = (best_baud != original_baud) ? autobaud_probe_len : 0;
+                portEXIT_CRITICAL();
+                if (best_len) {
+                    memcpy(autobaud_keep + AUTOBAUD_KEEP_SIZE, autobaud_keep, best_len);
+                }
+            }
+        }
+        autobaud_status.rounds = round + 1;
+        
+        if (autobaud_cancel) {
+            break;
+        }
+        
+        if (best_score >= LUCIDUART_AUTOBAUD_LOCK_SCORE) {
+            // Published by the UART task as it applies the rate
+            autobaud_best_len = best_len;
+            autobaud_publish_baud = best_baud;
+            uart_bridge_config_t config = current_config;
+            config.baud_rate = best_baud;
+            uart_bridge_update_config(&config);
+            
+            autobaud_status.baud_rate = best_baud;
+            autobaud_status.score = best_score;
+            autobaud_status.state = UART_BRIDGE_AUTOBAUD_LOCKED;
+            ESP_LOGI(TAG, "Auto-baud locked at %u (score %d, round %u)",
+                     best_baud, best_score, round + 1);
+            break;
+        }
+        
+        if (best_score > autobaud_status.score) {
+            autobaud_status.score = best_score;
+        }
+    }
+    
+    if (autobaud_status.state == UART_BRIDGE_AUTOBAUD_RUNNING) {
+        uart_bridge_config_t config = current_config;
+        config.baud_rate = original_baud;
+        uart_bridge_update_config(&config);
+        autobaud_status.baud_rate = original_baud;
+        
+        if (autobaud_cancel) {
+            autobaud_status.state = UART_BRIDGE_AUTOBAUD_CANCELLED;
+            ESP_LOGI(TAG, "Auto-baud detection cancelled");
+        } else {
+            autobaud_status.state = UART_BRIDGE_AUTOBAUD_FAILED;
+            ESP_LOGW(TAG, "Auto-baud found no rate, staying at %u", original_baud);
+        }
+    }
+    
+    // The reconfiguration above moved the last probe's bytes into the score
+    autobaud_sweeping = false;
+    autobaud_best_len = 0;
+    free(autobaud_keep);
+    autobaud_keep = NULL;
+    if (uart_tx_task_handle) {
+        xTaskNotifyGive(uart_tx_task_handle);
+    }
+    autobaud_task_handle = NULL;
+    vTaskDelete(NULL);
+}
+
+esp_err_t uart_bridge_autobaud_start(const uint32_t* candidates, size_t count) {
+    if (!bridge_active || autobaud_task_handle) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!candidates) {
+        candidates = autobaud_default_rates;
+        count = sizeof(autobaud_default_rates) / sizeof(autobaud_default_rates[0]);
+    }
+    if (count == 0 || count > LUCIDUART_AUTOBAUD_MAX_CANDIDATES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    memcpy(autobaud_rates, candidates, count * sizeof(uint32_t));
+    autobaud_rate_count = count;
+    autobaud_cancel = false;
+    autobaud_status = (uart_bridge_autobaud_status_t){
+        .state = UART_BRIDGE_AUTOBAUD_RUNNING,
+        .baud_rate = current_config.baud_rate,
     };
+    autobaud_publish_baud = current_config.baud_rate;
+    autobaud_sweeping = true;
     
-    esp_err_t ret = uart_param_config(LUCIDUART_UART_NUM, &uart_config);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to update UART config: %s", esp_err_to_name(ret));
-        return ret;
+    BaseType_t task_created = xTaskCreate(autobaud_task, "autobaud",
+                                          LUCIDUART_AUTOBAUD_TASK_STACK, NULL,
+                                          LUCIDUART_AUTOBAUD_TASK_PRIORITY,
+                                          &autobaud_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create auto-baud task");
+        autobaud_status.state = UART_BRIDGE_AUTOBAUD_FAILED;
+        autobaud_sweeping = false;
+        return ESP_FAIL;
     }
     
-    // Restart bridge if it was active
-    if (was_active) {
-        ret = uart_bridge_start();
+    return ESP_OK;
+}
+
+esp_err_t uart_bridge_autobaud_cancel(void) {
+    if (!autobaud_task_handle) {
+        return ESP_OK;
     }
     
-    ESP_LOGI(TAG, "UART configuration updated");
-    return ret;
+    // Wait for the sweep to notice between candidates
+    autobaud_cancel = true;
+    while (autobaud_task_handle) {
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_bridge_autobaud_get_status(uart_bridge_autobaud_status_t* status) {
+    if (!status) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *status = autobaud_status;
+    return ESP_OK;
 }
 
 bool uart_bridge_is_active(void) {
@@ -375,9 +2029,15 @@ esp_err_t uart_bridge_gpio_control(bool tx_enable, bool rx_enable) {
 }
 
 uint32_t uart_bridge_get_rx_count(void) {
-    return bridge_stats.rx_bytes;
+    portENTER_CRITICAL();
+    uint32_t count = (uint32_t)bridge_stats.rx_bytes;
+    portEXIT_CRITICAL();
+    return count;
 }
 
 uint32_t uart_bridge_get_tx_count(void) {
-    return bridge_stats.tx_bytes;
+    portENTER_CRITICAL();
+    uint32_t count = (uint32_t)bridge_stats.tx_bytes;
+    portEXIT_CRITICAL();
+    return count;
 }
\ No newline at end of file
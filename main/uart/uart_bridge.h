@@ -6,7 +6,9 @@
 #pragma once
 
 #include "esp_err.h"
+#include "lucid_config.h"
 #include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -25,20 +27,165 @@ extern "C" {
 // Buffer sizes
 #define LUCIDUART_TX_BUF_SIZE       1024            // TX buffer size
 #define LUCIDUART_RX_BUF_SIZE       1024            // RX buffer size
-#define LUCIDUART_QUEUE_SIZE        10              // UART event queue size
+// One data event per LUCIDUART_IRQ_MIN_FULL bytes of a full RX buffer,
+// plus room for error and break events
+#define LUCIDUART_QUEUE_SIZE        (LUCIDUART_RX_BUF_SIZE / LUCIDUART_IRQ_MIN_FULL + 4)
 
-// Bridge statistics
+// Asynchronous TX queue in front of the driver's TX buffer
+#define LUCIDUART_TX_QUEUE_BYTES    2048            // Queued payload bytes (power of two)
+#define LUCIDUART_TX_QUEUE_DEPTH    16              // Queued messages
+#define LUCIDUART_TX_TASK_PRIORITY  4               // Below the UART RX task (5)
+#define LUCIDUART_TX_TASK_STACK     2048
+#define LUCIDUART_TX_CHUNK          128             // Bytes per driver write (flow-control granularity)
+
+// Software flow control (xonxoff_enabled)
+#define LUCIDUART_XON                   0x11
+#define LUCIDUART_XOFF                  0x13
+#define LUCIDUART_XOFF_HIGH_WATER       (LUCIDUART_RX_RING_SIZE * 3 / 4)    // Slowest cursor lag that sends XOFF
+#define LUCIDUART_XOFF_LOW_WATER        (LUCIDUART_RX_RING_SIZE / 4)        // ...and XON again
+
+// Hot reconfiguration
+#define LUCIDUART_RECONFIG_TIMEOUT_MS   1000    // Max wait for the UART task to apply a change
+#define LUCIDUART_RECONFIG_TX_WAIT_MS   500     // Max wait for the driver TX buffer to drain first
+
+// RX interrupt tuning (ESP8266 RX FIFO is 128 bytes, thresholds are 7-bit)
+#define LUCIDUART_IRQ_HIGH_BAUD         460800      // AUTO switches to high-throughput here
+#define LUCIDUART_IRQ_LOWLAT_FULL       16          // Low-latency: FIFO full threshold
+#define LUCIDUART_IRQ_LOWLAT_TOUT       2           // Low-latency: idle timeout (symbols)
+#define LUCIDUART_IRQ_THROUGHPUT_FULL   112         // High-throughput: FIFO full threshold
+#define LUCIDUART_IRQ_THROUGHPUT_TOUT   16          // High-throughput: idle timeout (symbols)
+#define LUCIDUART_IRQ_MIN_FULL          LUCIDUART_IRQ_LOWLAT_FULL   // Lowest FIFO full threshold accepted
+
+// RX ring buffer shared by all consumers (must be a power of two).
+// Doubles as scrollback: consumers can seek back to any offset still held.
+// With CONFIG_UART_HISTORY older output is kept compressed instead, so the
+// ring only has to cover consumer lag and short reconnects.
+#if CONFIG_UART_HISTORY
+#define LUCIDUART_RX_RING_SIZE      8192            // RX ring size in bytes
+#else
+#define LUCIDUART_RX_RING_SIZE      16384           // RX ring / scrollback size in bytes
+#endif
+#define LUCIDUART_RX_LINE_INDEX_SIZE 256            // Line-start stamps kept (power of two)
+#define LUCIDUART_RX_CHUNK_INDEX_SIZE 128           // RX event arrival stamps kept (power of two)
+#define LUCIDUART_MAX_CONSUMERS     12              // Max concurrent read cursors (<= 24 event bits)
+
+// Auto-baud detection
+#define LUCIDUART_AUTOBAUD_WINDOW_MS        250     // Listen time per candidate rate
+#define LUCIDUART_AUTOBAUD_MIN_BYTES        16      // Bytes needed to score a candidate
+#define LUCIDUART_AUTOBAUD_LOCK_SCORE       90      // Minimum score (0-100) to lock a rate
+#define LUCIDUART_AUTOBAUD_MAX_ROUNDS       40      // Candidate sweeps before giving up
+#define LUCIDUART_AUTOBAUD_MAX_CANDIDATES   12
+#define LUCIDUART_AUTOBAUD_TASK_PRIORITY    3
+#define LUCIDUART_AUTOBAUD_TASK_STACK       2560
+
+// Consumer handle returned by uart_bridge_consumer_open()
+typedef int uart_bridge_consumer_t;
+
+/**
+ * TX completion callback, run on the TX task once a queued message has
+ * been handed to the driver. result is ESP_OK when all bytes were
+ * written, ESP_FAIL on a driver error, or ESP_ERR_INVALID_STATE when the
+ * message was discarded by a TX purge or because the bridge stopped.
+ * Must not block or submit with a wait.
+ */
+typedef void (*uart_bridge_tx_done_t)(void* ctx, esp_err_t result, size_t written);
+
+// Line-start timestamp (recorded when timestamp_enabled is set)
+typedef struct {
+    uint32_t offset;            // Stream offset of the line's first byte
+    int64_t time_us;            // esp_timer time of the RX event that delivered it
+} uart_bridge_line_stamp_t;
+
+// Byte-rate meter (bytes per second, EWMA over 1 s / 10 s / 60 s)
+typedef struct {
+    uint32_t rate_1s;
+    uint32_t rate_10s;
+    uint32_t rate_60s;
+    uint32_t peak_1s;           // Highest 1 s sample since reset
+} uart_bridge_rate_t;
+
+// Bridge statistics (snapshot taken atomically by uart_bridge_get_stats)
 typedef struct {
-    uint32_t rx_bytes;          // Total bytes received from UART
-    uint32_t tx_bytes;          // Total bytes transmitted to UART
-    uint32_t rx_errors;         // RX errors (overflow, parity, etc.)
+    uint64_t rx_bytes;          // Total bytes received from UART
+    uint64_t tx_bytes;          // Total bytes transmitted to UART
+    uint32_t rx_errors;         // RX errors (sum of the breakdown below)
     uint32_t tx_errors;         // TX errors
     uint32_t bridge_uptime;     // Time since bridge started (seconds)
     bool bridge_active;         // Bridge is currently active
     uint32_t current_baud;      // Current baud rate
     uint32_t connected_clients; // Number of WebSocket clients
+    uint32_t active_consumers;  // Open RX ring cursors
+    uint32_t rx_events;         // UART_DATA events handled
+    uint32_t rx_events_per_sec; // UART_DATA events over the last second
+    uint32_t rx_bytes_per_event;    // Average bytes per event over the last second
+    uint32_t rx_lines;          // Lines stamped (timestamp_enabled)
+    
+    // RX error breakdown
+    uint32_t rx_fifo_overflows; // Hardware FIFO overflowed before the ISR drained it
+    uint32_t rx_buffer_full;    // Driver ring buffer full
+    uint32_t rx_frame_errors;   // Framing errors (wrong baud, noise)
+    uint32_t rx_parity_errors;  // Parity errors
+    
+    // Throughput
+    uart_bridge_rate_t rx_rate;
+    uart_bridge_rate_t tx_rate;
+    
+    // TX queue
+    uint32_t tx_messages;       // Messages accepted by uart_bridge_tx_submit
+    uint32_t tx_queue_full;     // Submissions rejected because the queue was full
+    uint32_t tx_queued;         // Bytes waiting in the TX queue (snapshot)
+    
+    // Software flow control
+    bool flow_rx_throttled;     // We sent XOFF to the target
+    bool flow_tx_paused;        // The target sent us XOFF
+    uint32_t flow_xoff_sent;    // XOFFs sent to the target
+    uint32_t flow_xoff_received;    // XOFFs received from the target
+    uint32_t flow_rx_throttled_ms;  // Total time the target was held off
+    uint32_t flow_tx_paused_ms;     // Total time our TX queue was held off
+    
+    // Hot reconfiguration (uart_bridge_update_config)
+    uint32_t reconfigs;         // Configuration changes applied
+    uint32_t reconfig_last_us;  // RX service gap of the last change
+    uint32_t reconfig_max_us;   // Longest RX service gap of any change
 } uart_bridge_stats_t;
 
+// Per-consumer cursor statistics
+typedef struct {
+    const char* name;           // Consumer name given at open time
+    uint32_t read_offset;       // Stream offset of next unread byte
+    uint32_t pending;           // Bytes waiting to be read
+    uint32_t overruns;          // Times the writer lapped this cursor
+    uint32_t dropped_bytes;     // Bytes lost to overruns
+    uint32_t batches;           // Coalesced flushes released to the consumer
+    uint32_t batched_bytes;     // Bytes released across all flushes
+    uint32_t max_batch;         // Largest single flush in bytes
+} uart_bridge_consumer_stats_t;
+
+// RX interrupt profile
+typedef enum {
+    UART_BRIDGE_IRQ_AUTO = 0,           // Pick by baud rate (LUCIDUART_IRQ_HIGH_BAUD)
+    UART_BRIDGE_IRQ_LOW_LATENCY,        // Small FIFO threshold, short idle timeout
+    UART_BRIDGE_IRQ_HIGH_THROUGHPUT,    // Near-full FIFO threshold, fewer interrupts
+    UART_BRIDGE_IRQ_CUSTOM,             // Use rx_full_thresh / rx_timeout_symbols as given
+} uart_bridge_irq_profile_t;
+
+// Auto-baud detection state
+typedef enum {
+    UART_BRIDGE_AUTOBAUD_IDLE = 0,      // Never started
+    UART_BRIDGE_AUTOBAUD_RUNNING,       // Sweeping candidate rates
+    UART_BRIDGE_AUTOBAUD_LOCKED,        // Rate detected and applied
+    UART_BRIDGE_AUTOBAUD_FAILED,        // No rate scored high enough; original rate restored
+    UART_BRIDGE_AUTOBAUD_CANCELLED,     // Stopped by uart_bridge_autobaud_cancel(); original rate restored
+} uart_bridge_autobaud_state_t;
+
+// Auto-baud detection status
+typedef struct {
+    uart_bridge_autobaud_state_t state;
+    uint32_t baud_rate;         // Locked rate, or rate under test while running
+    uint8_t score;              // Score of the locked (or best so far) rate, 0-100
+    uint32_t rounds;            // Candidate sweeps completed
+} uart_bridge_autobaud_status_t;
+
 // Bridge configuration
 typedef struct {
     uint32_t baud_rate;         // UART baud rate
@@ -46,7 +193,11 @@ typedef struct {
     uart_parity_t parity;       // Parity (none, even, odd)
     uart_stop_bits_t stop_bits; // Stop bits (1, 1.5, 2)
     bool echo_enabled;          // Local echo mode
-    bool timestamp_enabled;     // Add timestamps to data
+    bool timestamp_enabled;     // Stamp each RX line start (see uart_bridge_get_line_stamps)
+    uart_bridge_irq_profile_t irq_profile;  // RX interrupt profile
+    uint8_t rx_full_thresh;     // RX FIFO full threshold (LUCIDUART_IRQ_MIN_FULL-127, filled in for presets)
+    uint8_t rx_timeout_symbols; // RX idle timeout in symbol times (1-127, filled in for presets)
+    bool xonxoff_enabled;       // Software flow control in both directions
 } uart_bridge_config_t;
 
 /**
@@ -55,6 +206,12 @@ typedef struct {
  * Sets up UART driver, GPIO configuration, and internal buffers.
  * Creates UART event handling task for data processing.
  * 
+ * With xonxoff_enabled the bridge sends XOFF once the slowest RX ring
+ * cursor lags LUCIDUART_XOFF_HIGH_WATER bytes behind and XON when it
+ * is back under LUCIDUART_XOFF_LOW_WATER. XON/XOFF bytes from the
+ * target are removed from the RX stream and pause the TX queue; up to
+ * LUCIDUART_TX_BUF_SIZE bytes already in the driver still go out.
+ * 
  * @param config Pointer to bridge configuration (NULL for defaults)
  * @return ESP_OK on success, error code on failure
  */
@@ -92,26 +249,226 @@ esp_err_t uart_bridge_deinit(void);
 /**
  * @brief Send data to UART
  * 
- * Transmits data from network client to serial device.
- * Thread-safe, can be called from WebSocket handlers.
+ * Queues data for the TX task, blocking only while the TX queue is
+ * full. Data longer than LUCIDUART_TX_QUEUE_BYTES is split into several
+ * messages. Handlers that must not block should use
+ * uart_bridge_tx_submit() instead.
  * 
  * @param data Data buffer to send
  * @param length Number of bytes to send
- * @return Number of bytes sent, or -1 on error
+ * @return Number of bytes queued, or -1 on error
  */
 int uart_bridge_send(const uint8_t* data, size_t length);
 
+/**
+ * @brief Queue a message for transmission
+ * 
+ * Copies the message into the bridge TX queue and returns; a dedicated
+ * task writes queued messages to the driver in submission order. A
+ * message is never interleaved with bytes from other submitters, so a
+ * client that submits whole lines gets whole lines on the wire.
+ * 
+ * @param data Message bytes (copied)
+ * @param length Message length, at most LUCIDUART_TX_QUEUE_BYTES
+ * @param wait Ticks to wait for queue space (0 to fail immediately)
+ * @param done Optional completion callback
+ * @param ctx Passed to done
+ * @return ESP_OK if queued, ESP_ERR_NO_MEM if the queue stayed full,
+ *         ESP_ERR_INVALID_SIZE if the message can never fit,
+ *         ESP_ERR_INVALID_STATE if the bridge is not active
+ */
+esp_err_t uart_bridge_tx_submit(const uint8_t* data, size_t length, TickType_t wait,
+                                uart_bridge_tx_done_t done, void* ctx);
+
+/**
+ * @brief Wait until queued TX data has left the wire
+ * 
+ * @param timeout Ticks to wait
+ * @return ESP_OK once the queue and driver are empty, ESP_ERR_TIMEOUT
+ *         otherwise
+ */
+esp_err_t uart_bridge_tx_flush(TickType_t timeout);
+
 /**
  * @brief Register data receive callback
  * 
  * Sets callback function to handle data received from UART.
- * Used by WebSocket server to forward data to clients.
+ * The callback runs on the UART task with a slice of the RX ring and
+ * must not block; slow consumers should use a ring cursor instead.
  * 
  * @param callback Function to call when UART data is received
  * @return ESP_OK on success
  */
 esp_err_t uart_bridge_set_rx_callback(void (*callback)(const uint8_t* data, size_t length));
 
+/**
+ * @brief Open an RX ring consumer
+ * 
+ * Allocates an independent read cursor positioned at the current write
+ * head. The UART task writes each received byte into the ring once and
+ * never waits for consumers; a cursor that falls more than
+ * LUCIDUART_RX_RING_SIZE bytes behind is moved forward and the loss is
+ * counted as an overrun on that cursor only.
+ * 
+ * @param name Short consumer name for statistics (not copied)
+ * @param consumer Receives the consumer handle
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if all cursors are in use
+ */
+esp_err_t uart_bridge_consumer_open(const char* name, uart_bridge_consumer_t* consumer);
+
+/**
+ * @brief Close an RX ring consumer
+ * 
+ * @param consumer Consumer handle
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG for an unknown handle
+ */
+esp_err_t uart_bridge_consumer_close(uart_bridge_consumer_t consumer);
+
+/**
+ * @brief Get the next readable slice for a consumer
+ * 
+ * Returns a pointer directly into the RX ring (no copy). The slice is
+ * contiguous, so data that wraps around the end of the ring is returned
+ * by two successive peek/advance rounds.
+ * 
+ * @param consumer Consumer handle
+ * @param data Receives pointer to the first unread byte
+ * @return Number of contiguous bytes available (0 if none)
+ */
+size_t uart_bridge_consumer_peek(uart_bridge_consumer_t consumer, const uint8_t** data);
+
+/**
+ * @brief Mark bytes as consumed
+ * 
+ * Moves the cursor past data obtained from uart_bridge_consumer_peek().
+ * 
+ * @param consumer Consumer handle
+ * @param length Number of bytes consumed
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if the writer overwrote
+ *         the slice while it was being read (counted as an overrun)
+ */
+esp_err_t uart_bridge_consumer_advance(uart_bridge_consumer_t consumer, size_t length);
+
+/**
+ * @brief Reposition a consumer within the scrollback history
+ * 
+ * Moves the cursor to an absolute stream offset (as reported by
+ * uart_bridge_get_rx_offset() or a consumer's read_offset) so a client
+ * that reconnects can replay exactly what it missed.
+ * 
+ * @param consumer Consumer handle
+ * @param offset Absolute stream offset to resume from
+ * @return ESP_OK if the cursor is at offset,
+ *         ESP_ERR_NOT_FOUND if offset has aged out (cursor set to oldest byte held),
+ *         ESP_ERR_INVALID_SIZE if offset is in the future (cursor set to head),
+ *         ESP_ERR_INVALID_ARG for an unknown handle
+ */
+esp_err_t uart_bridge_consumer_seek(uart_bridge_consumer_t consumer, uint32_t offset);
+
+/**
+ * @brief Get current RX stream offset
+ * 
+ * Total bytes written to the RX ring since boot (wraps at 2^32).
+ * 
+ * @return Offset of the next byte to be received
+ */
+uint32_t uart_bridge_get_rx_offset(void);
+
+/**
+ * @brief Set RX coalescing for a consumer
+ * 
+ * Pending data is held back until min_bytes have accumulated or
+ * max_delay_us has passed since the first unflushed byte arrived, so
+ * chatty output leaves as fewer, larger network packets. The deadline is
+ * rounded up to the FreeRTOS tick. New consumers start with 0/0
+ * (flush immediately).
+ * 
+ * @param consumer Consumer handle
+ * @param min_bytes Flush once this many bytes are pending
+ * @param max_delay_us Flush this long after the first pending byte
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG on bad handle
+ */
+esp_err_t uart_bridge_consumer_set_coalesce(uart_bridge_consumer_t consumer,
+                                            uint32_t min_bytes, uint32_t max_delay_us);
+
+/**
+ * @brief Check whether a consumer should read now
+ * 
+ * True once the consumer's byte threshold or deadline is reached, and
+ * stays true until everything pending at that moment has been consumed.
+ * 
+ * @param consumer Consumer handle
+ * @return true if pending data should be flushed
+ */
+bool uart_bridge_consumer_ready(uart_bridge_consumer_t consumer);
+
+/**
+ * @brief Wait for data on a consumer
+ * 
+ * Blocks until the consumer is ready to flush (see
+ * uart_bridge_consumer_set_coalesce()) or the timeout expires.
+ * 
+ * @param consumer Consumer handle
+ * @param timeout Maximum time to wait in ticks
+ * @return true if data is ready, false on timeout
+ */
+bool uart_bridge_consumer_wait(uart_bridge_consumer_t consumer, TickType_t timeout);
+
+/**
+ * @brief Wait for data on any of several consumers
+ * 
+ * Lets a single task service many cursors (e.g. one per network client).
+ * 
+ * @param consumers Array of consumer handles
+ * @param count Number of handles in the array
+ * @param timeout Maximum time to wait in ticks
+ * @return true if at least one consumer is ready to flush, false on timeout
+ */
+bool uart_bridge_consumer_wait_any(const uart_bridge_consumer_t* consumers, size_t count,
+                                   TickType_t timeout);
+
+/**
+ * @brief Get line-start timestamps for a range of the RX stream
+ * 
+ * With timestamp_enabled the UART task finds CR, LF and CRLF boundaries
+ * across reads and stamps the first byte of every line with the
+ * esp_timer time of the RX event that delivered it. Stamps are kept as
+ * a side index so the byte stream itself is unchanged; transports attach
+ * them as metadata. Only the last LUCIDUART_RX_LINE_INDEX_SIZE lines are
+ * kept, and times are exact for lines younger than ~71 minutes.
+ * 
+ * @param from First stream offset of the range
+ * @param to Offset one past the end of the range
+ * @param stamps Receives stamps in offset order
+ * @param max Capacity of stamps
+ * @return Number of stamps written
+ */
+size_t uart_bridge_get_line_stamps(uint32_t from, uint32_t to,
+                                   uart_bridge_line_stamp_t* stamps, size_t max);
+
+/**
+ * @brief Get the arrival time of the RX event that delivered a byte
+ * 
+ * Every ring fill is stamped with the esp_timer time its UART_DATA event
+ * was dequeued. The last LUCIDUART_RX_CHUNK_INDEX_SIZE fills are kept.
+ * 
+ * @param offset RX stream offset of the byte
+ * @param time_us Receives the arrival time
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the fill has aged out
+ *         of the index or the offset has not been received yet
+ */
+esp_err_t uart_bridge_get_arrival_time(uint32_t offset, int64_t* time_us);
+
+/**
+ * @brief Get consumer cursor statistics
+ * 
+ * @param consumer Consumer handle
+ * @param stats Pointer to stats structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG on bad handle or NULL stats
+ */
+esp_err_t uart_bridge_consumer_get_stats(uart_bridge_consumer_t consumer,
+                                         uart_bridge_consumer_stats_t* stats);
+
 /**
  * @brief Get bridge statistics
  * 
@@ -134,14 +491,90 @@ esp_err_t uart_bridge_reset_stats(void);
 /**
  * @brief Update UART configuration
  * 
- * Changes UART parameters (baud rate, data format) on the fly.
- * Bridge will restart with new configuration.
+ * Changes UART parameters (baud rate, data format, RX interrupt
+ * profile) on the fly without stopping the bridge. The UART task
+ * finishes sending bytes already in the driver, moves all pending RX
+ * into the ring, switches and acknowledges, so nothing received at the
+ * old settings is lost. The RX service gap is reported in the stats
+ * (reconfig_last_us); the driver is never reinstalled.
  * 
  * @param config New configuration parameters
- * @return ESP_OK on success, error code on failure
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if not initialized,
+ *         ESP_ERR_TIMEOUT if the UART task did not respond, or a driver error
  */
 esp_err_t uart_bridge_update_config(const uart_bridge_config_t* config);
 
+/**
+ * @brief Get current UART configuration
+ * 
+ * @param config Pointer to configuration structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if config is NULL
+ */
+esp_err_t uart_bridge_get_config(uart_bridge_config_t* config);
+
+/**
+ * @brief Discard buffered UART data
+ * 
+ * @param rx Drop bytes received by the driver but not yet in the RX ring
+ * @param tx Drop messages still in the TX queue (bytes already handed
+ *           to the driver are still sent)
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t uart_bridge_purge(bool rx, bool tx);
+
+/**
+ * @brief Get estimated TX backlog
+ * 
+ * Bytes waiting in the TX queue plus bytes handed to the UART driver
+ * that have not yet left the wire, estimated from the current baud
+ * rate. Used by network transports to signal flow control before the
+ * TX queue fills.
+ * 
+ * @return Estimated bytes waiting to be transmitted
+ */
+uint32_t uart_bridge_get_tx_backlog(void);
+
+/**
+ * @brief Start automatic baud-rate detection
+ * 
+ * Runs in a background task: cycles the UART through the candidate
+ * rates, listens LUCIDUART_AUTOBAUD_WINDOW_MS at each, and scores the
+ * received bytes by printable-ASCII ratio penalized by framing/parity
+ * errors. The best rate scoring at least LUCIDUART_AUTOBAUD_LOCK_SCORE is
+ * applied with uart_bridge_update_config(). Sweeps repeat while the
+ * target is silent, up to LUCIDUART_AUTOBAUD_MAX_ROUNDS. Bytes received
+ * at the rate in use when the sweep started are published as usual;
+ * at other rates only the start of the window that locks is published,
+ * once it locks. TX is held until the sweep ends.
+ * 
+ * @param candidates Rates to try (NULL for 115200, 74880, 921600 and
+ *                   common rates in between)
+ * @param count Number of candidates (ignored if candidates is NULL)
+ * @return ESP_OK if detection started, ESP_ERR_INVALID_STATE if the bridge
+ *         is not running or detection is already running,
+ *         ESP_ERR_INVALID_ARG on too many candidates
+ */
+esp_err_t uart_bridge_autobaud_start(const uint32_t* candidates, size_t count);
+
+/**
+ * @brief Stop a running detection
+ * 
+ * Restores the rate the sweep started from before returning; callers
+ * applying an explicit rate should cancel first so the sweep does not
+ * override it.
+ * 
+ * @return ESP_OK (also if detection was not running)
+ */
+esp_err_t uart_bridge_autobaud_cancel(void);
+
+/**
+ * @brief Get auto-baud detection status
+ * 
+ * @param status Pointer to status structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if status is NULL
+ */
+esp_err_t uart_bridge_autobaud_get_status(uart_bridge_autobaud_status_t* status);
+
 /**
  * @brief Check if bridge is active
  * 
@@ -0,0 +1,111 @@
+/*
+ * UART Latency - LucidConsole End-to-End Latency Histograms Implementation
+ * Log2-bucketed histograms fed by transports after each send
+ */
+
+#include "uart_latency.h"
+#include "uart_bridge.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_timer.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t count;
+    uint32_t unmatched;
+    uint64_t sum_us;
+    uint32_t max_us;
+    uint32_t buckets[LUCIDUART_LATENCY_BUCKETS];
+} latency_hist_t;
+
+static latency_hist_t latency_hists[UART_LATENCY_TRANSPORT_MAX];
+
+static const char* const transport_names[UART_LATENCY_TRANSPORT_MAX] = {
+    [UART_LATENCY_SSE] = "sse",
+    [UART_LATENCY_TCP] = "tcp",
+    [UART_LATENCY_RFC2217] = "rfc2217",
+};
+
+static int latency_bucket(uint32_t us) {
+    int bucket = 31 - __builtin_clz(us | 1);
+    return (bucket < LUCIDUART_LATENCY_BUCKETS) ? bucket : LUCIDUART_LATENCY_BUCKETS - 1;
+}
+
+/**
+ * @brief Estimate a percentile by interpolating inside its bucket
+ */
+static uint32_t latency_percentile(const latency_hist_t* hist, uint32_t percent) {
+    if (hist->count == 0) {
+        return 0;
+    }
+    
+    uint32_t target = ((uint64_t)hist->count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < LUCIDUART_LATENCY_BUCKETS; i++) {
+        uint32_t n = hist->buckets[i];
+        if (seen + n >= target && n > 0) {
+            uint32_t low = i ? (1u << i) : 0;
+            uint32_t high = (i < LUCIDUART_LATENCY_BUCKETS - 1) ? (2u << i) : hist->max_us;
+            uint32_t value = low + (uint64_t)(high - low) * (target - seen) / n;
+            return (value < hist->max_us) ? value : hist->max_us;
+        }
+        seen += n;
+    }
+    return hist->max_us;
+}
+
+void uart_latency_record(uart_latency_transport_t transport, uint32_t offset) {
+    if (transport >= UART_LATENCY_TRANSPORT_MAX) {
+        return;
+    }
+    
+    latency_hist_t* hist = &latency_hists[transport];
+    int64_t arrival;
+    if (uart_bridge_get_arrival_time(offset, &arrival) != ESP_OK) {
+        portENTER_CRITICAL();
+        hist->unmatched++;
+        portEXIT_CRITICAL();
+        return;
+    }
+    
+    int64_t delta = esp_timer_get_time() - arrival;
+    uint32_t us = (delta < 0) ? 0 : (delta > UINT32_MAX) ? UINT32_MAX : (uint32_t)delta;
+    
+    portENTER_CRITICAL();
+    hist->count++;
+    hist->sum_us += us;
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+    hist->buckets[latency_bucket(us)]++;
+    portEXIT_CRITICAL();
+}
+
+esp_err_t uart_latency_get(uart_latency_transport_t transport, uart_latency_summary_t* summary) {
+    if (transport >= UART_LATENCY_TRANSPORT_MAX || !summary) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    latency_hist_t hist;
+    portENTER_CRITICAL();
+    hist = latency_hists[transport];
+    portEXIT_CRITICAL();
+    
+    summary->count = hist.count;
+    summary->unmatched = hist.unmatched;
+    summary->mean_us = hist.count ? hist.sum_us / hist.count : 0;
+    summary->p50_us = latency_percentile(&hist, 50);
+    summary->p99_us = latency_percentile(&hist, 99);
+    summary->max_us = hist.max_us;
+    memcpy(summary->buckets, hist.buckets, sizeof(summary->buckets));
+    return ESP_OK;
+}
+
+void uart_latency_reset(void) {
+    portENTER_CRITICAL();
+    memset(latency_hists, 0, sizeof(latency_hists));
+    portEXIT_CRITICAL();
+}
+
+const char* uart_latency_transport_name(uart_latency_transport_t transport) {
+    return (transport < UART_LATENCY_TRANSPORT_MAX) ? transport_names[transport] : "unknown";
+}
@@ -0,0 +1,76 @@
+/*
+ * UART Latency - LucidConsole End-to-End Latency Histograms
+ * Time from UART RX event to a transport handing the bytes to its socket
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bucket i holds samples in [2^i, 2^(i+1)) microseconds; bucket 0 also
+// holds 0-1 us and the last bucket everything above ~8 s
+#define LUCIDUART_LATENCY_BUCKETS   24
+
+// Transports with their own histogram
+typedef enum {
+    UART_LATENCY_SSE = 0,
+    UART_LATENCY_TCP,
+    UART_LATENCY_RFC2217,
+    UART_LATENCY_TRANSPORT_MAX,
+} uart_latency_transport_t;
+
+// Histogram summary for one transport
+typedef struct {
+    uint32_t count;             // Samples recorded
+    uint32_t unmatched;         // Sends whose arrival stamp had aged out
+    uint32_t mean_us;
+    uint32_t p50_us;            // Interpolated within the log2 bucket
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint32_t buckets[LUCIDUART_LATENCY_BUCKETS];
+} uart_latency_summary_t;
+
+/**
+ * @brief Record latency for bytes a transport just sent
+ * 
+ * Looks up when the RX event carrying the byte at offset arrived and
+ * records the time since then. Transports pass the first offset of each
+ * send, so the sample is the age of the oldest byte and includes any
+ * coalescing delay.
+ * 
+ * @param transport Transport histogram to update
+ * @param offset RX stream offset of the first byte sent
+ */
+void uart_latency_record(uart_latency_transport_t transport, uint32_t offset);
+
+/**
+ * @brief Get histogram summary for a transport
+ * 
+ * @param transport Transport to summarize
+ * @param summary Pointer to summary structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG on bad transport or NULL summary
+ */
+esp_err_t uart_latency_get(uart_latency_transport_t transport, uart_latency_summary_t* summary);
+
+/**
+ * @brief Clear all histograms
+ */
+void uart_latency_reset(void);
+
+/**
+ * @brief Get short transport name ("sse", "tcp", "rfc2217")
+ * 
+ * @param transport Transport
+ * @return Name string, or "unknown"
+ */
+const char* uart_latency_transport_name(uart_latency_transport_t transport);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,510 @@
+/*
+ * UART Replay - LucidConsole Capture Replay Implementation
+ * Schedules capture records on TX and verifies the looped-back RX stream
+ */
+
+#include "uart_replay.h"
+#include "uart_bridge.h"
+#include "uart_selftest.h"
+#include "flash_capture.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "UART_REPLAY";
+
+#define REPLAY_TICK_US          (1000000 / configTICK_RATE_HZ)
+#define REPLAY_MAX_SLEEP_TICKS  10      // Drain the verifier at least this often
+#define FNV_OFFSET              0x811C9DC5u
+#define FNV_PRIME               0x01000193u
+
+static uint16_t replay_speed = 1;
+static uart_bridge_consumer_t replay_cursor;
+static uart_bridge_config_t replay_original;
+static esp_err_t replay_error = ESP_OK;
+static volatile bool replay_cancel_flag = false;
+static TaskHandle_t replay_task_handle = NULL;
+
+// Capture bytes on their way from the uploader to the task. Both sides
+// hold a reference; whichever lets go last frees the buffer.
+static uint8_t* replay_fifo = NULL;
+static volatile size_t replay_fifo_head = 0;    // Advanced by uart_replay_feed()
+static volatile size_t replay_fifo_tail = 0;    // Advanced by the replay task
+static volatile bool replay_input_open = false;
+static volatile bool replay_input_done = false;
+static int replay_fifo_refs = 0;
+
+// Capture parser: the file header, then record headers and payloads
+static uint8_t replay_head[LUCIDUART_REPLAY_HEADER_SIZE];
+static size_t replay_head_len = 0;
+static bool replay_header_done = false;
+static uint32_t replay_payload_left = 0;
+static bool replay_record_pending = false;  // Header parsed, slot not yet waited for
+
+// Schedule: record n is due at start + (sum of deltas up to n) / speed
+static int64_t replay_start_us = 0;
+static int64_t replay_begin_us = 0;
+static uint64_t replay_capture_us = 0;
+
+// Due bytes waiting for one TX submission
+static uint8_t replay_batch[LUCIDUART_REPLAY_BATCH];
+static size_t replay_batch_len = 0;
+
+// Loopback check: FNV-1a of everything sent and everything received
+static uint32_t replay_tx_hash = FNV_OFFSET;
+static uint32_t replay_rx_hash = FNV_OFFSET;
+
+// Baselines for the error and overrun deltas
+static uart_bridge_stats_t replay_stats_before;
+static const char* replay_consumer_names[LUCIDUART_MAX_CONSUMERS];
+static uint32_t replay_consumer_dropped[LUCIDUART_MAX_CONSUMERS];
+
+static uart_replay_status_t replay_status = {0};
+
+static uint32_t replay_hash(uint32_t hash, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Read the looped-back bytes on the replay's own cursor
+ *
+ * @return Bytes read
+ */
+static size_t replay_service(void) {
+    size_t total = 0;
+    const uint8_t* data;
+    size_t len;
+    
+    while ((len = uart_bridge_consumer_peek(replay_cursor, &data)) > 0) {
+        replay_rx_hash = replay_hash(replay_rx_hash, data, len);
+        uart_bridge_consumer_advance(replay_cursor, len);
+        total += len;
+    }
+    replay_status.result.rx_bytes += total;
+    return total;
+}
+
+/**
+ * @brief Submit the gathered due bytes as one TX message
+ */
+static void replay_flush(void) {
+    if (replay_batch_len == 0 || replay_error != ESP_OK) {
+        return;
+    }
+    
+    esp_err_t err = uart_bridge_tx_submit(replay_batch, replay_batch_len,
+                                          pdMS_TO_TICKS(LUCIDUART_REPLAY_TX_WAIT_MS), NULL, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "TX submit failed after %u bytes: %s",
+                 replay_status.result.tx_bytes, esp_err_to_name(err));
+        replay_error = err;
+        return;
+    }
+    replay_tx_hash = replay_hash(replay_tx_hash, replay_batch, replay_batch_len);
+    replay_status.result.tx_bytes += replay_batch_len;
+    replay_batch_len = 0;
+    replay_service();
+}
+
+/**
+ * @brief Sleep until a record is due, reading RX meanwhile
+ *
+ * Gaps shorter than a tick are not waited for; such records go out
+ * with the bytes before them.
+ */
+static void replay_wait_until(int64_t due_us) {
+    for (;;) {
+        int64_t ticks = (due_us - esp_timer_get_time()) / REPLAY_TICK_US;
+        if (ticks <= 0 || replay_cancel_flag) {
+            return;
+        }
+        replay_service();
+        vTaskDelay(ticks < REPLAY_MAX_SLEEP_TICKS ? (TickType_t)ticks : REPLAY_MAX_SLEEP_TICKS);
+    }
+}
+
+/**
+ * @brief A record header is complete: wait for its slot
+ */
+static void replay_record_start(void) {
+    uint32_t delta_us = replay_head[0] | (replay_head[1] << 8) |
+                        (replay_head[2] << 16) | ((uint32_t)replay_head[3] << 24);
+    replay_payload_left = replay_head[4] | (replay_head[5] << 8);
+    replay_capture_us += delta_us;
+    replay_status.result.records++;
+    
+    int64_t due_us = replay_start_us + (int64_t)(replay_capture_us / replay_speed);
+    if (due_us - esp_timer_get_time() >= REPLAY_TICK_US) {
+        // Everything due before this record leaves now
+        replay_flush();
+        replay_wait_until(due_us);
+    }
+    
+    int64_t late_us = esp_timer_get_time() - due_us;
+    if (late_us > REPLAY_TICK_US) {
+        replay_status.result.late_records++;
+    }
+    if (late_us > (int64_t)replay_status.result.max_late_us) {
+        replay_status.result.max_late_us = (uint32_t)late_us;
+    }
+}
+
+/**
+ * @brief Parse capture bytes, submitting records as they fall due
+ *
+ * Stops after each record header, so that the uploader can refill the
+ * FIFO space before it while the task waits for the record's slot.
+ *
+ * @return Bytes consumed
+ */
+static size_t replay_parse(const uint8_t* data, size_t len) {
+    size_t i = 0;
+    while (i < len && replay_error == ESP_OK && !replay_cancel_flag) {
+        if (replay_payload_left > 0) {
+            size_t take = len - i;
+            if (take > replay_payload_left) {
+                take = replay_payload_left;
+            }
+            if (take > sizeof(replay_batch) - replay_batch_len) {
+                take = sizeof(replay_batch) - replay_batch_len;
+            }
+            memcpy(replay_batch + replay_batch_len, data + i, take);
+            replay_batch_len += take;
+            replay_payload_left -= take;
+            i += take;
+            if (replay_batch_len == sizeof(replay_batch)) {
+                replay_flush();
+            }
+            continue;
+        }
+        
+        size_t want = replay_header_done ? LUCIDUART_REPLAY_RECORD_SIZE : LUCIDUART_REPLAY_HEADER_SIZE;
+        replay_head[replay_head_len++] = data[i++];
+        if (replay_head_len < want) {
+            continue;
+        }
+        replay_head_len = 0;
+        
+        if (!replay_header_done) {
+            uint16_t version = replay_head[4] | (replay_head[5] << 8);
+            if (memcmp(replay_head, LUCIDUART_REPLAY_MAGIC, 4) != 0 ||
+                version != LUCIDUART_REPLAY_VERSION) {
+                replay_error = ESP_ERR_INVALID_VERSION;
+                return i;
+            }
+            replay_header_done = true;
+            replay_start_us = esp_timer_get_time();
+            continue;
+        }
+        // The task waits for the record's slot once its header has left the FIFO
+        replay_record_pending = true;
+        break;
+    }
+    return i;
+}
+
+/**
+ * @brief Give back the bridge settings the replay took over
+ */
+static void replay_restore(void) {
+    uart_bridge_consumer_close(replay_cursor);
+    if (replay_original.xonxoff_enabled) {
+        uart_bridge_update_config(&replay_original);
+    }
+    flash_capture_set_paused(false);
+}
+
+/**
+ * @brief Drop one reference to the FIFO, freeing it with the last one
+ */
+static void replay_fifo_release(void) {
+    portENTER_CRITICAL();
+    bool last = (--replay_fifo_refs == 0);
+    portEXIT_CRITICAL();
+    if (last) {
+        free(replay_fifo);
+        replay_fifo = NULL;
+    }
+}
+
+/**
+ * @brief Wake the replay task for new input, if it is still running
+ */
+static void replay_notify(void) {
+    // The task clears its handle in a critical section before deleting itself
+    portENTER_CRITICAL();
+    if (replay_task_handle) {
+        xTaskNotifyGive(replay_task_handle);
+    }
+    portEXIT_CRITICAL();
+}
+
+/**
+ * @brief Drain the loopback, verify it and publish the outcome
+ */
+static void replay_complete(void) {
+    esp_err_t err = replay_error;
+    if (err == ESP_OK && !replay_cancel_flag &&
+        (replay_payload_left > 0 || replay_head_len > 0 || !replay_header_done)) {
+        err = ESP_ERR_INVALID_SIZE;
+    }
+    if (!replay_cancel_flag) {
+        replay_flush();
+    }
+    
+    // Wait for the wire, then for the loopback to deliver the tail
+    uart_bridge_tx_flush(pdMS_TO_TICKS(LUCIDUART_REPLAY_TX_WAIT_MS));
+    int64_t quiet_since = esp_timer_get_time();
+    while (!replay_cancel_flag && replay_status.result.rx_bytes < replay_status.result.tx_bytes &&
+           esp_timer_get_time() - quiet_since < LUCIDUART_REPLAY_DRAIN_MS * 1000) {
+        vTaskDelay(1);
+        if (replay_service() > 0) {
+            quiet_since = esp_timer_get_time();
+        }
+    }
+    replay_service();
+    
+    uart_bridge_consumer_stats_t cstats;
+    uart_bridge_consumer_get_stats(replay_cursor, &cstats);
+    replay_status.result.rx_verified = cstats.overruns == 0 &&
+                                       replay_status.result.rx_bytes == replay_status.result.tx_bytes &&
+                                       replay_rx_hash == replay_tx_hash;
+    
+    // Losses anywhere in the fan-out while the replay ran
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        if (i == replay_cursor || uart_bridge_consumer_get_stats(i, &cstats) != ESP_OK) {
+            continue;
+        }
+        uint32_t before = (cstats.name == replay_consumer_names[i]) ? replay_consumer_dropped[i] : 0;
+        if (cstats.dropped_bytes > before) {
+            replay_status.result.consumer_dropped += cstats.dropped_bytes - before;
+        }
+    }
+    uart_bridge_stats_t stats;
+    uart_bridge_get_stats(&stats);
+    replay_status.result.rx_fifo_overflows = stats.rx_fifo_overflows - replay_stats_before.rx_fifo_overflows;
+    replay_status.result.rx_buffer_full = stats.rx_buffer_full - replay_stats_before.rx_buffer_full;
+    replay_status.result.capture_ms = (uint32_t)(replay_capture_us / 1000);
+    replay_status.result.elapsed_ms = (uint32_t)((esp_timer_get_time() - replay_begin_us) / 1000);
+    
+    replay_restore();
+    
+    replay_status.error = err;
+    if (err != ESP_OK) {
+        replay_status.state = UART_REPLAY_FAILED;
+    } else {
+        replay_status.state = replay_cancel_flag ? UART_REPLAY_CANCELLED : UART_REPLAY_DONE;
+    }
+    
+    ESP_LOGI(TAG, "Replay of %u records, %u bytes in %u ms (capture %u ms): %u bytes back, %s",
+             replay_status.result.records, replay_status.result.tx_bytes, replay_status.result.elapsed_ms,
+             replay_status.result.capture_ms, replay_status.result.rx_bytes,
+             replay_status.result.rx_verified ? "verified" : "MISMATCH");
+}
+
+/**
+ * @brief Replay task - plays the FIFO until the input ends or fails
+ */
+static void replay_task(void* pvParameters) {
+    while (replay_error == ESP_OK && !replay_cancel_flag) {
+        if (replay_record_pending) {
+            replay_record_pending = false;
+            replay_record_start();
+            continue;
+        }
+        
+        bool done = replay_input_done;
+        size_t head = replay_fifo_head;
+        size_t tail = replay_fifo_tail;
+        
+        if (head != tail) {
+            // Up to the wrap; the rest comes on the next pass
+            size_t pos = tail % LUCIDUART_REPLAY_FIFO_SIZE;
+            size_t len = head - tail;
+            if (len > LUCIDUART_REPLAY_FIFO_SIZE - pos) {
+                len = LUCIDUART_REPLAY_FIFO_SIZE - pos;
+            }
+            replay_fifo_tail = tail + replay_parse(replay_fifo + pos, len);
+            continue;
+        }
+        if (done) {
+            break;
+        }
+        
+        // Bytes already due must not wait for the next network read
+        replay_flush();
+        replay_service();
+        ulTaskNotifyTake(pdTRUE, REPLAY_MAX_SLEEP_TICKS);
+    }
+    
+    replay_complete();
+    replay_fifo_release();
+    
+    portENTER_CRITICAL();
+    replay_task_handle = NULL;
+    portEXIT_CRITICAL();
+    vTaskDelete(NULL);
+}
+
+esp_err_t uart_replay_begin(uint16_t speed) {
+    if (speed < 1 || speed > LUCIDUART_REPLAY_MAX_SPEED) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uart_selftest_status_t selftest;
+    uart_selftest_get_status(&selftest);
+    if (replay_task_handle || replay_fifo || !uart_bridge_is_active() ||
+        selftest.state == UART_SELFTEST_RUNNING) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    replay_fifo = malloc(LUCIDUART_REPLAY_FIFO_SIZE);
+    if (!replay_fifo) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t ret = uart_bridge_consumer_open("replay", &replay_cursor);
+    if (ret != ESP_OK) {
+        free(replay_fifo);
+        replay_fifo = NULL;
+        return ret;
+    }
+    
+    // The replay owns the line: no rate hunting, and capture bytes may hold XON/XOFF
+    uart_bridge_autobaud_cancel();
+    uart_bridge_get_config(&replay_original);
+    if (replay_original.xonxoff_enabled) {
+        uart_bridge_config_t config = replay_original;
+        config.xonxoff_enabled = false;
+        uart_bridge_update_config(&config);
+    }
+    flash_capture_set_paused(true);
+    
+    uart_bridge_get_stats(&replay_stats_before);
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        uart_bridge_consumer_stats_t cstats;
+        bool open = uart_bridge_consumer_get_stats(i, &cstats) == ESP_OK;
+        replay_consumer_names[i] = open ? cstats.name : NULL;
+        replay_consumer_dropped[i] = open ? cstats.dropped_bytes : 0;
+    }
+    
+    replay_speed = speed;
+    replay_error = ESP_OK;
+    replay_cancel_flag = false;
+    replay_head_len = 0;
+    replay_header_done = false;
+    replay_payload_left = 0;
+    replay_record_pending = false;
+    replay_capture_us = 0;
+    replay_batch_len = 0;
+    replay_tx_hash = FNV_OFFSET;
+    replay_rx_hash = FNV_OFFSET;
+    replay_fifo_head = 0;
+    replay_fifo_tail = 0;
+    replay_fifo_refs = 2;
+    replay_input_open = true;
+    replay_input_done = false;
+    replay_status = (uart_replay_status_t){
+        .state = UART_REPLAY_RUNNING,
+        .result = { .speed = speed },
+    };
+    replay_begin_us = esp_timer_get_time();
+    
+    BaseType_t task_created = xTaskCreate(replay_task, "replay",
+                                          LUCIDUART_REPLAY_TASK_STACK, NULL,
+                                          LUCIDUART_REPLAY_TASK_PRIORITY,
+                                          &replay_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create replay task");
+        replay_restore();
+        replay_input_open = false;
+        replay_fifo_refs = 0;
+        free(replay_fifo);
+        replay_fifo = NULL;
+        replay_status.state = UART_REPLAY_FAILED;
+        replay_status.error = ESP_FAIL;
+        return ESP_FAIL;
+    }
+    
+    ESP_LOGI(TAG, "Replay started at %ux - TX must be jumpered to RX", speed);
+    return ESP_OK;
+}
+
+esp_err_t uart_replay_feed(const uint8_t* data, size_t len) {
+    if (!replay_input_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    while (len > 0) {
+        if (replay_error != ESP_OK) {
+            return replay_error;
+        }
+        size_t head = replay_fifo_head;
+        size_t space = LUCIDUART_REPLAY_FIFO_SIZE - (head - replay_fifo_tail);
+        if (space == 0) {
+            // The task is waiting for a record's slot
+            vTaskDelay(1);
+            continue;
+        }
+        
+        size_t pos = head % LUCIDUART_REPLAY_FIFO_SIZE;
+        size_t take = len;
+        if (take > space) {
+            take = space;
+        }
+        if (take > LUCIDUART_REPLAY_FIFO_SIZE - pos) {
+            take = LUCIDUART_REPLAY_FIFO_SIZE - pos;
+        }
+        memcpy(replay_fifo + pos, data, take);
+        replay_fifo_head = head + take;
+        data += take;
+        len -= take;
+        replay_notify();
+    }
+    return replay_error;
+}
+
+esp_err_t uart_replay_finish(void) {
+    if (!replay_input_open) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    replay_input_open = false;
+    replay_input_done = true;
+    replay_notify();
+    replay_fifo_release();
+    return ESP_OK;
+}
+
+esp_err_t uart_replay_cancel(void) {
+    if (!replay_task_handle && !replay_input_open) {
+        return ESP_OK;
+    }
+    
+    replay_cancel_flag = true;
+    if (replay_input_open) {
+        uart_replay_finish();
+    }
+    
+    // Wait for the task to restore the bridge
+    while (replay_task_handle) {
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_replay_get_status(uart_replay_status_t* status) {
+    if (!status) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *status = replay_status;
+    return ESP_OK;
+}
+
+bool uart_replay_active(void) {
+    return replay_task_handle != NULL;
+}
@@ -0,0 +1,145 @@
+/*
+ * UART Replay - LucidConsole Capture Replay
+ * Plays a timed capture out of TX with its original inter-arrival timing
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Capture file format (little-endian):
+ *
+ *   header  "LCAP" | u16 version (1) | u16 flags (0)
+ *   record  u32 delta_us | u16 len | len payload bytes
+ *
+ * delta_us is the time since the previous record arrived (since the
+ * start of the capture for the first one). bench/replay.py records and
+ * converts these files.
+ */
+#define LUCIDUART_REPLAY_MAGIC          "LCAP"
+#define LUCIDUART_REPLAY_VERSION        1
+#define LUCIDUART_REPLAY_HEADER_SIZE    8
+#define LUCIDUART_REPLAY_RECORD_SIZE    6       // Record header before the payload
+
+#define LUCIDUART_REPLAY_MAX_SPEED      100     // Fastest time scale (100x)
+#define LUCIDUART_REPLAY_BATCH          512     // Due bytes gathered per TX submission
+#define LUCIDUART_REPLAY_TX_WAIT_MS     5000    // Max wait for TX queue space
+#define LUCIDUART_REPLAY_DRAIN_MS       200     // Quiet RX time that ends a replay
+#define LUCIDUART_REPLAY_FIFO_SIZE      4096    // Capture bytes received but not yet played
+#define LUCIDUART_REPLAY_TASK_PRIORITY  4       // Below the UART task (5)
+#define LUCIDUART_REPLAY_TASK_STACK     3072
+
+// Replay state
+typedef enum {
+    UART_REPLAY_IDLE = 0,               // Never started
+    UART_REPLAY_RUNNING,
+    UART_REPLAY_DONE,
+    UART_REPLAY_CANCELLED,              // Stopped by uart_replay_cancel()
+    UART_REPLAY_FAILED,                 // See the status error
+} uart_replay_state_t;
+
+// Replay outcome
+typedef struct {
+    uint16_t speed;
+    uint32_t records;
+    uint32_t tx_bytes;
+    uint32_t capture_ms;        // Span of the capture at 1x
+    uint32_t elapsed_ms;        // Wall time of the replay, drain included
+    uint32_t late_records;      // Records sent more than a tick behind schedule
+    uint32_t max_late_us;       // Worst lag behind schedule
+    uint32_t rx_bytes;          // Bytes looped back to the replay's own RX cursor
+    bool rx_verified;           // RX matched TX byte for byte
+    uint32_t rx_fifo_overflows; // Driver-level RX losses during the replay
+    uint32_t rx_buffer_full;
+    uint32_t consumer_dropped;  // Bytes other RX cursors (SSE, TCP) lost to overruns
+} uart_replay_result_t;
+
+// Replay status
+typedef struct {
+    uart_replay_state_t state;
+    esp_err_t error;            // Why the replay failed, ESP_OK otherwise
+    uart_replay_result_t result; // So far while running, final afterwards
+} uart_replay_status_t;
+
+/**
+ * @brief Start a replay
+ *
+ * Needs a jumper from TX to RX on a device (the target must be
+ * disconnected), or the simulator's --uart loopback. Opens a verifying
+ * RX cursor, turns flow control and auto-baud off, pauses flash capture
+ * and starts the replay task, which plays the capture bytes passed to
+ * uart_replay_feed() as their records fall due. The caller then ends
+ * the input with uart_replay_finish() or uart_replay_cancel().
+ *
+ * @param speed Time scale, 1 (real time) to LUCIDUART_REPLAY_MAX_SPEED
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG on a bad speed,
+ *         ESP_ERR_INVALID_STATE if the bridge is not running or a replay
+ *         or self-test is in progress, ESP_ERR_NO_MEM if no RX cursor
+ *         or FIFO memory is free, ESP_FAIL if the task could not start
+ */
+esp_err_t uart_replay_begin(uint16_t speed);
+
+/**
+ * @brief Queue the next part of the capture file
+ *
+ * Copies the bytes into the replay FIFO, blocking only while it is
+ * full, i.e. while more than LUCIDUART_REPLAY_FIFO_SIZE bytes wait for
+ * their records to fall due. Any split of the file into calls is
+ * accepted.
+ *
+ * @param data Capture file bytes
+ * @param len Number of bytes
+ * @return ESP_OK on success, the replay's error once it has failed
+ *         (ESP_ERR_INVALID_VERSION if the header is not a supported
+ *         capture, ESP_ERR_NO_MEM if the TX queue stayed full),
+ *         ESP_ERR_INVALID_STATE if no input is open
+ */
+esp_err_t uart_replay_feed(const uint8_t* data, size_t len);
+
+/**
+ * @brief End the input: the capture file is complete
+ *
+ * The replay task plays what is queued, waits for TX to drain and for
+ * the looped-back bytes to arrive, compares them with what was sent and
+ * restores the bridge. Follow it with uart_replay_get_status(). Also
+ * ends the input of a replay that has already failed.
+ *
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if no input is open
+ */
+esp_err_t uart_replay_finish(void);
+
+/**
+ * @brief Abandon a replay, e.g. when the upload broke off
+ *
+ * Returns once the replay task has restored the bridge.
+ *
+ * @return ESP_OK (also if no replay was running)
+ */
+esp_err_t uart_replay_cancel(void);
+
+/**
+ * @brief Get replay status
+ *
+ * A file that ends inside a record fails with ESP_ERR_INVALID_SIZE.
+ *
+ * @param status Pointer to status structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if status is NULL
+ */
+esp_err_t uart_replay_get_status(uart_replay_status_t* status);
+
+/**
+ * @brief Check whether a replay is in progress
+ */
+bool uart_replay_active(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,450 @@
+/*
+ * UART Self-Test - LucidConsole Loopback Benchmark Implementation
+ * Framed PRNG pattern on TX, verified on RX with resync after losses
+ */
+
+#include "uart_selftest.h"
+#include "uart_bridge.h"
+#include "uart_replay.h"
+#include "flash_capture.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <string.h>
+
+static const char* TAG = "UART_SELFTEST";
+
+#define SELFTEST_HEADER     4       // seq (LE), ~seq
+#define SELFTEST_PAYLOAD    (LUCIDUART_SELFTEST_FRAME - SELFTEST_HEADER)
+#define SELFTEST_CALIBRATE_MS   500
+#define SELFTEST_DRAIN_MS       200     // Quiet time that ends a case after TX stops
+
+static const uint32_t selftest_default_bauds[] = {
+    115200, 230400, 460800, 921600, 1500000, 2000000
+};
+static const uint16_t selftest_default_batches[] = { 32, 256, 1024 };
+static const uint8_t selftest_default_consumers[] = { 1, 4 };
+
+// Sweep copied at start
+static uint32_t selftest_bauds[LUCIDUART_SELFTEST_MAX_BAUDS];
+static uint16_t selftest_batches[LUCIDUART_SELFTEST_MAX_BATCHES];
+static uint8_t selftest_consumers[2];
+static size_t selftest_baud_count = 0;
+static size_t selftest_batch_count = 0;
+static size_t selftest_consumer_count = 0;
+static uint32_t selftest_duration_ms = 0;
+
+static uart_selftest_result_t selftest_results[LUCIDUART_SELFTEST_MAX_RESULTS];
+static uart_selftest_status_t selftest_status = {0};
+static volatile bool selftest_cancel_flag = false;
+static TaskHandle_t selftest_task_handle = NULL;
+
+// Idle-priority loop counter for CPU headroom
+static volatile uint32_t selftest_idle_count = 0;
+static volatile bool selftest_idle_run = false;
+static TaskHandle_t selftest_idle_handle = NULL;
+
+// Receiver frame state
+typedef struct {
+    uint8_t frame[LUCIDUART_SELFTEST_FRAME];
+    size_t fill;
+    uint16_t expect_seq;
+    bool synced;
+} selftest_rx_t;
+
+static uint32_t selftest_seed = 0;
+
+/**
+ * @brief Fill a frame's payload from its sequence number
+ *
+ * Both ends derive the payload from seq alone, so the receiver can
+ * check any frame it syncs to without replaying the stream.
+ */
+static void selftest_payload(uint16_t seq, uint8_t* out) {
+    uint32_t x = (seq * 0x9E3779B9u) ^ selftest_seed;
+    x |= 1;
+    for (int i = 0; i < SELFTEST_PAYLOAD; i += 4) {
+        // xorshift32
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        memcpy(out + i, &x, 4);
+    }
+}
+
+static void selftest_frame(uint16_t seq, uint8_t* out) {
+    out[0] = seq & 0xff;
+    out[1] = seq >> 8;
+    out[2] = ~out[0];
+    out[3] = ~out[1];
+    selftest_payload(seq, out + SELFTEST_HEADER);
+}
+
+/**
+ * @brief Feed received bytes through the frame checker
+ */
+static void selftest_verify(selftest_rx_t* rx, const uint8_t* data, size_t len,
+                            uart_selftest_result_t* result) {
+    uint8_t expected[SELFTEST_PAYLOAD];
+    
+    for (size_t i = 0; i < len; i++) {
+        rx->frame[rx->fill++] = data[i];
+        
+        if (rx->fill == SELFTEST_HEADER) {
+            if ((rx->frame[0] ^ rx->frame[2]) != 0xff || (rx->frame[1] ^ rx->frame[3]) != 0xff) {
+                // Not a header here: slide one byte and look again
+                memmove(rx->frame, rx->frame + 1, SELFTEST_HEADER - 1);
+                rx->fill = SELFTEST_HEADER - 1;
+                result->slips++;
+            }
+            continue;
+        }
+        if (rx->fill < LUCIDUART_SELFTEST_FRAME) {
+            continue;
+        }
+        
+        uint16_t seq = rx->frame[0] | (rx->frame[1] << 8);
+        if (rx->synced && seq != rx->expect_seq) {
+            uint16_t gap = seq - rx->expect_seq;
+            if (gap < 0x8000) {
+                result->frames_lost += gap;
+            }
+        }
+        
+        selftest_payload(seq, expected);
+        uint32_t errors = 0;
+        for (int b = 0; b < SELFTEST_PAYLOAD; b++) {
+            errors += (expected[b] != rx->frame[SELFTEST_HEADER + b]);
+        }
+        if (errors) {
+            result->frames_bad++;
+            result->byte_errors += errors;
+        } else {
+            result->frames_ok++;
+        }
+        
+        rx->expect_seq = seq + 1;
+        rx->synced = true;
+        rx->fill = 0;
+    }
+}
+
+/**
+ * @brief Idle-priority counter; its rate is the CPU time nothing else wants
+ */
+static void selftest_idle_task(void* pvParameters) {
+    while (selftest_idle_run) {
+        selftest_idle_count++;
+        taskYIELD();
+    }
+    selftest_idle_handle = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Read every cursor; the first one is verified, the rest drained
+ *
+ * @return Bytes the verifier consumed
+ */
+static size_t selftest_service(const uart_bridge_consumer_t* cursors, size_t count,
+                               selftest_rx_t* rx, uart_selftest_result_t* result) {
+    size_t verified = 0;
+    const uint8_t* data;
+    size_t len;
+    
+    while ((len = uart_bridge_consumer_peek(cursors[0], &data)) > 0) {
+        selftest_verify(rx, data, len, result);
+        uart_bridge_consumer_advance(cursors[0], len);
+        verified += len;
+    }
+    for (size_t c = 1; c < count; c++) {
+        while ((len = uart_bridge_consumer_peek(cursors[c], &data)) > 0) {
+            uart_bridge_consumer_advance(cursors[c], len);
+        }
+    }
+    return verified;
+}
+
+/**
+ * @brief Measure one case
+ */
+static void selftest_run_case(const uart_bridge_consumer_t* cursors, size_t count,
+                              uint16_t batch, uart_selftest_result_t* result) {
+    // Start from a quiet line and empty cursors
+    uart_bridge_tx_flush(pdMS_TO_TICKS(1000));
+    vTaskDelay(pdMS_TO_TICKS(20));
+    uart_bridge_purge(true, false);
+    uint32_t start_offset = uart_bridge_get_rx_offset();
+    for (size_t c = 0; c < count; c++) {
+        uart_bridge_consumer_seek(cursors[c], start_offset);
+    }
+    
+    selftest_rx_t rx = {0};
+    uint8_t tx_frame[LUCIDUART_SELFTEST_FRAME];
+    uint8_t tx_batch[1024];
+    uint16_t tx_seq = 0;
+    size_t tx_frame_pos = LUCIDUART_SELFTEST_FRAME;
+    bool batch_ready = false;
+    
+    uart_bridge_stats_t before;
+    uart_bridge_get_stats(&before);
+    uint32_t idle_before = selftest_idle_count;
+    int64_t start = esp_timer_get_time();
+    int64_t end = start + (int64_t)selftest_duration_ms * 1000;
+    int64_t now = start;
+    
+    while (now < end && !selftest_cancel_flag) {
+        if (!batch_ready) {
+            for (size_t i = 0; i < batch; i++) {
+                if (tx_frame_pos == LUCIDUART_SELFTEST_FRAME) {
+                    selftest_frame(tx_seq++, tx_frame);
+                    tx_frame_pos = 0;
+                }
+                tx_batch[i] = tx_frame[tx_frame_pos++];
+            }
+            batch_ready = true;
+        }
+        
+        // Keep the TX queue full without outrunning the RX ring
+        if (result->tx_bytes - result->rx_bytes + batch <= LUCIDUART_SELFTEST_WINDOW) {
+            if (uart_bridge_tx_submit(tx_batch, batch, 0, NULL, NULL) == ESP_OK) {
+                result->tx_bytes += batch;
+                batch_ready = false;
+            } else {
+                result->tx_stalls++;
+            }
+        }
+        
+        if (batch_ready) {
+            uart_bridge_consumer_wait_any(cursors, count, 1);
+        }
+        result->rx_bytes += selftest_service(cursors, count, &rx, result);
+        now = esp_timer_get_time();
+    }
+    
+    uint32_t elapsed_us = (uint32_t)(now - start);
+    uint32_t idle = selftest_idle_count - idle_before;
+    uint32_t measured_rx = result->rx_bytes;
+    uart_bridge_stats_t after;
+    uart_bridge_get_stats(&after);
+    
+    // Collect what is still on the wire, then count the rest as lost
+    int64_t quiet_since = esp_timer_get_time();
+    while (esp_timer_get_time() - quiet_since < SELFTEST_DRAIN_MS * 1000 && !selftest_cancel_flag) {
+        uart_bridge_consumer_wait_any(cursors, count, pdMS_TO_TICKS(20));
+        size_t got = selftest_service(cursors, count, &rx, result);
+        if (got) {
+            result->rx_bytes += got;
+            quiet_since = esp_timer_get_time();
+        }
+    }
+    
+    result->elapsed_ms = elapsed_us / 1000;
+    result->rx_bytes_per_sec = elapsed_us ? (uint32_t)((uint64_t)measured_rx * 1000000 / elapsed_us) : 0;
+    result->line_pct = result->rx_bytes_per_sec * 10 * 100 / result->baud;
+    result->lost_bytes = (result->tx_bytes > result->rx_bytes) ? result->tx_bytes - result->rx_bytes : 0;
+    result->uart_errors = after.rx_errors - before.rx_errors;
+    result->rx_events = after.rx_events - before.rx_events;
+    result->rx_events_per_sec = elapsed_us ? (uint32_t)((uint64_t)result->rx_events * 1000000 / elapsed_us) : 0;
+    if (selftest_status.idle_baseline && elapsed_us) {
+        uint32_t rate = (uint32_t)((uint64_t)idle * 1000000 / elapsed_us);
+        result->cpu_idle_pct = (uint32_t)((uint64_t)rate * 100 / selftest_status.idle_baseline);
+        if (result->cpu_idle_pct > 100) {
+            result->cpu_idle_pct = 100;
+        }
+    }
+    result->passed = result->frames_bad == 0 && result->frames_lost == 0 &&
+                     result->lost_bytes == 0 && result->slips == 0 && result->uart_errors == 0 &&
+                     result->frames_ok > 0;
+}
+
+/**
+ * @brief Self-test task - runs the sweep
+ */
+static void selftest_task(void* pvParameters) {
+    uart_bridge_config_t original;
+    uart_bridge_get_config(&original);
+    
+    // Measure idle headroom on the undisturbed system first
+    selftest_idle_run = true;
+    selftest_idle_count = 0;
+    if (xTaskCreate(selftest_idle_task, "selftest_idle", 1024, NULL,
+                    tskIDLE_PRIORITY, &selftest_idle_handle) == pdPASS) {
+        vTaskDelay(pdMS_TO_TICKS(SELFTEST_CALIBRATE_MS));
+        selftest_status.idle_baseline = selftest_idle_count * 1000 / SELFTEST_CALIBRATE_MS;
+    }
+    
+    flash_capture_set_paused(true);
+    uint32_t index = 0;
+    bool failed = false;
+    
+    for (size_t b = 0; b < selftest_baud_count && !selftest_cancel_flag && !failed; b++) {
+        uart_bridge_config_t config = original;
+        config.baud_rate = selftest_bauds[b];
+        config.xonxoff_enabled = false;     // Pattern bytes include 0x11/0x13
+        esp_err_t ret = uart_bridge_update_config(&config);
+        
+        for (size_t c = 0; c < selftest_consumer_count && !selftest_cancel_flag && !failed; c++) {
+            uart_bridge_consumer_t cursors[LUCIDUART_SELFTEST_MAX_CONSUMERS];
+            size_t opened = 0;
+            while (opened < selftest_consumers[c] &&
+                   uart_bridge_consumer_open("selftest", &cursors[opened]) == ESP_OK) {
+                opened++;
+            }
+            if (opened == 0) {
+                ESP_LOGE(TAG, "No RX cursor free");
+                failed = true;
+                break;
+            }
+            
+            for (size_t n = 0; n < selftest_batch_count && !selftest_cancel_flag; n++) {
+                uart_selftest_result_t* result = &selftest_results[index];
+                *result = (uart_selftest_result_t){
+                    .baud = selftest_bauds[b],
+                    .batch = selftest_batches[n],
+                    .consumers = opened,
+                };
+                // A rate the driver refused: record the case as failed
+                if (ret == ESP_OK) {
+                    selftest_run_case(cursors, opened, selftest_batches[n], result);
+                }
+                if (selftest_cancel_flag) {
+                    break;
+                }
+                
+                ESP_LOGI(TAG, "%u baud, %u-byte batches, %u cursors: %u B/s (%u%% of line), %s",
+                         result->baud, result->batch, result->consumers, result->rx_bytes_per_sec,
+                         result->line_pct, result->passed ? "pass" : "FAIL");
+                selftest_status.completed = ++index;
+            }
+            
+            for (size_t i = 0; i < opened; i++) {
+                uart_bridge_consumer_close(cursors[i]);
+            }
+        }
+    }
+    
+    uart_bridge_tx_flush(pdMS_TO_TICKS(1000));
+    uart_bridge_update_config(&original);
+    uart_bridge_purge(true, false);
+    flash_capture_set_paused(false);
+    selftest_idle_run = false;
+    
+    if (failed) {
+        selftest_status.state = UART_SELFTEST_FAILED;
+    } else {
+        selftest_status.state = selftest_cancel_flag ? UART_SELFTEST_CANCELLED : UART_SELFTEST_DONE;
+    }
+    ESP_LOGI(TAG, "Self-test ended after %u of %u cases",
+             selftest_status.completed, selftest_status.total);
+    selftest_task_handle = NULL;
+    vTaskDelete(NULL);
+}
+
+esp_err_t uart_selftest_start(const uart_selftest_params_t* params) {
+    if (!uart_bridge_is_active() || selftest_task_handle || selftest_idle_handle ||
+        uart_replay_active()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // Empty lists take the default sweep
+    uart_selftest_params_t sweep = params ? *params : (uart_selftest_params_t){0};
+    if (!sweep.baud_count) {
+        sweep.bauds = selftest_default_bauds;
+        sweep.baud_count = sizeof(selftest_default_bauds) / sizeof(selftest_default_bauds[0]);
+    }
+    if (!sweep.batch_count) {
+        sweep.batches = selftest_default_batches;
+        sweep.batch_count = sizeof(selftest_default_batches) / sizeof(selftest_default_batches[0]);
+    }
+    if (!sweep.consumer_count) {
+        sweep.consumers = selftest_default_consumers;
+        sweep.consumer_count = sizeof(selftest_default_consumers) / sizeof(selftest_default_consumers[0]);
+    }
+    params = &sweep;
+    
+    if (params->baud_count > LUCIDUART_SELFTEST_MAX_BAUDS ||
+        params->batch_count > LUCIDUART_SELFTEST_MAX_BATCHES || params->consumer_count > 2) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < params->baud_count; i++) {
+        if (params->bauds[i] < 300) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    for (size_t i = 0; i < params->batch_count; i++) {
+        if (params->batches[i] == 0 || params->batches[i] > 1024) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    for (size_t i = 0; i < params->consumer_count; i++) {
+        if (params->consumers[i] == 0 || params->consumers[i] > LUCIDUART_SELFTEST_MAX_CONSUMERS) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    
+    memcpy(selftest_bauds, params->bauds, params->baud_count * sizeof(uint32_t));
+    memcpy(selftest_batches, params->batches, params->batch_count * sizeof(uint16_t));
+    memcpy(selftest_consumers, params->consumers, params->consumer_count);
+    selftest_baud_count = params->baud_count;
+    selftest_batch_count = params->batch_count;
+    selftest_consumer_count = params->consumer_count;
+    selftest_duration_ms = params->duration_ms ? params->duration_ms : LUCIDUART_SELFTEST_DURATION_MS;
+    selftest_seed = (uint32_t)esp_timer_get_time();
+    
+    // The sweep owns the line; an auto-baud pass would fight over the rate
+    uart_bridge_autobaud_cancel();
+    
+    selftest_cancel_flag = false;
+    selftest_status = (uart_selftest_status_t){
+        .state = UART_SELFTEST_RUNNING,
+        .total = selftest_baud_count * selftest_batch_count * selftest_consumer_count,
+    };
+    
+    BaseType_t task_created = xTaskCreate(selftest_task, "selftest",
+                                          LUCIDUART_SELFTEST_TASK_STACK, NULL,
+                                          LUCIDUART_SELFTEST_TASK_PRIORITY,
+                                          &selftest_task_handle);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create self-test task");
+        selftest_status.state = UART_SELFTEST_FAILED;
+        return ESP_FAIL;
+    }
+    
+    ESP_LOGI(TAG, "Self-test started (%u cases, %u ms each) - TX must be jumpered to RX",
+             selftest_status.total, selftest_duration_ms);
+    return ESP_OK;
+}
+
+esp_err_t uart_selftest_cancel(void) {
+    if (!selftest_task_handle) {
+        return ESP_OK;
+    }
+    
+    // Wait for the sweep to restore the configuration
+    selftest_cancel_flag = true;
+    while (selftest_task_handle) {
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+    return ESP_OK;
+}
+
+esp_err_t uart_selftest_get_status(uart_selftest_status_t* status) {
+    if (!status) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *status = selftest_status;
+    return ESP_OK;
+}
+
+esp_err_t uart_selftest_get_result(uint32_t index, uart_selftest_result_t* result) {
+    if (!result) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (index >= selftest_status.completed) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *result = selftest_results[index];
+    return ESP_OK;
+}
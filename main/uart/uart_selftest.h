@@ -0,0 +1,129 @@
+/*
+ * UART Self-Test - LucidConsole Loopback Benchmark
+ * Sweeps rates, TX batch sizes and RX cursor counts over a TX-RX jumper
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sweep limits
+#define LUCIDUART_SELFTEST_MAX_BAUDS        8
+#define LUCIDUART_SELFTEST_MAX_BATCHES      4
+#define LUCIDUART_SELFTEST_MAX_CONSUMERS    4       // RX cursors per case, verifier included
+#define LUCIDUART_SELFTEST_MAX_RESULTS      (LUCIDUART_SELFTEST_MAX_BAUDS * LUCIDUART_SELFTEST_MAX_BATCHES * 2)
+#define LUCIDUART_SELFTEST_DURATION_MS      1500    // Default measuring time per case
+#define LUCIDUART_SELFTEST_FRAME            64      // Pattern frame: 4-byte seq header + PRNG payload
+#define LUCIDUART_SELFTEST_WINDOW           4096    // Max bytes sent but not yet received
+#define LUCIDUART_SELFTEST_TASK_PRIORITY    4       // Below the UART task (5)
+#define LUCIDUART_SELFTEST_TASK_STACK       3072
+
+// Self-test state
+typedef enum {
+    UART_SELFTEST_IDLE = 0,             // Never started
+    UART_SELFTEST_RUNNING,
+    UART_SELFTEST_DONE,
+    UART_SELFTEST_CANCELLED,            // Stopped by uart_selftest_cancel()
+    UART_SELFTEST_FAILED,               // Could not set up (no RX cursor free)
+} uart_selftest_state_t;
+
+// Sweep definition; the test runs every combination
+typedef struct {
+    const uint32_t* bauds;      // An empty list takes the default
+    size_t baud_count;
+    const uint16_t* batches;    // Bytes per TX submission
+    size_t batch_count;
+    const uint8_t* consumers;   // RX cursors reading the stream
+    size_t consumer_count;
+    uint32_t duration_ms;       // Measuring time per case, 0 for the default
+} uart_selftest_params_t;
+
+// One measured case
+typedef struct {
+    uint32_t baud;
+    uint16_t batch;
+    uint8_t consumers;          // Cursors actually opened
+    bool passed;                // No corrupted, lost or slipped bytes
+    uint32_t elapsed_ms;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint32_t rx_bytes_per_sec;  // Sustained over the measuring time
+    uint32_t line_pct;          // rx_bytes_per_sec against baud / 10
+    uint32_t frames_ok;
+    uint32_t frames_bad;        // Frames with corrupted payload bytes
+    uint32_t frames_lost;       // Gaps in the frame sequence
+    uint32_t byte_errors;       // Corrupted payload bytes
+    uint32_t slips;             // Bytes skipped to regain frame sync
+    uint32_t lost_bytes;        // Sent but never received after draining
+    uint32_t uart_errors;       // Frame, parity and overflow events
+    uint32_t rx_events;         // UART_DATA events (one per RX interrupt batch)
+    uint32_t rx_events_per_sec;
+    uint32_t tx_stalls;         // Submissions refused by a full TX queue
+    uint32_t cpu_idle_pct;      // Idle-priority time left, against the baseline
+} uart_selftest_result_t;
+
+// Self-test status
+typedef struct {
+    uart_selftest_state_t state;
+    uint32_t total;             // Cases in the sweep
+    uint32_t completed;         // Results available
+    uint32_t idle_baseline;     // Idle loop iterations per second before the sweep
+} uart_selftest_status_t;
+
+/**
+ * @brief Start a loopback self-test
+ *
+ * Needs a jumper from TX to RX; the target must be disconnected. Runs
+ * in a background task: for each case, sends framed deterministic PRNG
+ * data through the TX queue, verifies it on its own RX cursor (extra
+ * cursors just drain, as network clients would), and records sustained
+ * throughput, frame errors and losses, UART error and interrupt counts
+ * and the CPU time left at idle priority. Flow control and auto-baud are
+ * off during the test, flash capture is paused, and the original
+ * configuration is restored afterwards. Previous results are cleared.
+ *
+ * @param params Sweep, or NULL; empty lists default to 115200-2000000
+ *               baud, batches of 32, 256 and 1024 bytes, 1 and 4 cursors
+ * @return ESP_OK if the test started, ESP_ERR_INVALID_STATE if the bridge
+ *         is not running or a test or replay is running, ESP_ERR_INVALID_ARG on an
+ *         oversized sweep or out-of-range value
+ */
+esp_err_t uart_selftest_start(const uart_selftest_params_t* params);
+
+/**
+ * @brief Stop a running self-test
+ *
+ * Returns once the current case has been abandoned and the original
+ * configuration restored.
+ *
+ * @return ESP_OK (also if no test was running)
+ */
+esp_err_t uart_selftest_cancel(void);
+
+/**
+ * @brief Get self-test status
+ *
+ * @param status Pointer to status structure to fill
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG if status is NULL
+ */
+esp_err_t uart_selftest_get_status(uart_selftest_status_t* status);
+
+/**
+ * @brief Get one case result
+ *
+ * @param index Result index, below uart_selftest_status_t.completed
+ * @param result Receives the result
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if not measured yet
+ */
+esp_err_t uart_selftest_get_result(uint32_t index, uart_selftest_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,163 @@
+function updateStatus() {
+  fetch('/api/status')
+    .then(response => response.json())
+    .then(data => {
+      document.getElementById('uptime').textContent = data.uptime_sec + 's';
+      document.getElementById('memory').textContent = Math.round(data.free_heap/1024) + 'KB';
+      document.getElementById('wifi-mode').textContent = data.wifi_mode;
+      document.getElementById('wifi-ssid').textContent = data.ssid;
+      document.getElementById('ip-address').textContent = data.ip_address;
+      document.getElementById('uart-rx').textContent = data.uart_rx_count;
+      document.getElementById('uart-tx').textContent = data.uart_tx_count;
+      document.getElementById('uart-baud').textContent = data.uart_baud_rate +
+        (data.uart_autobaud === 'running' ? ' (detecting)' : data.uart_autobaud === 'locked' ? ' (auto)' : '');
+      if(data.wifi_mode === 'AP') {
+        document.getElementById('wifi-signal').textContent = data.client_count + ' clients';
+      } else {
+        document.getElementById('wifi-signal').textContent = data.rssi + 'dBm';
+      }
+    })
+    .catch(err => console.log('Status update failed:', err));
+}
+
+function connectWiFi() {
+  const ssid = document.getElementById('ssid-input').value;
+  const password = document.getElementById('password-input').value;
+  if(!ssid) { alert('Please enter SSID'); return; }
+  fetch('/api/wifi/connect', {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify({ ssid: ssid, password: password })
+  })
+  .then(response => response.json())
+  .then(data => {
+    alert(data.message || 'Connection initiated');
+    setTimeout(updateStatus, 2000);
+  })
+  .catch(err => alert('Connection failed: ' + err));
+}
+
+function resetToAP() {
+  if(confirm('Reset WiFi to AP mode?')) {
+    fetch('/api/wifi/reset', { method: 'POST' })
+    .then(response => response.json())
+    .then(data => {
+      alert(data.message || 'Reset to AP mode');
+      setTimeout(updateStatus, 2000);
+    })
+    .catch(err => alert('Reset failed: ' + err));
+  }
+}
+
+function refreshStatus() {
+  updateStatus();
+}
+
+// Terminal functions
+let eventSource = null;
+let lastEventId = null;
+
+function initTerminal() {
+  if(eventSource) eventSource.close();
+  // Resume from the last received stream offset to replay missed bytes
+  const url = lastEventId !== null ? '/api/uart/stream?since=' + lastEventId : '/api/uart/stream';
+  eventSource = new EventSource(url);
+
+  eventSource.onmessage = function(event) {
+    if(event.lastEventId) lastEventId = event.lastEventId;
+    try {
+      const data = JSON.parse(event.data);
+      if(data.uart_b64) {
+        // Decode Base64 UART data
+        let decoded = atob(data.uart_b64);
+        // Device line stamps: [offset in chunk, esp_timer us]
+        if(data.ts) {
+          for(let i = data.ts.length - 1; i >= 0; i--) {
+            const at = data.ts[i][0];
+            decoded = decoded.slice(0, at) + '[' + (data.ts[i][1] / 1e6).toFixed(3) + '] ' + decoded.slice(at);
+          }
+        }
+        appendToTerminal(decoded, 'rx');
+      }
+      if(data.connected) {
+        appendToTerminal(data.resumed ? '[Resumed UART stream]\n' : '[Connected to UART stream]\n', 'system');
+        if(data.lost) appendToTerminal('[' + data.lost + ' bytes aged out of scrollback]\n', 'system');
+      }
+    } catch(e) {
+      console.error('SSE parse error:', e);
+    }
+  };
+
+  // On-device trigger matches (POST /api/triggers to set patterns)
+  eventSource.addEventListener('trigger', function(event) {
+    const t = JSON.parse(event.data);
+    appendToTerminal('[trigger ' + t.pattern + ' @' + t.offset + ']\n', 'system');
+  });
+
+  eventSource.onerror = function(err) {
+    console.error('SSE error:', err);
+    appendToTerminal('[Stream disconnected]\n', 'system');
+    setTimeout(initTerminal, 5000);  // Reconnect after 5s
+  };
+}
+
+function appendToTerminal(text, type) {
+  const terminal = document.getElementById('terminal');
+  const timestamp = new Date().toLocaleTimeString();
+  let prefix = '';
+
+  if(type === 'tx') {
+    prefix = '> ';
+  } else if(type === 'rx') {
+    prefix = '';
+  } else if(type === 'system') {
+    prefix = '* ';
+  }
+
+  terminal.textContent += prefix + text;
+  terminal.scrollTop = terminal.scrollHeight;
+}
+
+function sendUartCommand() {
+  const input = document.getElementById('uart-input');
+  const cmd = input.value;
+  if(!cmd) return;
+
+  // Add newline if not present
+  const dataToSend = cmd.endsWith('\n') ? cmd : cmd + '\n';
+
+  fetch('/api/uart/send', {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: JSON.stringify({ data: dataToSend })
+  })
+  .then(response => response.json())
+  .then(data => {
+    if(data.status === 'sent') {
+      appendToTerminal(dataToSend, 'tx');
+      input.value = '';
+    } else {
+      appendToTerminal('[Send failed: ' + (data.error || 'Unknown error') + ']\n', 'system');
+    }
+  })
+  .catch(err => {
+    console.error('Send error:', err);
+    appendToTerminal('[Send error: ' + err + ']\n', 'system');
+  });
+}
+
+function clearTerminal() {
+  document.getElementById('terminal').textContent = '';
+  appendToTerminal('[Terminal cleared]\n', 'system');
+}
+
+// Auto-refresh status every 5 seconds
+setInterval(updateStatus, 5000);
+updateStatus();
+
+// Initialize terminal on load
+window.addEventListener('load', function() {
+  initTerminal();
+  appendToTerminal('[LucidConsole Serial Terminal]\n', 'system');
+  appendToTerminal('[Type commands and press Enter to send]\n\n', 'system');
+});
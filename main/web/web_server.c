@@ -6,14 +6,25 @@
 #include "web_server.h"
 #include "../wifi/wifi_manager.h"
 #include "../uart/uart_bridge.h"
+#include "../uart/uart_latency.h"
+#include "../uart/trigger_engine.h"
+#include "../uart/lz_history.h"
+#include "../uart/flash_capture.h"
+#include "../uart/uart_selftest.h"
+#include "../uart/uart_replay.h"
+#include "dashboard_assets.h"
 #include "esp_log.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 #include "cJSON.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "freertos/semphr.h"
 #include "mbedtls/base64.h"
+#include "lwip/sockets.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
 
 // ESP8266 compatibility defines
 #ifndef MIN
@@ -30,260 +41,75 @@ static uint32_t (*uart_rx_callback)(void) = NULL;
 static uint32_t (*uart_tx_callback)(void) = NULL;
 
 // SSE client management
-#define MAX_SSE_CLIENTS 4
-static httpd_req_t* sse_clients[MAX_SSE_CLIENTS] = {0};
+// Stream handlers hand their socket over to the fan-out task and return,
+// so the httpd worker is never pinned by a streaming client.
+#define SSE_B64_MAX     (((LUCIDUART_SSE_CHUNK_MAX + 2) / 3) * 4 + 1)
+#define SSE_STAMPS_MAX  (LUCIDUART_SSE_MAX_STAMPS * 28 + 8)  // ,"ts":[[off,us],...]
+#define SSE_FRAME_MAX   (SSE_B64_MAX + SSE_STAMPS_MAX + 96)
+
+typedef struct {
+    bool in_use;
+    bool closing;                   // Close requested, waiting for httpd
+    int fd;                         // Session socket
+    uart_bridge_consumer_t cursor;  // Own RX ring cursor
+    web_sse_policy_t policy;
+    uint32_t block_timeout_ms;
+    bool blocked;                   // Socket full under WEB_SSE_BLOCK_TIMEOUT...
+    TickType_t blocked_since;       // ...since this tick, with no byte sent
+    uint32_t last_overruns;         // Cursor overruns already reported
+    bool replaying;                 // Catching up from scrollback
+    TickType_t last_send;           // For idle heartbeats
+    size_t frame_len;               // Pending chunk-encoded frame
+    size_t frame_sent;
+    bool frame_timed;               // Frame carries live data to record latency for
+    uint32_t frame_offset;          // RX stream offset of the frame's first byte
+    uint32_t trigger_seq;           // Last trigger event sent
+    uint32_t history_pos;           // Resume replay from compressed history...
+    uint32_t history_end;           // ...up to where the ring cursor starts
+    char frame[SSE_FRAME_MAX];
+} sse_client_t;
+
+static sse_client_t sse_clients[LUCIDUART_SSE_MAX_CLIENTS];
 static SemaphoreHandle_t sse_mutex = NULL;
+static TaskHandle_t sse_task_handle = NULL;
+static web_sse_policy_t sse_default_policy = WEB_SSE_DROP_OLDEST;
+static uint32_t sse_default_timeout_ms = LUCIDUART_SSE_BLOCK_TIMEOUT_MS;
 
-// HTML Dashboard Content
-static const char* html_dashboard = 
-"<!DOCTYPE html>"
-"<html>"
-"<head>"
-"<meta charset='UTF-8'>"
-"<meta name='viewport' content='width=device-width, initial-scale=1.0'>"
-"<title>LucidConsole Dashboard</title>"
-"<style>"
-"body { font-family: 'Courier New', monospace; background: #0a0a0a; color: #00ff00; margin: 0; padding: 20px; }"
-".container { max-width: 800px; margin: 0 auto; background: #1a1a1a; padding: 20px; border: 2px solid #00ff00; border-radius: 8px; }"
-".header { text-align: center; margin-bottom: 30px; }"
-".title { font-size: 2em; color: #00ffff; text-shadow: 0 0 10px #00ffff; margin-bottom: 10px; }"
-".subtitle { color: #ffff00; }"
-".section { margin: 20px 0; padding: 15px; border: 1px solid #333; background: #111; }"
-".section-title { color: #00ffff; font-size: 1.2em; margin-bottom: 10px; border-bottom: 1px solid #333; padding-bottom: 5px; }"
-".status-grid { display: grid; grid-template-columns: 1fr 1fr; gap: 15px; }"
-".status-item { background: #222; padding: 10px; border-left: 3px solid #00ff00; }"
-".status-label { color: #888; font-size: 0.9em; }"
-".status-value { color: #00ff00; font-weight: bold; font-size: 1.1em; }"
-".button { background: #003300; color: #00ff00; border: 1px solid #00ff00; padding: 8px 16px; cursor: pointer; margin: 5px; }"
-".button:hover { background: #004400; }"
-".wifi-form { background: #222; padding: 15px; margin: 10px 0; }"
-".form-group { margin: 10px 0; }"
-".form-label { display: block; color: #888; margin-bottom: 5px; }"
-".form-input { width: 100%; padding: 8px; background: #333; color: #00ff00; border: 1px solid #555; }"
-"#refresh-btn { position: fixed; top: 20px; right: 20px; }"
-"</style>"
-"</head>"
-"<body>"
-"<div class='container'>"
-"<div class='header'>"
-"<div class='title'>🛰️ LucidConsole</div>"
-"<div class='subtitle'>ESP8266 WiFi-to-UART Bridge</div>"
-"</div>"
-
-"<div class='section'>"
-"<div class='section-title'>📊 System Status</div>"
-"<div class='status-grid' id='system-status'>"
-"<div class='status-item'><div class='status-label'>Uptime</div><div class='status-value' id='uptime'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>Free Memory</div><div class='status-value' id='memory'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>Firmware</div><div class='status-value' id='firmware'>v1.0</div></div>"
-"<div class='status-item'><div class='status-label'>Chip Model</div><div class='status-value' id='chip'>ESP8266</div></div>"
-"</div>"
-"</div>"
-
-"<div class='section'>"
-"<div class='section-title'>📡 WiFi Status</div>"
-"<div class='status-grid' id='wifi-status'>"
-"<div class='status-item'><div class='status-label'>Mode</div><div class='status-value' id='wifi-mode'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>SSID</div><div class='status-value' id='wifi-ssid'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>IP Address</div><div class='status-value' id='ip-address'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>Signal/Clients</div><div class='status-value' id='wifi-signal'>Loading...</div></div>"
-"</div>"
-"</div>"
-
-"<div class='section'>"
-"<div class='section-title'>🔧 WiFi Configuration</div>"
-"<div class='wifi-form'>"
-"<div class='form-group'>"
-"<label class='form-label' for='ssid-input'>Network SSID:</label>"
-"<input type='text' id='ssid-input' class='form-input' placeholder='Enter WiFi network name'>"
-"</div>"
-"<div class='form-group'>"
-"<label class='form-label' for='password-input'>Password:</label>"
-"<input type='password' id='password-input' class='form-input' placeholder='Enter WiFi password'>"
-"</div>"
-"<button class='button' onclick='connectWiFi()'>Connect to Network</button>"
-"<button class='button' onclick='resetToAP()'>Reset to AP Mode</button>"
-"</div>"
-"</div>"
-
-"<div class='section'>"
-"<div class='section-title'>🔌 UART Bridge Status</div>"
-"<div class='status-grid' id='uart-status'>"
-"<div class='status-item'><div class='status-label'>RX Bytes</div><div class='status-value' id='uart-rx'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>TX Bytes</div><div class='status-value' id='uart-tx'>Loading...</div></div>"
-"<div class='status-item'><div class='status-label'>Baud Rate</div><div class='status-value' id='uart-baud'>115200</div></div>"
-"<div class='status-item'><div class='status-label'>Bridge Status</div><div class='status-value' id='uart-active'>Active</div></div>"
-"</div>"
-"</div>"
-
-"<div class='section'>"
-"<div class='section-title'>💻 Serial Terminal</div>"
-"<div id='terminal' style='background:#000;color:#0f0;font-family:monospace;padding:10px;height:200px;overflow-y:auto;border:1px solid #0f0;margin-bottom:10px;white-space:pre-wrap;word-wrap:break-word;'></div>"
-"<div style='display:flex;'>"
-"<input type='text' id='uart-input' style='flex:1;padding:8px;background:#333;color:#0f0;border:1px solid #555;font-family:monospace;' placeholder='Enter command and press Enter' onkeypress='if(event.key===\"Enter\")sendUartCommand()'>"
-"<button class='button' onclick='sendUartCommand()'>Send</button>"
-"<button class='button' onclick='clearTerminal()'>Clear</button>"
-"</div>"
-"</div>"
-
-"</div>"
-
-"<button id='refresh-btn' class='button' onclick='refreshStatus()'>🔄 Refresh</button>"
-
-"<script>"
-"function updateStatus() {"
-"  fetch('/api/status')"
-"    .then(response => response.json())"
-"    .then(data => {"
-"      document.getElementById('uptime').textContent = data.uptime_sec + 's';"
-"      document.getElementById('memory').textContent = Math.round(data.free_heap/1024) + 'KB';"
-"      document.getElementById('wifi-mode').textContent = data.wifi_mode;"
-"      document.getElementById('wifi-ssid').textContent = data.ssid;"
-"      document.getElementById('ip-address').textContent = data.ip_address;"
-"      document.getElementById('uart-rx').textContent = data.uart_rx_count;"
-"      document.getElementById('uart-tx').textContent = data.uart_tx_count;"
-"      if(data.wifi_mode === 'AP') {"
-"        document.getElementById('wifi-signal').textContent = data.client_count + ' clients';"
-"      } else {"
-"        document.getElementById('wifi-signal').textContent = data.rssi + 'dBm';"
-"      }"
-"    })"
-"    .catch(err => console.log('Status update failed:', err));"
-"}"
-
-"function connectWiFi() {"
-"  const ssid = document.getElementById('ssid-input').value;"
-"  const password = document.getElementById('password-input').value;"
-"  if(!ssid) { alert('Please enter SSID'); return; }"
-"  fetch('/api/wifi/connect', {"
-"    method: 'POST',"
-"    headers: { 'Content-Type': 'application/json' },"
-"    body: JSON.stringify({ ssid: ssid, password: password })"
-"  })"
-"  .then(response => response.json())"
-"  .then(data => {"
-"    alert(data.message || 'Connection initiated');"
-"    setTimeout(updateStatus, 2000);"
-"  })"
-"  .catch(err => alert('Connection failed: ' + err));"
-"}"
-
-"function resetToAP() {"
-"  if(confirm('Reset WiFi to AP mode?')) {"
-"    fetch('/api/wifi/reset', { method: 'POST' })"
-"    .then(response => response.json())"
-"    .then(data => {"
-"      alert(data.message || 'Reset to AP mode');"
-"      setTimeout(updateStatus, 2000);"
-"    })"
-"    .catch(err => alert('Reset failed: ' + err));"
-"  }"
-"}"
-
-"function refreshStatus() {"
-"  updateStatus();"
-"}"
-
-"// Terminal functions"
-"let eventSource = null;"
-
-"function initTerminal() {"
-"  if(eventSource) eventSource.close();"
-"  eventSource = new EventSource('/api/uart/stream');"
-"  "
-"  eventSource.onmessage = function(event) {"
-"    try {"
-"      const data = JSON.parse(event.data);"
-"      if(data.uart_b64) {"
-"        // Decode Base64 UART data"
-"        const decoded = atob(data.uart_b64);"
-"        appendToTerminal(decoded, 'rx');"
-"      }"
-"      if(data.connected) {"
-"        appendToTerminal('[Connected to UART stream]\\n', 'system');"
-"      }"
-"    } catch(e) {"
-"      console.error('SSE parse error:', e);"
-"    }"
-"  };"
-"  "
-"  eventSource.onerror = function(err) {"
-"    console.error('SSE error:', err);"
-"    appendToTerminal('[Stream disconnected]\\n', 'system');"
-"    setTimeout(initTerminal, 5000);  // Reconnect after 5s"
-"  };"
-"}"
-
-"function appendToTerminal(text, type) {"
-"  const terminal = document.getElementById('terminal');"
-"  const timestamp = new Date().toLocaleTimeString();"
-"  let prefix = '';"
-"  "
-"  if(type === 'tx') {"
-"    prefix = '> ';"
-"  } else if(type === 'rx') {"
-"    prefix = '';"
-"  } else if(type === 'system') {"
-"    prefix = '* ';"
-"  }"
-"  "
-"  terminal.textContent += prefix + text;"
-"  terminal.scrollTop = terminal.scrollHeight;"
-"}"
-
-"function sendUartCommand() {"
-"  const input = document.getElementById('uart-input');"
-"  const cmd = input.value;"
-"  if(!cmd) return;"
-"  "
-"  // Add newline if not present"
-"  const dataToSend = cmd.endsWith('\\n') ? cmd : cmd + '\\n';"
-"  "
-"  fetch('/api/uart/send', {"
-"    method: 'POST',"
-"    headers: { 'Content-Type': 'application/json' },"
-"    body: JSON.stringify({ data: dataToSend })"
-"  })"
-"  .then(response => response.json())"
-"  .then(data => {"
-"    if(data.status === 'sent') {"
-"      appendToTerminal(dataToSend, 'tx');"
-"      input.value = '';"
-"    } else {"
-"      appendToTerminal('[Send failed: ' + (data.error || 'Unknown error') + ']\\n', 'system');"
-"    }"
-"  })"
-"  .catch(err => {"
-"    console.error('Send error:', err);"
-"    appendToTerminal('[Send error: ' + err + ']\\n', 'system');"
-"  });"
-"}"
-
-"function clearTerminal() {"
-"  document.getElementById('terminal').textContent = '';"
-"  appendToTerminal('[Terminal cleared]\\n', 'system');"
-"}"
-
-"// Auto-refresh status every 5 seconds"
-"setInterval(updateStatus, 5000);"
-"updateStatus();"
-
-"// Initialize terminal on load"
-"window.addEventListener('load', function() {"
-"  initTerminal();"
-"  appendToTerminal('[LucidConsole Serial Terminal]\\n', 'system');"
-"  appendToTerminal('[Type commands and press Enter to send]\\n\\n', 'system');"
-"});"
-"</script>"
-"</body>"
-"</html>";
-
-/**
- * @brief Root handler - serves dashboard HTML
+/**
+ * @brief Root handler - serves the pre-gzipped dashboard page
+ * 
+ * The page is built from main/web/dashboard by scripts/gen_dashboard.py.
+ * It lives at a fixed URL, so browsers revalidate it on every load; a
+ * firmware with another page has another ETag, and a match costs a 304
+ * with no body. Only the gzip copy is in flash, so a client that does
+ * not accept gzip gets a 406.
  */
 static esp_err_t dashboard_handler(httpd_req_t *req) {
+    httpd_resp_set_hdr(req, "ETag", LUCIDUART_DASHBOARD_ETAG);
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+    
+    // A truncated list still holds the encodings that came first
+    char encodings[64];
+    esp_err_t ret = httpd_req_get_hdr_value_str(req, "Accept-Encoding", encodings, sizeof(encodings));
+    if ((ret != ESP_OK && ret != ESP_ERR_HTTPD_RESULT_TRUNC) || !strstr(encodings, "gzip")) {
+        httpd_resp_set_status(req, "406 Not Acceptable");
+        httpd_resp_set_type(req, "text/plain");
+        httpd_resp_send(req, "The dashboard is served gzip-compressed only (Accept-Encoding: gzip)\n", -1);
+        return ESP_OK;
+    }
+    
+    char match[80];
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", match, sizeof(match)) == ESP_OK &&
+        (strstr(match, LUCIDUART_DASHBOARD_ETAG) || strcmp(match, "*") == 0)) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        httpd_resp_send(req, NULL, 0);
+        return ESP_OK;
+    }
+    
     httpd_resp_set_type(req, "text/html");
-    httpd_resp_send(req, html_dashboard, strlen(html_dashboard));
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    httpd_resp_send(req, (const char*)dashboard_gz, LUCIDUART_DASHBOARD_GZ_LEN);
     return ESP_OK;
 }
 
@@ -312,6 +138,8 @@ static esp_err_t api_status_handler(httpd_req_t *req) {
     cJSON *uart_tx = cJSON_CreateNumber(status.uart_tx_count);
     cJSON *uart_baud = cJSON_CreateNumber(status.uart_baud_rate);
     cJSON *uart_active = cJSON_CreateBool(status.uart_bridge_active);
+    cJSON *uart_autobaud = cJSON_CreateString(status.uart_autobaud);
+    cJSON *uart_autobaud_score = cJSON_CreateNumber(status.uart_autobaud_score);
     
     cJSON_AddItemToObject(json, "uptime_sec", uptime);
     cJSON_AddItemToObject(json, "free_heap", free_heap);
@@ -326,6 +154,8 @@ static esp_err_t api_status_handler(httpd_req_t *req) {
     cJSON_AddItemToObject(json, "uart_tx_count", uart_tx);
     cJSON_AddItemToObject(json, "uart_baud_rate", uart_baud);
     cJSON_AddItemToObject(json, "uart_bridge_active", uart_active);
+    cJSON_AddItemToObject(json, "uart_autobaud", uart_autobaud);
+    cJSON_AddItemToObject(json, "uart_autobaud_score", uart_autobaud_score);
     
     const char *json_string = cJSON_Print(json);
     httpd_resp_set_type(req, "application/json");
@@ -336,6 +166,289 @@ static esp_err_t api_status_handler(httpd_req_t *req) {
     return ESP_OK;
 }
 
+/**
+ * @brief Add a rate meter as {"1s":..,"10s":..,"60s":..,"peak":..}
+ */
+static void stats_add_rate(cJSON* parent, const char* name, const uart_bridge_rate_t* rate) {
+    cJSON* meter = cJSON_CreateObject();
+    cJSON_AddNumberToObject(meter, "1s", rate->rate_1s);
+    cJSON_AddNumberToObject(meter, "10s", rate->rate_10s);
+    cJSON_AddNumberToObject(meter, "60s", rate->rate_60s);
+    cJSON_AddNumberToObject(meter, "peak", rate->peak_1s);
+    cJSON_AddItemToObject(parent, name, meter);
+}
+
+/**
+ * @brief API UART stats endpoint - counters, rate meters, errors, cursors
+ */
+static esp_err_t api_uart_stats_handler(httpd_req_t *req) {
+    uart_bridge_stats_t stats;
+    if (uart_bridge_get_stats(&stats) != ESP_OK) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddNumberToObject(json, "uptime_sec", stats.bridge_uptime);
+    cJSON_AddNumberToObject(json, "baud", stats.current_baud);
+    
+    // 64-bit totals are exact in a JSON double up to 2^53
+    cJSON *rx = cJSON_CreateObject();
+    cJSON_AddNumberToObject(rx, "bytes", stats.rx_bytes);
+    cJSON_AddNumberToObject(rx, "events", stats.rx_events);
+    cJSON_AddNumberToObject(rx, "events_per_sec", stats.rx_events_per_sec);
+    cJSON_AddNumberToObject(rx, "bytes_per_event", stats.rx_bytes_per_event);
+    cJSON_AddNumberToObject(rx, "lines", stats.rx_lines);
+    stats_add_rate(rx, "rate", &stats.rx_rate);
+    cJSON_AddItemToObject(json, "rx", rx);
+    
+    cJSON *tx = cJSON_CreateObject();
+    cJSON_AddNumberToObject(tx, "bytes", stats.tx_bytes);
+    cJSON_AddNumberToObject(tx, "backlog", uart_bridge_get_tx_backlog());
+    cJSON_AddNumberToObject(tx, "queued", stats.tx_queued);
+    cJSON_AddNumberToObject(tx, "messages", stats.tx_messages);
+    cJSON_AddNumberToObject(tx, "queue_full", stats.tx_queue_full);
+    stats_add_rate(tx, "rate", &stats.tx_rate);
+    cJSON_AddItemToObject(json, "tx", tx);
+    
+    cJSON *errors = cJSON_CreateObject();
+    cJSON_AddNumberToObject(errors, "rx_total", stats.rx_errors);
+    cJSON_AddNumberToObject(errors, "fifo_overflow", stats.rx_fifo_overflows);
+    cJSON_AddNumberToObject(errors, "buffer_full", stats.rx_buffer_full);
+    cJSON_AddNumberToObject(errors, "frame", stats.rx_frame_errors);
+    cJSON_AddNumberToObject(errors, "parity", stats.rx_parity_errors);
+    cJSON_AddNumberToObject(errors, "tx", stats.tx_errors);
+    cJSON_AddItemToObject(json, "errors", errors);
+    
+    cJSON *flow = cJSON_CreateObject();
+    cJSON_AddBoolToObject(flow, "rx_throttled", stats.flow_rx_throttled);
+    cJSON_AddBoolToObject(flow, "tx_paused", stats.flow_tx_paused);
+    cJSON_AddNumberToObject(flow, "xoff_sent", stats.flow_xoff_sent);
+    cJSON_AddNumberToObject(flow, "xoff_received", stats.flow_xoff_received);
+    cJSON_AddNumberToObject(flow, "rx_throttled_ms", stats.flow_rx_throttled_ms);
+    cJSON_AddNumberToObject(flow, "tx_paused_ms", stats.flow_tx_paused_ms);
+    cJSON_AddItemToObject(json, "flow", flow);
+    
+    cJSON *reconfig = cJSON_CreateObject();
+    cJSON_AddNumberToObject(reconfig, "count", stats.reconfigs);
+    cJSON_AddNumberToObject(reconfig, "last_us", stats.reconfig_last_us);
+    cJSON_AddNumberToObject(reconfig, "max_us", stats.reconfig_max_us);
+    cJSON_AddItemToObject(json, "reconfig", reconfig);
+    
+    lz_history_stats_t hstats;
+    lz_history_get_stats(&hstats);
+    cJSON *history = cJSON_CreateObject();
+    cJSON_AddNumberToObject(history, "oldest_offset", hstats.oldest_offset);
+    cJSON_AddNumberToObject(history, "end_offset", hstats.end_offset);
+    cJSON_AddNumberToObject(history, "raw_bytes", hstats.raw_bytes);
+    cJSON_AddNumberToObject(history, "stored_bytes", hstats.stored_bytes);
+    cJSON_AddNumberToObject(history, "blocks", hstats.blocks);
+    cJSON_AddNumberToObject(history, "evicted_blocks", hstats.evicted_blocks);
+    cJSON_AddNumberToObject(history, "ratio", hstats.ratio_x100 / 100.0);
+    cJSON_AddItemToObject(json, "history", history);
+    
+    flash_capture_stats_t capstats;
+    flash_capture_get_stats(&capstats);
+    cJSON *capture = cJSON_CreateObject();
+    cJSON_AddBoolToObject(capture, "enabled", capstats.segments > 0);
+    cJSON_AddNumberToObject(capture, "boot", capstats.boot);
+    cJSON_AddNumberToObject(capture, "segments", capstats.segments);
+    cJSON_AddNumberToObject(capture, "segment_size", capstats.segment_size);
+    cJSON_AddNumberToObject(capture, "oldest_seq", capstats.oldest_seq);
+    cJSON_AddNumberToObject(capture, "head_seq", capstats.head_seq);
+    cJSON_AddNumberToObject(capture, "head_bytes", capstats.head_bytes);
+    cJSON_AddNumberToObject(capture, "bytes_written", capstats.bytes_written);
+    cJSON_AddNumberToObject(capture, "records", capstats.records);
+    cJSON_AddNumberToObject(capture, "sector_erases", capstats.sector_erases);
+    cJSON_AddNumberToObject(capture, "write_errors", capstats.write_errors);
+    cJSON_AddItemToObject(json, "capture", capture);
+    
+    // One entry per open RX ring cursor (SSE, TCP, RFC 2217, auto-baud)
+    cJSON *consumers = cJSON_CreateArray();
+    for (int i = 0; i < LUCIDUART_MAX_CONSUMERS; i++) {
+        uart_bridge_consumer_stats_t cstats;
+        if (uart_bridge_consumer_get_stats(i, &cstats) != ESP_OK) {
+            continue;
+        }
+        cJSON *consumer = cJSON_CreateObject();
+        cJSON_AddStringToObject(consumer, "name", cstats.name);
+        cJSON_AddNumberToObject(consumer, "pending", cstats.pending);
+        cJSON_AddNumberToObject(consumer, "overruns", cstats.overruns);
+        cJSON_AddNumberToObject(consumer, "dropped", cstats.dropped_bytes);
+        cJSON_AddNumberToObject(consumer, "batches", cstats.batches);
+        cJSON_AddNumberToObject(consumer, "max_batch", cstats.max_batch);
+        cJSON_AddItemToArray(consumers, consumer);
+    }
+    cJSON_AddItemToObject(json, "consumers", consumers);
+    
+    const char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    free((void *)json_string);
+    cJSON_Delete(json);
+    return ESP_OK;
+}
+
+/**
+ * @brief API UART history endpoint - download compressed scrollback
+ * 
+ * GET /api/uart/history[?since=offset] returns the retained RX bytes
+ * from offset (default: the oldest retained) as application/octet-stream.
+ * X-History-Offset carries the stream offset of the first byte sent,
+ * which is later than since if that part has been evicted.
+ */
+static esp_err_t api_uart_history_handler(httpd_req_t *req) {
+    lz_history_stats_t hstats;
+    lz_history_get_stats(&hstats);
+    
+    uint32_t offset = hstats.oldest_offset;
+    char query[32];
+    char value[16];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK) {
+        offset = strtoul(value, NULL, 10);
+    }
+    
+    uint8_t *buf = malloc(LUCIDUART_HISTORY_BLOCK_SIZE);
+    if (!buf) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    
+    // Stop at the end seen now, so a busy line cannot keep the response open
+    uint32_t end = hstats.end_offset;
+    size_t len = lz_history_read(&offset, buf, LUCIDUART_HISTORY_BLOCK_SIZE);
+    
+    char offset_hdr[12];
+    snprintf(offset_hdr, sizeof(offset_hdr), "%u", (unsigned)offset);
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "X-History-Offset", offset_hdr);
+    
+    esp_err_t err = ESP_OK;
+    while (len > 0 && (int32_t)(end - offset) > 0) {
+        len = MIN(len, end - offset);
+        err = httpd_resp_send_chunk(req, (const char *)buf, len);
+        if (err != ESP_OK) {
+            break;
+        }
+        offset += len;
+        len = lz_history_read(&offset, buf, LUCIDUART_HISTORY_BLOCK_SIZE);
+    }
+    free(buf);
+    
+    if (err != ESP_OK) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+/**
+ * @brief API UART capture endpoint - download the flash capture
+ * 
+ * GET /api/uart/capture streams every retained segment, oldest first,
+ * as one application/octet-stream file. Data arriving during the
+ * download is included up to the point the download started.
+ */
+static esp_err_t api_uart_capture_handler(httpd_req_t *req) {
+    flash_capture_stats_t capstats;
+    flash_capture_get_stats(&capstats);
+    if (capstats.segments == 0) {
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, "{\"error\":\"No capture partition\"}", -1);
+        return ESP_OK;
+    }
+    
+    uint8_t *buf = malloc(LUCIDUART_CAPTURE_RECORD_MAX);
+    if (!buf) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"capture.log\"");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    
+    esp_err_t err = ESP_OK;
+    flash_capture_pos_t pos;
+    if (flash_capture_first(&pos) == ESP_OK) {
+        size_t len;
+        while ((len = flash_capture_read(&pos, buf, LUCIDUART_CAPTURE_RECORD_MAX)) > 0) {
+            err = httpd_resp_send_chunk(req, (const char *)buf, len);
+            if (err != ESP_OK) {
+                break;
+            }
+            // A line busier than the WiFi link must not keep the download open
+            if ((int32_t)(pos.seq - capstats.head_seq) > 0 ||
+                (capstats.head_bytes && pos.seq == capstats.head_seq && pos.offset >= capstats.head_bytes)) {
+                break;
+            }
+        }
+    }
+    free(buf);
+    
+    if (err != ESP_OK) {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+/**
+ * @brief API UART latency endpoint - per-transport RX-to-socket histograms
+ * 
+ * GET /api/uart/latency[?reset=1]
+ */
+static esp_err_t api_uart_latency_handler(httpd_req_t *req) {
+    cJSON *json = cJSON_CreateObject();
+    for (int t = 0; t < UART_LATENCY_TRANSPORT_MAX; t++) {
+        uart_latency_summary_t summary;
+        if (uart_latency_get(t, &summary) != ESP_OK) {
+            continue;
+        }
+        
+        cJSON *hist = cJSON_CreateObject();
+        cJSON_AddNumberToObject(hist, "count", summary.count);
+        cJSON_AddNumberToObject(hist, "unmatched", summary.unmatched);
+        cJSON_AddNumberToObject(hist, "mean_us", summary.mean_us);
+        cJSON_AddNumberToObject(hist, "p50_us", summary.p50_us);
+        cJSON_AddNumberToObject(hist, "p99_us", summary.p99_us);
+        cJSON_AddNumberToObject(hist, "max_us", summary.max_us);
+        
+        // Bucket i counts samples in [2^i, 2^(i+1)) us; trailing zeros trimmed
+        int used = LUCIDUART_LATENCY_BUCKETS;
+        while (used > 0 && summary.buckets[used - 1] == 0) {
+            used--;
+        }
+        cJSON *buckets = cJSON_CreateArray();
+        for (int i = 0; i < used; i++) {
+            cJSON_AddItemToArray(buckets, cJSON_CreateNumber(summary.buckets[i]));
+        }
+        cJSON_AddItemToObject(hist, "log2_us_buckets", buckets);
+        cJSON_AddItemToObject(json, uart_latency_transport_name(t), hist);
+    }
+    
+    const char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    free((void *)json_string);
+    cJSON_Delete(json);
+    
+    // Reset after reporting so a tuning run starts from a clean histogram
+    char query[16];
+    char value[4];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "reset", value, sizeof(value)) == ESP_OK &&
+        value[0] == '1') {
+        uart_latency_reset();
+    }
+    return ESP_OK;
+}
+
 /**
  * @brief API WiFi connect endpoint - connects to specified network
  */
@@ -419,6 +532,281 @@ static esp_err_t api_wifi_reset_handler(httpd_req_t *req) {
     return ESP_OK;
 }
 
+/**
+ * @brief Send the trigger pattern set and match counters
+ */
+static esp_err_t triggers_send_state(httpd_req_t *req) {
+    trigger_engine_stats_t stats;
+    trigger_engine_get_stats(&stats);
+    
+    cJSON *json = cJSON_CreateObject();
+    cJSON *list = cJSON_CreateArray();
+    for (uint8_t i = 0; i < stats.pattern_count; i++) {
+        char pattern[LUCIDUART_TRIGGER_PATTERN_MAX + 1];
+        if (trigger_engine_get_pattern(i, pattern, sizeof(pattern)) != ESP_OK) {
+            continue;
+        }
+        cJSON *entry = cJSON_CreateObject();
+        cJSON_AddNumberToObject(entry, "id", i);
+        cJSON_AddStringToObject(entry, "pattern", pattern);
+        cJSON_AddNumberToObject(entry, "matches", stats.matches[i]);
+        cJSON_AddItemToArray(list, entry);
+    }
+    cJSON_AddItemToObject(json, "patterns", list);
+    cJSON_AddBoolToObject(json, "ignore_case", stats.ignore_case);
+    cJSON_AddNumberToObject(json, "matches", stats.total_matches);
+    cJSON_AddNumberToObject(json, "bytes_scanned", stats.bytes_scanned);
+    cJSON_AddNumberToObject(json, "states", stats.states);
+    cJSON_AddNumberToObject(json, "byte_classes", stats.classes);
+    cJSON_AddNumberToObject(json, "last_seq", stats.last_seq);
+    
+    const char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    free((void *)json_string);
+    cJSON_Delete(json);
+    return ESP_OK;
+}
+
+/**
+ * @brief API triggers endpoint - current patterns and match counters
+ */
+static esp_err_t api_triggers_get_handler(httpd_req_t *req) {
+    return triggers_send_state(req);
+}
+
+/**
+ * @brief API triggers endpoint - replace the pattern set
+ * 
+ * POST {"patterns": ["QUANTUM", "panic"], "ignore_case": false};
+ * an empty list stops matching.
+ */
+static esp_err_t api_triggers_set_handler(httpd_req_t *req) {
+    char content[512];
+    if (req->content_len >= sizeof(content)) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"error\":\"Body too large\"}", -1);
+        return ESP_FAIL;
+    }
+    
+    int ret = httpd_req_recv(req, content, req->content_len);
+    if (ret <= 0) {
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+            httpd_resp_send_408(req);
+        } else {
+            httpd_resp_send_500(req);
+        }
+        return ESP_FAIL;
+    }
+    content[ret] = '\0';
+    
+    cJSON *json = cJSON_Parse(content);
+    cJSON *list = json ? cJSON_GetObjectItem(json, "patterns") : NULL;
+    if (!cJSON_IsArray(list)) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"error\":\"Missing patterns array\"}", -1);
+        return ESP_FAIL;
+    }
+    
+    const char* patterns[LUCIDUART_TRIGGER_MAX_PATTERNS];
+    size_t count = 0;
+    cJSON *item;
+    cJSON_ArrayForEach(item, list) {
+        if (count == LUCIDUART_TRIGGER_MAX_PATTERNS || !cJSON_IsString(item)) {
+            count = LUCIDUART_TRIGGER_MAX_PATTERNS + 1;
+            break;
+        }
+        patterns[count++] = item->valuestring;
+    }
+    bool ignore_case = cJSON_IsTrue(cJSON_GetObjectItem(json, "ignore_case"));
+    
+    esp_err_t err = (count > LUCIDUART_TRIGGER_MAX_PATTERNS) ? ESP_ERR_INVALID_ARG :
+                    trigger_engine_set_patterns(patterns, count, ignore_case);
+    cJSON_Delete(json);
+    
+    if (err != ESP_OK) {
+        char error[96];
+        snprintf(error, sizeof(error), "{\"error\":\"Pattern set rejected (%s)\"}",
+                 esp_err_to_name(err));
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, error, -1);
+        return ESP_OK;
+    }
+    return triggers_send_state(req);
+}
+
+/**
+ * @brief Send self-test status and the results measured so far
+ */
+static esp_err_t selftest_send_state(httpd_req_t *req) {
+    static const char* state_names[] = { "idle", "running", "done", "cancelled", "failed" };
+    uart_selftest_status_t status;
+    uart_selftest_get_status(&status);
+    
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddStringToObject(json, "state", state_names[status.state]);
+    cJSON_AddNumberToObject(json, "total", status.total);
+    cJSON_AddNumberToObject(json, "completed", status.completed);
+    cJSON_AddNumberToObject(json, "idle_baseline", status.idle_baseline);
+    
+    cJSON *list = cJSON_CreateArray();
+    uart_selftest_result_t result;
+    for (uint32_t i = 0; uart_selftest_get_result(i, &result) == ESP_OK; i++) {
+        cJSON *entry = cJSON_CreateObject();
+        cJSON_AddNumberToObject(entry, "baud", result.baud);
+        cJSON_AddNumberToObject(entry, "batch", result.batch);
+        cJSON_AddNumberToObject(entry, "consumers", result.consumers);
+        cJSON_AddBoolToObject(entry, "passed", result.passed);
+        cJSON_AddNumberToObject(entry, "elapsed_ms", result.elapsed_ms);
+        cJSON_AddNumberToObject(entry, "tx_bytes", result.tx_bytes);
+        cJSON_AddNumberToObject(entry, "rx_bytes", result.rx_bytes);
+        cJSON_AddNumberToObject(entry, "rx_bytes_per_sec", result.rx_bytes_per_sec);
+        cJSON_AddNumberToObject(entry, "line_pct", result.line_pct);
+        cJSON_AddNumberToObject(entry, "frames_ok", result.frames_ok);
+        cJSON_AddNumberToObject(entry, "frames_bad", result.frames_bad);
+        cJSON_AddNumberToObject(entry, "frames_lost", result.frames_lost);
+        cJSON_AddNumberToObject(entry, "byte_errors", result.byte_errors);
+        cJSON_AddNumberToObject(entry, "slips", result.slips);
+        cJSON_AddNumberToObject(entry, "lost_bytes", result.lost_bytes);
+        cJSON_AddNumberToObject(entry, "uart_errors", result.uart_errors);
+        cJSON_AddNumberToObject(entry, "rx_events", result.rx_events);
+        cJSON_AddNumberToObject(entry, "rx_events_per_sec", result.rx_events_per_sec);
+        cJSON_AddNumberToObject(entry, "tx_stalls", result.tx_stalls);
+        cJSON_AddNumberToObject(entry, "cpu_idle_pct", result.cpu_idle_pct);
+        cJSON_AddItemToArray(list, entry);
+    }
+    cJSON_AddItemToObject(json, "results", list);
+    
+    const char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    free((void *)json_string);
+    cJSON_Delete(json);
+    return ESP_OK;
+}
+
+/**
+ * @brief API self-test endpoint - progress and results
+ */
+static esp_err_t api_uart_selftest_get_handler(httpd_req_t *req) {
+    return selftest_send_state(req);
+}
+
+/**
+ * @brief Copy a JSON number array into a sweep list
+ * 
+ * @return Entries copied, or 0 if the array is empty, too long or not numeric
+ */
+static size_t selftest_parse_list(cJSON *array, uint32_t* out, size_t max) {
+    size_t count = 0;
+    cJSON *item;
+    cJSON_ArrayForEach(item, array) {
+        if (count == max || !cJSON_IsNumber(item) || item->valuedouble < 1) {
+            return 0;
+        }
+        out[count++] = (uint32_t)item->valuedouble;
+    }
+    return count;
+}
+
+/**
+ * @brief API self-test endpoint - start or cancel a loopback run
+ * 
+ * POST {"bauds": [115200, 921600], "batches": [32, 1024], "consumers": [1, 4],
+ * "duration_ms": 1500} with every field optional, or {"cancel": true}.
+ * An empty body runs the default sweep.
+ */
+static esp_err_t api_uart_selftest_post_handler(httpd_req_t *req) {
+    char content[256];
+    if (req->content_len >= sizeof(content)) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "{\"error\":\"Body too large\"}", -1);
+        return ESP_FAIL;
+    }
+    
+    cJSON *json = NULL;
+    if (req->content_len > 0) {
+        int ret = httpd_req_recv(req, content, req->content_len);
+        if (ret <= 0) {
+            if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+                httpd_resp_send_408(req);
+            } else {
+                httpd_resp_send_500(req);
+            }
+            return ESP_FAIL;
+        }
+        content[ret] = '\0';
+        
+        json = cJSON_Parse(content);
+        if (!json) {
+            httpd_resp_set_status(req, "400 Bad Request");
+            httpd_resp_send(req, "{\"error\":\"Invalid JSON\"}", -1);
+            return ESP_FAIL;
+        }
+    }
+    
+    if (cJSON_IsTrue(cJSON_GetObjectItem(json, "cancel"))) {
+        cJSON_Delete(json);
+        uart_selftest_cancel();
+        return selftest_send_state(req);
+    }
+    
+    uint32_t bauds[LUCIDUART_SELFTEST_MAX_BAUDS];
+    uint32_t batch_values[LUCIDUART_SELFTEST_MAX_BATCHES];
+    uint32_t consumer_values[2];
+    uint16_t batches[LUCIDUART_SELFTEST_MAX_BATCHES];
+    uint8_t consumers[2];
+    uart_selftest_params_t params = {0};
+    esp_err_t err = ESP_OK;
+    
+    cJSON *list = cJSON_GetObjectItem(json, "bauds");
+    cJSON *batch_list = cJSON_GetObjectItem(json, "batches");
+    cJSON *consumer_list = cJSON_GetObjectItem(json, "consumers");
+    cJSON *duration = cJSON_GetObjectItem(json, "duration_ms");
+    
+    // Fields left out keep the default sweep
+    params.baud_count = list ? selftest_parse_list(list, bauds, LUCIDUART_SELFTEST_MAX_BAUDS) : 0;
+    params.batch_count = batch_list ? selftest_parse_list(batch_list, batch_values, LUCIDUART_SELFTEST_MAX_BATCHES) : 0;
+    params.consumer_count = consumer_list ? selftest_parse_list(consumer_list, consumer_values, 2) : 0;
+    if ((list && !params.baud_count) || (batch_list && !params.batch_count) ||
+        (consumer_list && !params.consumer_count)) {
+        err = ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < params.batch_count; i++) {
+        batches[i] = batch_values[i] > UINT16_MAX ? UINT16_MAX : batch_values[i];
+    }
+    for (size_t i = 0; i < params.consumer_count; i++) {
+        consumers[i] = consumer_values[i] > UINT8_MAX ? UINT8_MAX : consumer_values[i];
+    }
+    params.bauds = bauds;
+    params.batches = batches;
+    params.consumers = consumers;
+    params.duration_ms = cJSON_IsNumber(duration) ? (uint32_t)duration->valuedouble : 0;
+    cJSON_Delete(json);
+    
+    if (err == ESP_OK) {
+        err = uart_selftest_start(&params);
+    }
+    if (err != ESP_OK) {
+        char error[96];
+        snprintf(error, sizeof(error), "{\"error\":\"Self-test not started (%s)\"}",
+                 esp_err_to_name(err));
+        httpd_resp_set_status(req, err == ESP_ERR_INVALID_STATE ? "409 Conflict" : "400 Bad Request");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, error, -1);
+        return ESP_OK;
+    }
+    
+    httpd_resp_set_status(req, "202 Accepted");
+    return selftest_send_state(req);
+}
+
 /**
  * @brief API UART send endpoint - sends data to UART
  */
@@ -453,17 +841,25 @@ static esp_err_t api_uart_send_handler(httpd_req_t *req) {
         return ESP_FAIL;
     }
     
-    // Send to UART
+    // Queue for the UART TX task; never wait here so the worker is freed at once
     const char* uart_data = data_item->valuestring;
-    int bytes_sent = uart_bridge_send((const uint8_t*)uart_data, strlen(uart_data));
+    size_t length = strlen(uart_data);
+    esp_err_t err = (length > 0)
+        ? uart_bridge_tx_submit((const uint8_t*)uart_data, length, 0, NULL, NULL)
+        : ESP_ERR_INVALID_ARG;
     
-    ESP_LOGI(TAG, "UART TX via API: %s (%d bytes)", uart_data, bytes_sent);
+    ESP_LOGI(TAG, "UART TX via API: %s (%u bytes, %s)", uart_data, (unsigned)length, esp_err_to_name(err));
     
     // Create response
     cJSON *response = cJSON_CreateObject();
-    if (bytes_sent > 0) {
+    if (err == ESP_OK) {
         cJSON_AddStringToObject(response, "status", "sent");
-        cJSON_AddNumberToObject(response, "bytes", bytes_sent);
+        cJSON_AddNumberToObject(response, "bytes", length);
+    } else if (err == ESP_ERR_NO_MEM) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_hdr(req, "Retry-After", "1");
+        cJSON_AddStringToObject(response, "status", "failed");
+        cJSON_AddStringToObject(response, "error", "TX queue full");
     } else {
         cJSON_AddStringToObject(response, "status", "failed");
         cJSON_AddStringToObject(response, "error", "UART send failed");
@@ -481,106 +877,717 @@ static esp_err_t api_uart_send_handler(httpd_req_t *req) {
 }
 
 /**
- * @brief SSE endpoint for real-time UART data streaming
+ * @brief API UART write endpoint - streams a raw request body to UART
+ * 
+ * POST /api/uart/write[?drain=1] with any body, typically
+ * application/octet-stream. The body is read in chunks straight into
+ * the TX queue, so it is binary-safe and unbounded; the client is held
+ * back by TCP flow control while the queue is full. With drain=1 the
+ * response waits until the last byte has left the wire.
  */
-static esp_err_t api_uart_stream_handler(httpd_req_t *req) {
-    // Set SSE headers
-    httpd_resp_set_type(req, "text/event-stream");
-    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
-    httpd_resp_set_hdr(req, "Connection", "keep-alive");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    
-    // Send headers immediately
-    httpd_resp_send_chunk(req, NULL, 0);
-    
-    // Find a free client slot
-    int client_id = -1;
-    if (sse_mutex) {
-        xSemaphoreTake(sse_mutex, portMAX_DELAY);
-        for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
-            if (sse_clients[i] == NULL) {
-                sse_clients[i] = req;
-                client_id = i;
-                ESP_LOGI(TAG, "SSE client connected (slot %d)", i);
-                break;
-            }
-        }
-        xSemaphoreGive(sse_mutex);
+static esp_err_t api_uart_write_handler(httpd_req_t *req) {
+    if (!uart_bridge_is_active()) {
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, "{\"status\":\"failed\",\"error\":\"UART bridge not active\"}", -1);
+        return ESP_OK;
     }
     
-    if (client_id == -1) {
-        ESP_LOGW(TAG, "SSE connection rejected - max clients reached");
-        return ESP_FAIL;
+    bool drain = false;
+    char query[16];
+    char value[4];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "drain", value, sizeof(value)) == ESP_OK) {
+        drain = (value[0] == '1');
     }
     
-    // Send initial connection message
-    const char* connect_msg = "data: {\"connected\": true}\n\n";
-    httpd_resp_send_chunk(req, connect_msg, strlen(connect_msg));
+    char buf[LUCIDUART_UART_WRITE_CHUNK];
+    size_t remaining = req->content_len;
+    size_t written = 0;
+    esp_err_t err = ESP_OK;
+    int64_t start = esp_timer_get_time();
     
-    // Keep connection alive
-    while (1) {
-        vTaskDelay(pdMS_TO_TICKS(1000));
-        
-        // Check if our slot is still valid
-        bool is_connected = false;
-        if (sse_mutex) {
-            xSemaphoreTake(sse_mutex, portMAX_DELAY);
-            if (sse_clients[client_id] == req) {
-                is_connected = true;
-                // Send heartbeat to keep connection alive
-                const char* heartbeat = ": heartbeat\n\n";
-                if (httpd_resp_send_chunk(req, heartbeat, strlen(heartbeat)) != ESP_OK) {
-                    sse_clients[client_id] = NULL;
-                    is_connected = false;
-                }
-            }
-            xSemaphoreGive(sse_mutex);
+    while (remaining > 0) {
+        int ret = httpd_req_recv(req, buf, MIN(remaining, sizeof(buf)));
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+            continue;
+        }
+        if (ret <= 0) {
+            ESP_LOGW(TAG, "UART write aborted by client after %u bytes", (unsigned)written);
+            return ESP_FAIL;
         }
         
-        if (!is_connected) {
-            ESP_LOGI(TAG, "SSE client disconnected (slot %d)", client_id);
+        // Each chunk is one TX message; waiting here is what paces the sender
+        err = uart_bridge_tx_submit((const uint8_t*)buf, ret,
+                                    pdMS_TO_TICKS(LUCIDUART_UART_WRITE_WAIT_MS), NULL, NULL);
+        if (err != ESP_OK) {
             break;
         }
+        written += ret;
+        remaining -= ret;
+    }
+    
+    if (err == ESP_OK && drain) {
+        err = uart_bridge_tx_flush(pdMS_TO_TICKS(LUCIDUART_UART_WRITE_DRAIN_MS));
+    }
+    uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+    
+    ESP_LOGI(TAG, "UART write via API: %u of %u bytes in %u ms (%s)", (unsigned)written,
+             (unsigned)req->content_len, elapsed_ms, esp_err_to_name(err));
+    
+    cJSON *response = cJSON_CreateObject();
+    cJSON_AddStringToObject(response, "status", (err == ESP_OK) ? "written" : "failed");
+    cJSON_AddNumberToObject(response, "bytes", written);
+    cJSON_AddNumberToObject(response, "elapsed_ms", elapsed_ms);
+    cJSON_AddNumberToObject(response, "bytes_per_sec",
+                            elapsed_ms ? (double)written * 1000 / elapsed_ms : 0);
+    cJSON_AddBoolToObject(response, "drained", err == ESP_OK && drain);
+    if (err != ESP_OK) {
+        cJSON_AddStringToObject(response, "error",
+                                (err == ESP_ERR_TIMEOUT) ? "TX drain timeout" : "TX queue full");
+        httpd_resp_set_status(req, "503 Service Unavailable");
     }
     
+    const char *response_string = cJSON_PrintUnformatted(response);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, response_string, strlen(response_string));
+    
+    free((void *)response_string);
+    cJSON_Delete(response);
+    
+    // Unread body bytes would be parsed as the next request - close instead
+    return (remaining > 0) ? ESP_FAIL : ESP_OK;
+}
+
+/**
+ * @brief Send replay status and its outcome so far
+ */
+static esp_err_t replay_send_state(httpd_req_t *req) {
+    static const char* state_names[] = { "idle", "running", "done", "cancelled", "failed" };
+    uart_replay_status_t status;
+    uart_replay_get_status(&status);
+    
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddStringToObject(json, "state", state_names[status.state]);
+    if (status.error != ESP_OK) {
+        cJSON_AddStringToObject(json, "error", esp_err_to_name(status.error));
+    }
+    cJSON_AddNumberToObject(json, "speed", status.result.speed);
+    cJSON_AddNumberToObject(json, "records", status.result.records);
+    cJSON_AddNumberToObject(json, "tx_bytes", status.result.tx_bytes);
+    cJSON_AddNumberToObject(json, "rx_bytes", status.result.rx_bytes);
+    cJSON_AddBoolToObject(json, "rx_verified", status.result.rx_verified);
+    cJSON_AddNumberToObject(json, "capture_ms", status.result.capture_ms);
+    cJSON_AddNumberToObject(json, "elapsed_ms", status.result.elapsed_ms);
+    cJSON_AddNumberToObject(json, "late_records", status.result.late_records);
+    cJSON_AddNumberToObject(json, "max_late_us", status.result.max_late_us);
+    cJSON_AddNumberToObject(json, "rx_fifo_overflows", status.result.rx_fifo_overflows);
+    cJSON_AddNumberToObject(json, "rx_buffer_full", status.result.rx_buffer_full);
+    cJSON_AddNumberToObject(json, "consumer_dropped", status.result.consumer_dropped);
+    
+    const char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    free((void *)json_string);
+    cJSON_Delete(json);
     return ESP_OK;
 }
 
 /**
- * @brief Broadcast UART data to all SSE clients
- * This function is called from UART RX callback
+ * @brief API UART replay endpoint - progress and outcome
+ */
+static esp_err_t api_uart_replay_get_handler(httpd_req_t *req) {
+    return replay_send_state(req);
+}
+
+/**
+ * @brief API UART replay endpoint - plays a timed capture through loopback
+ * 
+ * POST /api/uart/replay[?speed=N] with a capture file (see uart_replay.h)
+ * as the body. The replay task sends the records out of TX at their
+ * captured spacing divided by speed; GET reports the timing and whether
+ * RX saw the same bytes. Needs TX jumpered to RX. The upload only holds
+ * the server while more of the capture is waiting than the replay FIFO
+ * takes, and is answered with 202 once the whole file is queued.
+ */
+static esp_err_t api_uart_replay_post_handler(httpd_req_t *req) {
+    uint16_t speed = 1;
+    char query[16];
+    char value[8];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "speed", value, sizeof(value)) == ESP_OK) {
+        int parsed = atoi(value);
+        speed = (parsed > 0 && parsed <= UINT16_MAX) ? parsed : 0;
+    }
+    
+    esp_err_t err = uart_replay_begin(speed);
+    if (err != ESP_OK) {
+        char error[96];
+        snprintf(error, sizeof(error), "{\"error\":\"Replay not started (%s)\"}",
+                 esp_err_to_name(err));
+        httpd_resp_set_status(req, err == ESP_ERR_INVALID_STATE ? "409 Conflict" : "400 Bad Request");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, error, -1);
+        return (req->content_len > 0) ? ESP_FAIL : ESP_OK;
+    }
+    
+    char buf[LUCIDUART_UART_WRITE_CHUNK];
+    size_t remaining = req->content_len;
+    
+    // Feed blocks while the FIFO is full, so the client is paced by TCP
+    while (remaining > 0 && err == ESP_OK) {
+        int ret = httpd_req_recv(req, buf, MIN(remaining, sizeof(buf)));
+        if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+            continue;
+        }
+        if (ret <= 0) {
+            ESP_LOGW(TAG, "UART replay aborted by client");
+            uart_replay_cancel();
+            return ESP_FAIL;
+        }
+        err = uart_replay_feed((const uint8_t*)buf, ret);
+        remaining -= ret;
+    }
+    
+    if (err == ESP_OK) {
+        uart_replay_finish();
+        httpd_resp_set_status(req, "202 Accepted");
+    } else {
+        // Wait for the failed replay to restore the bridge, so the answer carries its error
+        uart_replay_cancel();
+        httpd_resp_set_status(req, (err == ESP_ERR_NO_MEM) ? "503 Service Unavailable" : "400 Bad Request");
+    }
+    replay_send_state(req);
+    
+    // Unread body bytes would be parsed as the next request - close instead
+    return (remaining > 0) ? ESP_FAIL : ESP_OK;
+}
+
+/**
+ * @brief Parse an SSE backpressure policy name
+ */
+static bool sse_parse_policy(const char* name, web_sse_policy_t* policy) {
+    if (strcmp(name, "drop-oldest") == 0) {
+        *policy = WEB_SSE_DROP_OLDEST;
+    } else if (strcmp(name, "drop-client") == 0) {
+        *policy = WEB_SSE_DROP_CLIENT;
+    } else if (strcmp(name, "block") == 0) {
+        *policy = WEB_SSE_BLOCK_TIMEOUT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Release an SSE client slot (caller holds sse_mutex)
+ */
+static void sse_client_release(sse_client_t* client) {
+    if (!client->in_use) {
+        return;
+    }
+    uart_bridge_consumer_close(client->cursor);
+    client->in_use = false;
+    ESP_LOGI(TAG, "SSE client disconnected (slot %d)", (int)(client - sse_clients));
+}
+
+/**
+ * @brief Session context destructor - httpd closed an SSE socket
+ */
+static void sse_session_closed(void* ctx) {
+    sse_client_t* client = (sse_client_t*)ctx;
+    xSemaphoreTake(sse_mutex, portMAX_DELAY);
+    sse_client_release(client);
+    xSemaphoreGive(sse_mutex);
+}
+
+/**
+ * @brief Ask httpd to close a client socket (caller holds sse_mutex)
  */
-void web_server_broadcast_uart_data(const uint8_t* data, size_t len) {
-    if (!sse_mutex || !data || len == 0) {
+static void sse_client_drop(sse_client_t* client, const char* reason) {
+    if (client->closing) {
         return;
     }
+    ESP_LOGW(TAG, "Dropping SSE client %d: %s", (int)(client - sse_clients), reason);
+    client->closing = true;
+    if (httpd_sess_trigger_close(server, client->fd) != ESP_OK) {
+        // Session already gone, no destructor will run
+        sse_client_release(client);
+    }
+}
+
+/**
+ * @brief Wrap an SSE message into the client's pending chunk frame
+ */
+static void sse_frame_set(sse_client_t* client, const char* msg, size_t msg_len) {
+    int hdr = snprintf(client->frame, sizeof(client->frame), "%x\r\n", (unsigned)msg_len);
+    memcpy(client->frame + hdr, msg, msg_len);
+    memcpy(client->frame + hdr + msg_len, "\r\n", 2);
+    client->frame_len = hdr + msg_len + 2;
+    client->frame_sent = 0;
+    client->frame_timed = false;
+}
+
+/**
+ * @brief Push the pending frame without blocking the fan-out task
+ * 
+ * @return true when the frame is fully sent, false if data remains
+ */
+static bool sse_flush_frame(sse_client_t* client) {
+    while (client->frame_sent < client->frame_len) {
+        int sent = httpd_socket_send(server, client->fd,
+                                     client->frame + client->frame_sent,
+                                     client->frame_len - client->frame_sent,
+                                     MSG_DONTWAIT);
+        if (sent > 0) {
+            client->frame_sent += sent;
+            client->blocked = false;
+            continue;
+        }
+        if (sent != HTTPD_SOCK_ERR_TIMEOUT) {
+            sse_client_drop(client, "send failed");
+            return false;
+        }
+        
+        // Socket buffer is full - apply the client's backpressure policy
+        switch (client->policy) {
+            case WEB_SSE_BLOCK_TIMEOUT:
+                // Hold the client's data back and retry next round; the other
+                // clients and httpd must not wait on this socket
+                if (!client->blocked) {
+                    client->blocked = true;
+                    client->blocked_since = xTaskGetTickCount();
+                } else if (xTaskGetTickCount() - client->blocked_since >=
+                           pdMS_TO_TICKS(client->block_timeout_ms)) {
+                    sse_client_drop(client, "send timeout");
+                }
+                return false;
+            case WEB_SSE_DROP_CLIENT:
+                sse_client_drop(client, "too slow");
+                return false;
+            case WEB_SSE_DROP_OLDEST:
+            default:
+                // Retry next round; the ring drops oldest data if it laps us
+                return false;
+        }
+    }
+    
+    if (client->frame_timed) {
+        uart_latency_record(UART_LATENCY_SSE, client->frame_offset);
+    }
+    
+    client->frame_len = 0;
+    client->frame_sent = 0;
+    client->last_send = xTaskGetTickCount();
+    return true;
+}
+
+/**
+ * @brief Encode the next slice of a client's cursor as an SSE frame
+ * 
+ * @return true if a frame was built
+ */
+static bool sse_build_data_frame(sse_client_t* client) {
+    const uint8_t* data;
+    size_t len = uart_bridge_consumer_peek(client->cursor, &data);
+    
+    // Stats after peek so a resync there is seen this round
+    uart_bridge_consumer_stats_t cstats;
+    if (uart_bridge_consumer_get_stats(client->cursor, &cstats) != ESP_OK) {
+        return false;
+    }
+    
+    if (cstats.overruns != client->last_overruns) {
+        client->last_overruns = cstats.overruns;
+        if (client->policy == WEB_SSE_DROP_CLIENT) {
+            sse_client_drop(client, "fell a ring behind");
+            return false;
+        }
+    }
+    
+    if (len == 0) {
+        client->replaying = false;
+        return false;
+    }
+    // Replay ignores coalescing; live data waits for a full batch or deadline
+    if (!client->replaying && !uart_bridge_consumer_ready(client->cursor)) {
+        return false;
+    }
+    if (len > LUCIDUART_SSE_CHUNK_MAX) {
+        len = LUCIDUART_SSE_CHUNK_MAX;
+    }
+    
+    // Device-side line stamps; end the chunk early rather than drop one
+    uart_bridge_line_stamp_t stamps[LUCIDUART_SSE_MAX_STAMPS + 1];
+    size_t stamp_count = uart_bridge_get_line_stamps(cstats.read_offset, cstats.read_offset + len,
+                                                     stamps, LUCIDUART_SSE_MAX_STAMPS + 1);
+    if (stamp_count > LUCIDUART_SSE_MAX_STAMPS) {
+        len = stamps[LUCIDUART_SSE_MAX_STAMPS].offset - cstats.read_offset;
+        stamp_count = LUCIDUART_SSE_MAX_STAMPS;
+    }
+    
+    char ts_json[SSE_STAMPS_MAX] = "";
+    size_t ts_len = 0;
+    for (size_t i = 0; i < stamp_count; i++) {
+        const char* sep = i ? "," : ",\"ts\":[";
+        unsigned offset = stamps[i].offset - cstats.read_offset;
+        // %llu is not in newlib-nano printf; print seconds and micros as one number
+        uint32_t sec = stamps[i].time_us / 1000000;
+        uint32_t usec = stamps[i].time_us % 1000000;
+        if (sec) {
+            ts_len += snprintf(ts_json + ts_len, sizeof(ts_json) - ts_len,
+                               "%s[%u,%u%06u]", sep, offset, sec, usec);
+        } else {
+            ts_len += snprintf(ts_json + ts_len, sizeof(ts_json) - ts_len,
+                               "%s[%u,%u]", sep, offset, usec);
+        }
+    }
+    if (stamp_count) {
+        snprintf(ts_json + ts_len, sizeof(ts_json) - ts_len, "]");
+    }
     
     // Base64 encode the data for safe JSON transmission
-    unsigned char b64_buf[512];
+    unsigned char b64_buf[SSE_B64_MAX];
     size_t b64_len = 0;
-    
     int ret = mbedtls_base64_encode(b64_buf, sizeof(b64_buf), &b64_len, data, len);
-    if (ret != 0) {
-        ESP_LOGW(TAG, "Failed to encode UART data to Base64");
-        return;
+    
+    // Encoded from the ring in place; drop the frame if the writer lapped us
+    if (uart_bridge_consumer_advance(client->cursor, len) != ESP_OK || ret != 0) {
+        return false;
     }
     
-    // Create SSE message with Base64 encoded data
-    char sse_msg[600];
-    snprintf(sse_msg, sizeof(sse_msg), "data: {\"uart_b64\":\"%.*s\",\"len\":%d}\n\n", 
-             (int)b64_len, b64_buf, (int)len);
+    // Event id is the stream offset after this chunk, echoed back on reconnect
+    uint32_t event_id = cstats.read_offset + len;
     
-    // Send to all connected SSE clients
+    char msg[SSE_FRAME_MAX - 8];
+    int msg_len = snprintf(msg, sizeof(msg),
+                           "id: %u\ndata: {\"uart_b64\":\"%.*s\",\"len\":%d%s}\n\n",
+                           event_id, (int)b64_len, b64_buf, (int)len, ts_json);
+    sse_frame_set(client, msg, msg_len);
+    
+    // Scrollback replay would only skew the live latency histogram
+    client->frame_timed = !client->replaying;
+    client->frame_offset = cstats.read_offset;
+    return true;
+}
+
+/**
+ * @brief Encode the next slice of a resumed client's history as an SSE frame
+ * 
+ * Covers bytes that had left the RX ring before the client reconnected;
+ * the ring cursor takes over once history_pos reaches history_end.
+ * 
+ * @return true if a frame was built
+ */
+static bool sse_build_history_frame(sse_client_t* client) {
+    if (client->history_pos == client->history_end) {
+        return false;
+    }
+    
+    uint8_t data[LUCIDUART_SSE_CHUNK_MAX];
+    uint32_t offset = client->history_pos;
+    size_t len = lz_history_read(&offset, data, sizeof(data));
+    if (len == 0 || (int32_t)(client->history_end - offset) <= 0) {
+        client->history_pos = client->history_end;
+        return false;
+    }
+    len = MIN(len, client->history_end - offset);
+    client->history_pos = offset + len;
+    
+    unsigned char b64_buf[SSE_B64_MAX];
+    size_t b64_len = 0;
+    if (mbedtls_base64_encode(b64_buf, sizeof(b64_buf), &b64_len, data, len) != 0) {
+        return false;
+    }
+    
+    char msg[SSE_FRAME_MAX - 8];
+    int msg_len = snprintf(msg, sizeof(msg),
+                           "id: %u\ndata: {\"uart_b64\":\"%.*s\",\"len\":%d}\n\n",
+                           (unsigned)client->history_pos, (int)b64_len, b64_buf, (int)len);
+    sse_frame_set(client, msg, msg_len);
+    return true;
+}
+
+/**
+ * @brief Encode the client's next trigger event as an SSE frame
+ * 
+ * @return true if a frame was built
+ */
+static bool sse_build_trigger_frame(sse_client_t* client) {
+    trigger_event_t event;
+    if (!trigger_engine_get_event(client->trigger_seq, &event)) {
+        return false;
+    }
+    client->trigger_seq = event.seq;
+    
+    char pattern[LUCIDUART_TRIGGER_PATTERN_MAX + 1] = "";
+    trigger_engine_get_pattern(event.pattern, pattern, sizeof(pattern));
+    
+    unsigned char b64_buf[((LUCIDUART_TRIGGER_CONTEXT_MAX + 2) / 3) * 4 + 1];
+    size_t b64_len = 0;
+    if (mbedtls_base64_encode(b64_buf, sizeof(b64_buf), &b64_len,
+                              event.context, event.context_len) != 0) {
+        return false;
+    }
+    b64_buf[b64_len] = '\0';
+    
+    // cJSON escapes the pattern text; the context is binary, so Base64
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddNumberToObject(json, "seq", event.seq);
+    cJSON_AddNumberToObject(json, "id", event.pattern);
+    cJSON_AddStringToObject(json, "pattern", pattern);
+    cJSON_AddNumberToObject(json, "offset", event.offset);
+    cJSON_AddNumberToObject(json, "ts", (double)event.time_us);
+    cJSON_AddStringToObject(json, "context_b64", (const char*)b64_buf);
+    cJSON_AddNumberToObject(json, "match_start", event.match_start);
+    cJSON_AddNumberToObject(json, "match_len", event.match_len);
+    char *data = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    if (!data) {
+        return false;
+    }
+    
+    char msg[SSE_FRAME_MAX - 8];
+    int msg_len = snprintf(msg, sizeof(msg), "event: trigger\ndata: %s\n\n", data);
+    free(data);
+    if (msg_len <= 0 || msg_len >= (int)sizeof(msg)) {
+        return false;
+    }
+    sse_frame_set(client, msg, msg_len);
+    return true;
+}
+
+/**
+ * @brief Service one SSE client: flush, refill, heartbeat
+ * 
+ * @return true if the client still has data waiting to be sent
+ */
+static bool sse_service_client(sse_client_t* client) {
+    // Bounded work per client per round keeps fan-out fair; replay after a
+    // reconnect gets larger batches so it catches up quickly
+    int max_frames = client->replaying ? 16 : 4;
+    for (int frames = 0; frames < max_frames; frames++) {
+        if (client->frame_len && !sse_flush_frame(client)) {
+            return client->in_use && !client->closing;
+        }
+        if (!client->in_use || client->closing) {
+            break;
+        }
+        if (!sse_build_trigger_frame(client) && !sse_build_history_frame(client) &&
+            !sse_build_data_frame(client)) {
+            break;
+        }
+    }
+    
+    if (!client->in_use || client->closing) {
+        return false;
+    }
+    
+    if (client->frame_len == 0 &&
+        xTaskGetTickCount() - client->last_send >= pdMS_TO_TICKS(LUCIDUART_SSE_HEARTBEAT_MS)) {
+        // Heartbeat keeps proxies open and detects dead sockets
+        static const char heartbeat[] = ": heartbeat\n\n";
+        sse_frame_set(client, heartbeat, sizeof(heartbeat) - 1);
+    }
+    
+    // History replay does not wake the cursor, so keep polling until done
+    return client->frame_len != 0 || client->history_pos != client->history_end;
+}
+
+/**
+ * @brief SSE fan-out task
+ * 
+ * Reads each client's RX ring cursor and writes to its socket without
+ * blocking, so a slow WiFi client can only ever lose its own data.
+ */
+static void sse_fanout_task(void* pvParameters) {
+    ESP_LOGI(TAG, "SSE fan-out task started");
+    
+    while (1) {
+        uart_bridge_consumer_t cursors[LUCIDUART_SSE_MAX_CLIENTS];
+        size_t cursor_count = 0;
+        bool backlog = false;
+        
+        xSemaphoreTake(sse_mutex, portMAX_DELAY);
+        for (int i = 0; i < LUCIDUART_SSE_MAX_CLIENTS; i++) {
+            sse_client_t* client = &sse_clients[i];
+            if (!client->in_use || client->closing) {
+                continue;
+            }
+            backlog |= sse_service_client(client);
+            if (client->in_use && !client->closing) {
+                cursors[cursor_count++] = client->cursor;
+            }
+        }
+        xSemaphoreGive(sse_mutex);
+        
+        if (cursor_count == 0) {
+            // Idle until a client connects
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        } else if (backlog) {
+            // Sockets are full - poll again shortly
+            vTaskDelay(pdMS_TO_TICKS(20));
+        } else {
+            // Trigger events do not wake cursors, so poll for them while matching
+            uint32_t wait_ms = trigger_engine_active() ? LUCIDUART_SSE_TRIGGER_POLL_MS
+                                                       : LUCIDUART_SSE_HEARTBEAT_MS;
+            uart_bridge_consumer_wait_any(cursors, cursor_count, pdMS_TO_TICKS(wait_ms));
+        }
+    }
+}
+
+/**
+ * @brief SSE endpoint for real-time UART data streaming
+ */
+static esp_err_t api_uart_stream_handler(httpd_req_t *req) {
+    // Per-client backpressure policy and resume offset from query string
+    web_sse_policy_t policy = sse_default_policy;
+    uint32_t timeout_ms = sse_default_timeout_ms;
+    uint32_t flush_bytes = LUCIDUART_SSE_COALESCE_BYTES;
+    uint32_t flush_ms = LUCIDUART_SSE_COALESCE_MS;
+    bool resume = false;
+    uint32_t resume_offset = 0;
+    char query[128];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        char value[16];
+        if (httpd_query_key_value(query, "since", value, sizeof(value)) == ESP_OK) {
+            resume_offset = strtoul(value, NULL, 10);
+            resume = true;
+        }
+        if (httpd_query_key_value(query, "policy", value, sizeof(value)) == ESP_OK &&
+            !sse_parse_policy(value, &policy)) {
+            httpd_resp_set_status(req, "400 Bad Request");
+            httpd_resp_send(req, "{\"error\":\"Unknown policy\"}", -1);
+            return ESP_OK;
+        }
+        if (httpd_query_key_value(query, "timeout", value, sizeof(value)) == ESP_OK) {
+            timeout_ms = MIN(strtoul(value, NULL, 10), LUCIDUART_SSE_BLOCK_TIMEOUT_MAX_MS);
+        }
+        // Coalescing overrides, e.g. flush_ms=0 for keystroke-level latency
+        if (httpd_query_key_value(query, "flush_bytes", value, sizeof(value)) == ESP_OK) {
+            flush_bytes = strtoul(value, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "flush_ms", value, sizeof(value)) == ESP_OK) {
+            flush_ms = strtoul(value, NULL, 10);
+        }
+    }
+    
+    // EventSource sends Last-Event-ID on its own reconnects
+    char last_id[16];
+    if (httpd_req_get_hdr_value_str(req, "Last-Event-ID", last_id, sizeof(last_id)) == ESP_OK) {
+        resume_offset = strtoul(last_id, NULL, 10);
+        resume = true;
+    }
+    
+    // Find a free client slot
+    sse_client_t* client = NULL;
     xSemaphoreTake(sse_mutex, portMAX_DELAY);
-    for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
-        if (sse_clients[i] != NULL) {
-            if (httpd_resp_send_chunk(sse_clients[i], sse_msg, strlen(sse_msg)) != ESP_OK) {
-                ESP_LOGW(TAG, "Failed to send to SSE client %d, disconnecting", i);
-                sse_clients[i] = NULL;
+    for (int i = 0; i < LUCIDUART_SSE_MAX_CLIENTS; i++) {
+        if (!sse_clients[i].in_use) {
+            client = &sse_clients[i];
+            break;
+        }
+    }
+    
+    uart_bridge_consumer_t cursor;
+    if (!client || uart_bridge_consumer_open("sse", &cursor) != ESP_OK) {
+        xSemaphoreGive(sse_mutex);
+        ESP_LOGW(TAG, "SSE connection rejected - max clients reached");
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_send(req, "{\"error\":\"Too many stream clients\"}", -1);
+        return ESP_OK;
+    }
+    // Reserve the slot; the fan-out task skips it while it is marked closing
+    *client = (sse_client_t){ .in_use = true, .closing = true, .cursor = cursor };
+    xSemaphoreGive(sse_mutex);
+    uart_bridge_consumer_set_coalesce(cursor, flush_bytes, flush_ms * 1000);
+    
+    // Set SSE headers
+    httpd_resp_set_type(req, "text/event-stream");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+    httpd_resp_set_hdr(req, "Connection", "keep-alive");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    
+    // Replay missed bytes from scrollback, reaching into compressed
+    // history for whatever has already left the ring
+    uint32_t lost = 0;
+    uint32_t history_pos = 0;
+    uint32_t history_end = 0;
+    if (resume) {
+        uart_bridge_consumer_seek(cursor, resume_offset);
+        uart_bridge_consumer_stats_t cstats;
+        if (uart_bridge_consumer_get_stats(cursor, &cstats) == ESP_OK &&
+            (int32_t)(cstats.read_offset - resume_offset) > 0) {
+            lost = cstats.read_offset - resume_offset;
+            
+            lz_history_stats_t hstats;
+            lz_history_get_stats(&hstats);
+            uint32_t from = resume_offset;
+            if ((int32_t)(hstats.oldest_offset - from) > 0) {
+                from = hstats.oldest_offset;
+            }
+            if (hstats.raw_bytes && (int32_t)(cstats.read_offset - from) > 0) {
+                history_pos = from;
+                history_end = cstats.read_offset;
+                lost = from - resume_offset;
             }
         }
     }
+    
+    // Send headers and initial connection message without the lock, so a
+    // slow new client cannot stall the fan-out to everyone else
+    char connect_msg[96];
+    snprintf(connect_msg, sizeof(connect_msg),
+             "data: {\"connected\": true, \"resumed\": %s, \"lost\": %u}\n\n",
+             resume ? "true" : "false", lost);
+    esp_err_t sent = httpd_resp_send_chunk(req, connect_msg, strlen(connect_msg));
+    
+    xSemaphoreTake(sse_mutex, portMAX_DELAY);
+    if (sent != ESP_OK) {
+        uart_bridge_consumer_close(cursor);
+        client->in_use = false;
+        xSemaphoreGive(sse_mutex);
+        return ESP_FAIL;
+    }
+    
+    *client = (sse_client_t){
+        .in_use = true,
+        .fd = httpd_req_to_sockfd(req),
+        .cursor = cursor,
+        .policy = policy,
+        .block_timeout_ms = timeout_ms,
+        .replaying = resume,
+        .last_send = xTaskGetTickCount(),
+        .history_pos = history_pos,
+        .history_end = history_end,
+    };
+    
+    // Only matches from now on; older ones are in GET /api/triggers counters
+    trigger_engine_stats_t tstats;
+    trigger_engine_get_stats(&tstats);
+    client->trigger_seq = tstats.last_seq;
+    
+    // httpd calls sse_session_closed when the socket goes away
+    req->sess_ctx = client;
+    req->free_ctx = sse_session_closed;
     xSemaphoreGive(sse_mutex);
+    
+    ESP_LOGI(TAG, "SSE client connected (slot %d, policy %d)", (int)(client - sse_clients), (int)policy);
+    xTaskNotifyGive(sse_task_handle);
+    
+    // Return with the response open; the fan-out task owns the socket now
+    return ESP_OK;
+}
+
+esp_err_t web_server_set_sse_policy(web_sse_policy_t policy, uint32_t block_timeout_ms) {
+    if (policy > WEB_SSE_BLOCK_TIMEOUT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    sse_default_policy = policy;
+    sse_default_timeout_ms = MIN(block_timeout_ms, LUCIDUART_SSE_BLOCK_TIMEOUT_MAX_MS);
+    return ESP_OK;
 }
 
 esp_err_t web_server_get_system_status(web_system_status_t* status) {
@@ -588,8 +1595,8 @@ esp_err_t web_server_get_system_status(web_system_status_t* status) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    // Get WiFi status
-    lucid_wifi_status_t wifi_status;
+    // Get WiFi status (static: status->ssid and ip_address point into it)
+    static lucid_wifi_status_t wifi_status;
     wifi_manager_get_status(&wifi_status);
     
     // Fill system status
@@ -622,8 +1629,18 @@ esp_err_t web_server_get_system_status(web_system_status_t* status) {
     // UART bridge status (use callbacks if available)
     status->uart_rx_count = uart_rx_callback ? uart_rx_callback() : 0;
     status->uart_tx_count = uart_tx_callback ? uart_tx_callback() : 0;
-    status->uart_baud_rate = 115200;  // Default for now
-    status->uart_bridge_active = true;  // Bridge is now active
+    uart_bridge_config_t uart_config;
+    uart_bridge_get_config(&uart_config);
+    status->uart_baud_rate = uart_config.baud_rate;
+    status->uart_bridge_active = uart_bridge_is_active();
+    
+    static const char* const autobaud_names[] = {
+        "idle", "running", "locked", "failed", "cancelled",
+    };
+    uart_bridge_autobaud_status_t autobaud;
+    uart_bridge_autobaud_get_status(&autobaud);
+    status->uart_autobaud = autobaud_names[autobaud.state];
+    status->uart_autobaud_score = autobaud.score;
     
     return ESP_OK;
 }
@@ -666,9 +1683,23 @@ esp_err_t web_server_init(void) {
         }
     }
     
+    // Start SSE fan-out task (decoupled from the UART reader)
+    if (!sse_task_handle) {
+        BaseType_t task_created = xTaskCreate(sse_fanout_task,
+                                              "sse_fanout",
+                                              LUCIDUART_SSE_TASK_STACK,
+                                              NULL,
+                                              LUCIDUART_SSE_TASK_PRIORITY,
+                                              &sse_task_handle);
+        if (task_created != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create SSE fan-out task");
+            return ESP_FAIL;
+        }
+    }
+    
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.server_port = LUCIDUART_HTTP_PORT;
-    config.max_uri_handlers = 10;  // Increased for new endpoints
+    config.max_uri_handlers = 18;  // Increased for new endpoints
     config.max_open_sockets = 6;   // Increased for SSE connections
     config.stack_size = 8192;
     
@@ -727,6 +1758,94 @@ esp_err_t web_server_init(void) {
     };
     httpd_register_uri_handler(server, &api_uart_stream_uri);
     
+    httpd_uri_t api_uart_stats_uri = {
+        .uri = LUCIDUART_API_UART_STATS,
+        .method = HTTP_GET,
+        .handler = api_uart_stats_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_stats_uri);
+    
+    httpd_uri_t api_uart_latency_uri = {
+        .uri = LUCIDUART_API_UART_LATENCY,
+        .method = HTTP_GET,
+        .handler = api_uart_latency_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_latency_uri);
+    
+    httpd_uri_t api_uart_write_uri = {
+        .uri = LUCIDUART_API_UART_WRITE,
+        .method = HTTP_POST,
+        .handler = api_uart_write_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_write_uri);
+    
+    httpd_uri_t api_uart_history_uri = {
+        .uri = LUCIDUART_API_UART_HISTORY,
+        .method = HTTP_GET,
+        .handler = api_uart_history_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_history_uri);
+    
+    httpd_uri_t api_uart_capture_uri = {
+        .uri = LUCIDUART_API_UART_CAPTURE,
+        .method = HTTP_GET,
+        .handler = api_uart_capture_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_capture_uri);
+    
+    httpd_uri_t api_triggers_get_uri = {
+        .uri = LUCIDUART_API_TRIGGERS,
+        .method = HTTP_GET,
+        .handler = api_triggers_get_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_triggers_get_uri);
+    
+    httpd_uri_t api_triggers_set_uri = {
+        .uri = LUCIDUART_API_TRIGGERS,
+        .method = HTTP_POST,
+        .handler = api_triggers_set_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_triggers_set_uri);
+    
+    httpd_uri_t api_uart_selftest_get_uri = {
+        .uri = LUCIDUART_API_UART_SELFTEST,
+        .method = HTTP_GET,
+        .handler = api_uart_selftest_get_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_selftest_get_uri);
+    
+    httpd_uri_t api_uart_selftest_post_uri = {
+        .uri = LUCIDUART_API_UART_SELFTEST,
+        .method = HTTP_POST,
+        .handler = api_uart_selftest_post_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_selftest_post_uri);
+    
+    httpd_uri_t api_uart_replay_get_uri = {
+        .uri = LUCIDUART_API_UART_REPLAY,
+        .method = HTTP_GET,
+        .handler = api_uart_replay_get_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_replay_get_uri);
+    
+    httpd_uri_t api_uart_replay_post_uri = {
+        .uri = LUCIDUART_API_UART_REPLAY,
+        .method = HTTP_POST,
+        .handler = api_uart_replay_post_handler,
+        .user_ctx = NULL
+    };
+    httpd_register_uri_handler(server, &api_uart_replay_post_uri);
+    
     ESP_LOGI(TAG, "HTTP server started on port %d", LUCIDUART_HTTP_PORT);
     
     return ESP_OK;
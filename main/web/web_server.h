@@ -26,6 +26,38 @@ extern "C" {
 #define LUCIDUART_API_WIFI_RESET    "/api/wifi/reset"
 #define LUCIDUART_API_SYSTEM_INFO   "/api/system/info"
 #define LUCIDUART_API_UART_STATS    "/api/uart/stats"
+#define LUCIDUART_API_UART_LATENCY  "/api/uart/latency"
+#define LUCIDUART_API_UART_WRITE    "/api/uart/write"
+#define LUCIDUART_API_UART_HISTORY  "/api/uart/history"
+#define LUCIDUART_API_UART_CAPTURE  "/api/uart/capture"
+#define LUCIDUART_API_UART_SELFTEST "/api/uart/selftest"
+#define LUCIDUART_API_UART_REPLAY   "/api/uart/replay"
+#define LUCIDUART_API_TRIGGERS      "/api/triggers"
+
+// Binary upload (/api/uart/write)
+#define LUCIDUART_UART_WRITE_CHUNK      1024    // Body bytes per recv/TX submit (httpd stack)
+#define LUCIDUART_UART_WRITE_WAIT_MS    5000    // Max wait for TX queue space per chunk
+#define LUCIDUART_UART_WRITE_DRAIN_MS   30000   // Max wait for ?drain=1
+
+// SSE streaming configuration
+#define LUCIDUART_SSE_MAX_CLIENTS       4       // Concurrent /api/uart/stream clients
+#define LUCIDUART_SSE_CHUNK_MAX         384     // Max UART bytes per SSE event (512 Base64 chars)
+#define LUCIDUART_SSE_MAX_STAMPS        8       // Line stamps per event; chunks end early past this
+#define LUCIDUART_SSE_HEARTBEAT_MS      1000    // Idle heartbeat interval
+#define LUCIDUART_SSE_COALESCE_BYTES    LUCIDUART_SSE_CHUNK_MAX // Flush at one full event...
+#define LUCIDUART_SSE_COALESCE_MS       50      // ...or this long after the first byte
+#define LUCIDUART_SSE_BLOCK_TIMEOUT_MS  500     // Default wait for WEB_SSE_BLOCK_TIMEOUT
+#define LUCIDUART_SSE_BLOCK_TIMEOUT_MAX_MS  5000 // Longest ?timeout= accepted
+#define LUCIDUART_SSE_TASK_PRIORITY     4       // Below the UART task (5)
+#define LUCIDUART_SSE_TASK_STACK        4096    // Frame, Base64 and stamp buffers live on it
+#define LUCIDUART_SSE_TRIGGER_POLL_MS   100     // Trigger event pickup while patterns are set
+
+// Backpressure policy applied when an SSE client cannot keep up
+typedef enum {
+    WEB_SSE_DROP_OLDEST = 0,    // Never wait; skip ahead when the client falls a ring behind
+    WEB_SSE_DROP_CLIENT,        // Disconnect the client once it falls behind
+    WEB_SSE_BLOCK_TIMEOUT,      // Wait up to a timeout for the socket to drain, then disconnect
+} web_sse_policy_t;
 
 // System status for API responses
 typedef struct {
@@ -47,6 +79,8 @@ typedef struct {
     uint32_t uart_tx_count;
     uint32_t uart_baud_rate;
     bool uart_bridge_active;
+    const char* uart_autobaud;  // "idle", "running", "locked", "failed", "cancelled"
+    uint8_t uart_autobaud_score;    // Detection score of the locked rate (0-100)
 } web_system_status_t;
 
 /**
@@ -98,15 +132,24 @@ esp_err_t web_server_set_uart_callbacks(uint32_t (*rx_count_callback)(void),
                                         uint32_t (*tx_count_callback)(void));
 
 /**
- * @brief Broadcast UART data to SSE clients
+ * @brief Set default SSE backpressure policy
+ * 
+ * Applies to clients that connect afterwards. A client can override it
+ * with ?policy=drop-oldest|drop-client|block&timeout=<ms> on
+ * /api/uart/stream.
  * 
- * Sends received UART data to all connected SSE clients for real-time streaming.
- * Data is Base64 encoded for safe JSON transmission.
+ * UART data reaches SSE clients through a dedicated fan-out task that
+ * reads its own RX ring cursor per client, so network I/O never blocks
+ * the UART reader. Live data is coalesced per client; ?flush_bytes=<n>
+ * and ?flush_ms=<ms> override LUCIDUART_SSE_COALESCE_BYTES/_MS.
+ * Trigger engine matches arrive on the same stream as "trigger" events.
  * 
- * @param data UART data buffer
- * @param len Length of data
+ * @param policy Policy for new clients
+ * @param block_timeout_ms Socket drain timeout for WEB_SSE_BLOCK_TIMEOUT,
+ *        capped at LUCIDUART_SSE_BLOCK_TIMEOUT_MAX_MS
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG on unknown policy
  */
-void web_server_broadcast_uart_data(const uint8_t* data, size_t len);
+esp_err_t web_server_set_sse_policy(web_sse_policy_t policy, uint32_t block_timeout_ms);
 
 #ifdef __cplusplus
 }
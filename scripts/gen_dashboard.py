@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+Build the embedded dashboard page from main/web/dashboard
+
+index.html is the page as edited; its <link rel='stylesheet' href='...'>
+and <script src='...'></script> tags name files next to it. This script
+inlines those files, minifies the result and gzips it into a C header
+holding the compressed bytes, their length and a strong ETag, which
+web_server.c serves as is.
+
+Usage: gen_dashboard.py <dashboard dir> <output header>
+
+The minifiers are deliberately simple: they strip comments and layout
+whitespace, leave string literals untouched and keep any JS line break
+that automatic semicolon insertion could depend on. JS regex literals
+are not recognized, so the dashboard does not use them.
+"""
+
+import gzip
+import hashlib
+import io
+import os
+import re
+import sys
+
+LINK_RE = re.compile(r"<link rel=['\"]stylesheet['\"] href=['\"]([^'\"]+)['\"]\s*/?>")
+SCRIPT_RE = re.compile(r"<script src=['\"]([^'\"]+)['\"]>\s*</script>")
+
+# No space is needed next to these, and a line break after them never ends a statement
+JS_PUNCT = set('{}()[];,:=<>?!&|*%^~.+-/')
+JS_JOIN_AFTER = set('{([;,:=<>?!&|*%^~.+-/')
+JS_JOIN_BEFORE = set('})].,:?;')
+CSS_PUNCT = set('{};:,>')
+
+
+def split_strings(text, quotes, comments):
+    """Yield ('code', text) and ('str', literal) parts; comments are dropped"""
+    code = []
+    i = 0
+    while i < len(text):
+        c = text[i]
+        if c in quotes:
+            end = i + 1
+            while end < len(text) and text[end] != c:
+                end += 2 if text[end] == '\\' else 1
+            if code:
+                yield 'code', ''.join(code)
+                code = []
+            yield 'str', text[i:end + 1]
+            i = end + 1
+            continue
+        for start, stop in comments:
+            if text.startswith(start, i):
+                end = text.find(stop, i + len(start))
+                end = len(text) if end < 0 else end
+                # A line comment keeps its newline, a block comment becomes a space
+                i = end if stop == '\n' else end + len(stop)
+                code.append('' if stop == '\n' else ' ')
+                break
+        else:
+            code.append(c)
+            i += 1
+    if code:
+        yield 'code', ''.join(code)
+
+
+def squeeze(text, punct):
+    """Collapse blanks and drop those next to punctuation, except between + + and - -"""
+    text = re.sub(r'[ \t]+', ' ', text)
+    out = []
+    for i, c in enumerate(text):
+        if c == ' ':
+            prev = out[-1] if out else ''
+            after = text[i + 1] if i + 1 < len(text) else ''
+            if prev in punct or after in punct or prev in '\n' or after == '\n':
+                if not (prev in '+-' and prev == after):
+                    continue
+        out.append(c)
+    return ''.join(out)
+
+
+def minify_css(css):
+    parts = []
+    for kind, text in split_strings(css, '\'"', [('/*', '*/')]):
+        parts.append(text if kind == 'str' else squeeze(text.replace('\n', ' '), CSS_PUNCT))
+    return ''.join(parts).replace(';}', '}').strip()
+
+
+def minify_js(js):
+    parts = []
+    for kind, text in split_strings(js, '\'"`', [('//', '\n'), ('/*', '*/')]):
+        parts.append(text if kind == 'str' else squeeze(text, JS_PUNCT))
+    js = ''.join(parts)
+
+    # Keep a line break only where the previous line might end a statement
+    out = []
+    for line in (l.strip() for l in js.split('\n')):
+        if not line:
+            continue
+        if out:
+            prev = out[-1][-1]
+            incdec = out[-1][-2:] in ('++', '--')
+            if (prev in JS_JOIN_AFTER and not incdec) or line[0] in JS_JOIN_BEFORE:
+                out[-1] += line
+                continue
+        out.append(line)
+    return '\n'.join(out)
+
+
+def minify_html(html):
+    html = re.sub(r'<!--.*?-->', '', html, flags=re.S)
+    html = re.sub(r'>\s+<', '><', html)
+    return re.sub(r'\s+', ' ', html).strip()
+
+
+def build_page(src_dir):
+    with open(os.path.join(src_dir, 'index.html'), encoding='utf-8') as f:
+        html = minify_html(f.read())
+
+    def asset(name):
+        with open(os.path.join(src_dir, name), encoding='utf-8') as f:
+            return f.read()
+
+    def inline_style(match):
+        return '<style>' + minify_css(asset(match.group(1))) + '</style>'
+
+    def inline_script(match):
+        js = minify_js(asset(match.group(1)))
+        if '</script' in js:
+            raise ValueError('%s: "</script" would end the inlined script' % match.group(1))
+        return '<script>' + js + '</script>'
+
+    html = LINK_RE.sub(inline_style, html)
+    return SCRIPT_RE.sub(inline_script, html).encode('utf-8')
+
+
+def gzip_bytes(data):
+    # Fixed mtime and no file name, so the same page always gives the same bytes and ETag
+    buf = io.BytesIO()
+    with gzip.GzipFile(fileobj=buf, mode='wb', compresslevel=9, mtime=0, filename='') as f:
+        f.write(data)
+    return buf.getvalue()
+
+
+def source_size(src_dir):
+    return sum(os.path.getsize(os.path.join(src_dir, name)) for name in os.listdir(src_dir))
+
+
+def write_header(path, page, packed, raw_size):
+    etag = '"%s"' % hashlib.sha256(packed).hexdigest()[:16]
+    rows = []
+    for i in range(0, len(packed), 16):
+        rows.append('    ' + ', '.join('0x%02x' % b for b in packed[i:i + 16]) + ',')
+    text = '\n'.join([
+        '/*',
+        ' * Dashboard Assets - LucidConsole Embedded Dashboard',
+        ' * Generated by scripts/gen_dashboard.py from main/web/dashboard - do not edit',
+        ' */',
+        '',
+        '#pragma once',
+        '',
+        '#include <stdint.h>',
+        '',
+        '// %d source bytes, %d minified, %d gzipped' % (raw_size, len(page), len(packed)),
+        '#define LUCIDUART_DASHBOARD_GZ_LEN  %d' % len(packed),
+        '#define LUCIDUART_DASHBOARD_ETAG    "\\"%s\\""' % etag.strip('"'),
+        '',
+        'static const uint8_t dashboard_gz[LUCIDUART_DASHBOARD_GZ_LEN] __attribute__((aligned(4))) = {',
+    ] + rows + ['};', ''])
+
+    # Leave an unchanged header alone so web_server.c is not rebuilt for nothing
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return etag
+    except OSError:
+        pass
+    with open(path, 'w') as f:
+        f.write(text)
+    return etag
+
+
+def main():
+    if len(sys.argv) != 3:
+        print('usage: %s <dashboard dir> <output header>' % sys.argv[0], file=sys.stderr)
+        return 2
+    src_dir, out = sys.argv[1], sys.argv[2]
+    try:
+        page = build_page(src_dir)
+    except (OSError, ValueError) as e:
+        print('gen_dashboard: %s' % e, file=sys.stderr)
+        return 1
+    packed = gzip_bytes(page)
+    raw_size = source_size(src_dir)
+    etag = write_header(out, page, packed, raw_size)
+    print('Dashboard: %d source bytes -> %d minified -> %d gzipped, ETag %s'
+          % (raw_size, len(page), len(packed), etag))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
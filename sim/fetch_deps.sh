@@ -0,0 +1,35 @@
+#!/bin/bash
+#
+# Fetch the simulator's third-party sources at pinned releases
+#
+# Usage: fetch_deps.sh [deps_dir]
+#
+
+set -euo pipefail
+
+DEPS_DIR="${1:-deps}"
+
+FREERTOS_URL="https://github.com/FreeRTOS/FreeRTOS-Kernel.git"
+FREERTOS_TAG="V11.1.0"
+CJSON_URL="https://github.com/DaveGamble/cJSON.git"
+CJSON_TAG="v1.7.18"
+MBEDTLS_URL="https://github.com/Mbed-TLS/mbedtls.git"
+MBEDTLS_TAG="v2.16.12"      # Same base64 API as the ESP8266 SDK's mbedtls
+
+fetch() {
+    local name="$1" url="$2" tag="$3"
+    local dir="$DEPS_DIR/$name"
+
+    if [ -d "$dir" ]; then
+        echo "✓ $name already present ($dir)"
+        return
+    fi
+    echo "Fetching $name $tag..."
+    git clone --quiet --depth 1 --branch "$tag" "$url" "$dir"
+}
+
+mkdir -p "$DEPS_DIR"
+fetch FreeRTOS-Kernel "$FREERTOS_URL" "$FREERTOS_TAG"
+fetch cJSON "$CJSON_URL" "$CJSON_TAG"
+fetch mbedtls "$MBEDTLS_URL" "$MBEDTLS_TAG"
+echo "✓ Simulator dependencies ready"
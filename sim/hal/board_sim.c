@@ -0,0 +1,97 @@
+/*
+ * Board - LucidConsole Host Simulator
+ * GPIO and I2C bus stand-ins for hardware/gpio_init.c and bus/i2c_hw_bus.c
+ */
+
+#include "sim.h"
+#include "hardware/gpio_init.h"
+#include "bus/i2c_hw_bus.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+
+static const char* TAG = "SIM_BOARD";
+
+static uint8_t gpio_levels[GPIO_NUM_MAX];
+
+/*
+ * GPIO driver
+ */
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode) {
+    return (gpio_num < GPIO_NUM_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull) {
+    return (gpio_num < GPIO_NUM_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    if (gpio_num >= GPIO_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    gpio_levels[gpio_num] = level ? 1 : 0;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+    return (gpio_num < GPIO_NUM_MAX) ? gpio_levels[gpio_num] : 0;
+}
+
+/*
+ * Board GPIO (hardware/gpio_init.h)
+ */
+
+esp_err_t gpio_early_init(void) {
+    // Boot button idles high through its pull-up; OLED starts powered off
+    gpio_levels[GPIO_BOOT_BUTTON] = 1;
+    gpio_levels[GPIO_OLED_POWER] = 1;
+    return ESP_OK;
+}
+
+esp_err_t gpio_oled_power_on(void) {
+    return gpio_set_level(GPIO_OLED_POWER, 0);
+}
+
+esp_err_t gpio_oled_power_off(void) {
+    return gpio_set_level(GPIO_OLED_POWER, 1);
+}
+
+esp_err_t gpio_boot_button_init(void) {
+    return ESP_OK;
+}
+
+bool gpio_boot_button_pressed(void) {
+    return gpio_get_level(GPIO_BOOT_BUTTON) == 0;
+}
+
+/*
+ * I2C bus (bus/i2c_hw_bus.h) - the only device is the simulated OLED
+ */
+
+esp_err_t i2c_hw_bus_init(void) {
+    ESP_LOGI(TAG, "I2C bus simulated, OLED at 0x3C");
+    return ESP_OK;
+}
+
+esp_err_t i2c_hw_bus_lock(uint32_t timeout_ms) {
+    return ESP_OK;
+}
+
+void i2c_hw_bus_unlock(void) {
+}
+
+esp_err_t i2c_hw_write_cmd(uint8_t device_addr, uint8_t reg_addr, uint8_t command) {
+    return ESP_OK;
+}
+
+esp_err_t i2c_hw_write_data(uint8_t device_addr, uint8_t reg_addr, uint8_t *data, size_t data_len) {
+    return ESP_OK;
+}
+
+esp_err_t i2c_hw_read_data(uint8_t device_addr, uint8_t reg_addr, uint8_t *data, size_t data_len) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+int i2c_hw_scan_devices(void) {
+    return 1;
+}
@@ -0,0 +1,162 @@
+/*
+ * Flash Partitions - LucidConsole Host Simulator
+ * Board partition table over RAM images, written through to --state-dir
+ */
+
+#include "sim.h"
+#include "esp_partition.h"
+#include "esp_log.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char* TAG = "SIM_FLASH";
+
+// Data partitions from boards/*/partitions_ota.csv
+static const esp_partition_t sim_partitions[] = {
+    {
+        .type = ESP_PARTITION_TYPE_DATA,
+        .subtype = ESP_PARTITION_SUBTYPE_DATA_NVS,
+        .address = 0x9000,
+        .size = 0x4000,
+        .label = "nvs",
+    },
+    {
+        .type = ESP_PARTITION_TYPE_DATA,
+        .subtype = (esp_partition_subtype_t)0x40,
+        .address = 0x110000,
+        .size = 0xF0000,
+        .label = "capture",
+    },
+};
+
+#define SIM_PARTITION_COUNT (sizeof(sim_partitions) / sizeof(sim_partitions[0]))
+
+// Image and backing file per partition, opened on first access
+static struct {
+    uint8_t* image;
+    int fd;
+} sim_flash[SIM_PARTITION_COUNT];
+
+/**
+ * @brief Map a partition to its image, loading it from the state file
+ */
+static uint8_t* partition_image(const esp_partition_t* partition) {
+    if (partition < sim_partitions || partition >= sim_partitions + SIM_PARTITION_COUNT) {
+        return NULL;
+    }
+    size_t index = partition - sim_partitions;
+    if (sim_flash[index].image) {
+        return sim_flash[index].image;
+    }
+
+    uint8_t* image = sim_host_malloc(partition->size);
+    if (!image) {
+        return NULL;
+    }
+    memset(image, 0xFF, partition->size);   // Erased NOR flash
+    sim_flash[index].fd = -1;
+
+    char name[32];
+    char path[256];
+    snprintf(name, sizeof(name), "flash_%s.bin", partition->label);
+    if (sim_state_path(name, path, sizeof(path))) {
+        int fd = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            ESP_LOGW(TAG, "Cannot open %s, partition '%s' stays in RAM", path, partition->label);
+        } else {
+            ssize_t got = pread(fd, image, partition->size, 0);
+            if (got < (ssize_t)partition->size) {
+                // New or short image: pad with erased bytes
+                size_t have = (got > 0) ? (size_t)got : 0;
+                if (pwrite(fd, image + have, partition->size - have, have) < 0) {
+                    ESP_LOGW(TAG, "Cannot extend %s", path);
+                }
+            }
+            sim_flash[index].fd = fd;
+        }
+    }
+    sim_flash[index].image = image;
+    return image;
+}
+
+static void partition_sync(const esp_partition_t* partition, size_t offset, size_t size) {
+    size_t index = partition - sim_partitions;
+    if (sim_flash[index].fd >= 0 &&
+        pwrite(sim_flash[index].fd, sim_flash[index].image + offset, size, offset) != (ssize_t)size) {
+        ESP_LOGW(TAG, "Write-through to '%s' image failed", partition->label);
+    }
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type,
+                                                esp_partition_subtype_t subtype,
+                                                const char* label) {
+    for (size_t i = 0; i < SIM_PARTITION_COUNT; i++) {
+        const esp_partition_t* partition = &sim_partitions[i];
+        if (partition->type == type &&
+            (subtype == ESP_PARTITION_SUBTYPE_ANY || partition->subtype == subtype) &&
+            (!label || strcmp(partition->label, label) == 0)) {
+            return partition;
+        }
+    }
+    return NULL;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset,
+                             void* dst, size_t size) {
+    if (!partition || !dst) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (src_offset > partition->size || size > partition->size - src_offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint8_t* image = partition_image(partition);
+    if (!image) {
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(dst, image + src_offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t dst_offset,
+                              const void* src, size_t size) {
+    if (!partition || !src) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dst_offset > partition->size || size > partition->size - dst_offset) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint8_t* image = partition_image(partition);
+    if (!image) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // NOR programming only clears bits; unerased areas keep stale ones
+    const uint8_t* bytes = (const uint8_t*)src;
+    for (size_t i = 0; i < size; i++) {
+        image[dst_offset + i] &= bytes[i];
+    }
+    partition_sync(partition, dst_offset, size);
+    return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t start_addr,
+                                    size_t size) {
+    if (!partition) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (start_addr % SPI_FLASH_SEC_SIZE || size % SPI_FLASH_SEC_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (start_addr > partition->size || size > partition->size - start_addr) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint8_t* image = partition_image(partition);
+    if (!image) {
+        return ESP_ERR_NO_MEM;
+    }
+    memset(image + start_addr, 0xFF, size);
+    partition_sync(partition, start_addr, size);
+    return ESP_OK;
+}
@@ -0,0 +1,275 @@
+/*
+ * ESP System - LucidConsole Host Simulator
+ * Clock, logging, heap accounting and error names
+ */
+
+#include "sim.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_http_server.h"
+#include "esp_wifi.h"
+#include "nvs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <malloc.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static int64_t sim_start_us = 0;
+
+// Live bytes the firmware holds through malloc (see --wrap in the Makefile)
+static size_t heap_used = 0;
+static size_t heap_peak = 0;
+
+// Per-tag log levels set with esp_log_level_set()
+#define SIM_LOG_TAGS 16
+static struct {
+    const char* tag;
+    esp_log_level_t level;
+} log_tags[SIM_LOG_TAGS];
+static size_t log_tag_count = 0;
+
+static int64_t monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void sim_system_init(void) {
+    sim_start_us = monotonic_us();
+    srandom((unsigned)sim_start_us);
+}
+
+int64_t esp_timer_get_time(void) {
+    return monotonic_us() - sim_start_us;
+}
+
+uint32_t esp_log_timestamp(void) {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+void esp_log_level_set(const char* tag, esp_log_level_t level) {
+    if (strcmp(tag, "*") == 0) {
+        sim_options.log_level = level;
+        log_tag_count = 0;
+        return;
+    }
+    for (size_t i = 0; i < log_tag_count; i++) {
+        if (strcmp(log_tags[i].tag, tag) == 0) {
+            log_tags[i].level = level;
+            return;
+        }
+    }
+    if (log_tag_count < SIM_LOG_TAGS) {
+        log_tags[log_tag_count].tag = tag;
+        log_tags[log_tag_count].level = level;
+        log_tag_count++;
+    }
+}
+
+static esp_log_level_t log_level_for(const char* tag) {
+    for (size_t i = 0; i < log_tag_count; i++) {
+        if (strcmp(log_tags[i].tag, tag) == 0) {
+            return log_tags[i].level;
+        }
+    }
+    return sim_options.log_level;
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format, ...) {
+    if (level > log_level_for(tag)) {
+        return;
+    }
+
+    bool running = xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+    if (running) {
+        vTaskSuspendAll();
+    }
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    if (running) {
+        xTaskResumeAll();
+    }
+}
+
+/*
+ * Heap
+ *
+ * Firmware objects are linked with --wrap=malloc,calloc,realloc,free so
+ * their allocations are counted against configTOTAL_HEAP_SIZE and run
+ * with the scheduler suspended: a task switch while one host thread
+ * holds a glibc arena lock would deadlock the next task that allocates.
+ * Kernel objects and task stacks come from pvPortMalloc and are not
+ * counted, since host stacks are far larger than the device's.
+ */
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static void heap_lock(void) {
+    vTaskSuspendAll();
+}
+
+static void heap_unlock(void) {
+    xTaskResumeAll();
+}
+
+static void heap_account(void* added, size_t removed) {
+    heap_used -= removed;
+    if (added) {
+        heap_used += malloc_usable_size(added);
+    }
+    if (heap_used > heap_peak) {
+        heap_peak = heap_used;
+    }
+}
+
+void* __wrap_malloc(size_t size) {
+    heap_lock();
+    void* ptr = __real_malloc(size);
+    heap_account(ptr, 0);
+    heap_unlock();
+    return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    heap_lock();
+    void* ptr = __real_calloc(count, size);
+    heap_account(ptr, 0);
+    heap_unlock();
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    heap_lock();
+    size_t old = ptr ? malloc_usable_size(ptr) : 0;
+    void* result = __real_realloc(ptr, size);
+    if (result || size == 0) {
+        heap_account(result, old);
+    }
+    heap_unlock();
+    return result;
+}
+
+void __wrap_free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    heap_lock();
+    heap_account(NULL, malloc_usable_size(ptr));
+    __real_free(ptr);
+    heap_unlock();
+}
+
+void* pvPortMalloc(size_t size) {
+    heap_lock();
+    void* ptr = __real_malloc(size);
+    heap_unlock();
+    return ptr;
+}
+
+void vPortFree(void* ptr) {
+    heap_lock();
+    __real_free(ptr);
+    heap_unlock();
+}
+
+void* sim_host_malloc(size_t size) {
+    return pvPortMalloc(size);
+}
+
+uint32_t esp_get_free_heap_size(void) {
+    size_t used = heap_used;
+    return (used < configTOTAL_HEAP_SIZE) ? configTOTAL_HEAP_SIZE - used : 0;
+}
+
+uint32_t esp_get_minimum_free_heap_size(void) {
+    size_t peak = heap_peak;
+    return (peak < configTOTAL_HEAP_SIZE) ? configTOTAL_HEAP_SIZE - peak : 0;
+}
+
+uint32_t esp_random(void) {
+    return ((uint32_t)random() << 16) ^ (uint32_t)random();
+}
+
+void esp_restart(void) {
+    fprintf(stderr, "esp_restart() - simulator exiting\n");
+    fflush(stderr);
+    exit(0);
+}
+
+void sim_assert_failed(const char* file, unsigned long line) {
+    fprintf(stderr, "FreeRTOS assertion failed at %s:%lu\n", file, line);
+    fflush(stderr);
+    abort();
+}
+
+/*
+ * Error names
+ */
+
+#define ERR_TBL_IT(err) { err, #err }
+
+static const struct {
+    esp_err_t code;
+    const char* name;
+} esp_err_msg_table[] = {
+    ERR_TBL_IT(ESP_OK),
+    ERR_TBL_IT(ESP_FAIL),
+    ERR_TBL_IT(ESP_ERR_NO_MEM),
+    ERR_TBL_IT(ESP_ERR_INVALID_ARG),
+    ERR_TBL_IT(ESP_ERR_INVALID_STATE),
+    ERR_TBL_IT(ESP_ERR_INVALID_SIZE),
+    ERR_TBL_IT(ESP_ERR_NOT_FOUND),
+    ERR_TBL_IT(ESP_ERR_NOT_SUPPORTED),
+    ERR_TBL_IT(ESP_ERR_TIMEOUT),
+    ERR_TBL_IT(ESP_ERR_INVALID_RESPONSE),
+    ERR_TBL_IT(ESP_ERR_INVALID_CRC),
+    ERR_TBL_IT(ESP_ERR_INVALID_VERSION),
+    ERR_TBL_IT(ESP_ERR_INVALID_MAC),
+    ERR_TBL_IT(ESP_ERR_NVS_NOT_INITIALIZED),
+    ERR_TBL_IT(ESP_ERR_NVS_NOT_FOUND),
+    ERR_TBL_IT(ESP_ERR_NVS_READ_ONLY),
+    ERR_TBL_IT(ESP_ERR_NVS_NOT_ENOUGH_SPACE),
+    ERR_TBL_IT(ESP_ERR_NVS_INVALID_NAME),
+    ERR_TBL_IT(ESP_ERR_NVS_INVALID_HANDLE),
+    ERR_TBL_IT(ESP_ERR_NVS_KEY_TOO_LONG),
+    ERR_TBL_IT(ESP_ERR_NVS_INVALID_LENGTH),
+    ERR_TBL_IT(ESP_ERR_NVS_NO_FREE_PAGES),
+    ERR_TBL_IT(ESP_ERR_NVS_NEW_VERSION_FOUND),
+    ERR_TBL_IT(ESP_ERR_WIFI_NOT_INIT),
+    ERR_TBL_IT(ESP_ERR_WIFI_NOT_STARTED),
+    ERR_TBL_IT(ESP_ERR_WIFI_IF),
+    ERR_TBL_IT(ESP_ERR_WIFI_MODE),
+    ERR_TBL_IT(ESP_ERR_TCPIP_ADAPTER_INVALID_PARAMS),
+    ERR_TBL_IT(ESP_ERR_TCPIP_ADAPTER_IF_NOT_READY),
+    ERR_TBL_IT(ESP_ERR_TCPIP_ADAPTER_DHCPC_START_FAILED),
+    ERR_TBL_IT(ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STARTED),
+    ERR_TBL_IT(ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STOPPED),
+    ERR_TBL_IT(ESP_ERR_HTTPD_HANDLERS_FULL),
+    ERR_TBL_IT(ESP_ERR_HTTPD_HANDLER_EXISTS),
+    ERR_TBL_IT(ESP_ERR_HTTPD_INVALID_REQ),
+    ERR_TBL_IT(ESP_ERR_HTTPD_RESULT_TRUNC),
+    ERR_TBL_IT(ESP_ERR_HTTPD_RESP_HDR),
+    ERR_TBL_IT(ESP_ERR_HTTPD_RESP_SEND),
+    ERR_TBL_IT(ESP_ERR_HTTPD_ALLOC_MEM),
+    ERR_TBL_IT(ESP_ERR_HTTPD_TASK),
+};
+
+const char* esp_err_to_name(esp_err_t code) {
+    for (size_t i = 0; i < sizeof(esp_err_msg_table) / sizeof(esp_err_msg_table[0]); i++) {
+        if (esp_err_msg_table[i].code == code) {
+            return esp_err_msg_table[i].name;
+        }
+    }
+    return "UNKNOWN ERROR";
+}
@@ -0,0 +1,316 @@
+/*
+ * ESP WiFi - LucidConsole Host Simulator
+ * Default event loop, radio-less WiFi driver and tcpip adapter
+ */
+
+#include "sim.h"
+#include "esp_event.h"
+#include "esp_wifi.h"
+#include "tcpip_adapter.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include <string.h>
+
+static const char* TAG = "SIM_WIFI";
+
+#define EVENT_QUEUE_DEPTH       16
+#define EVENT_TASK_PRIORITY     (configMAX_PRIORITIES - 5)     // ESP_TASK_EVENT_PRIO
+#define EVENT_TASK_STACK        2048
+
+ESP_EVENT_DEFINE_BASE(WIFI_EVENT);
+ESP_EVENT_DEFINE_BASE(IP_EVENT);
+
+typedef struct {
+    esp_event_base_t base;
+    int32_t id;
+    size_t size;
+    uint8_t data[LUCIDSIM_EVENT_DATA_MAX];
+} sim_event_t;
+
+static struct {
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t handler;
+    void* arg;
+} event_handlers[LUCIDSIM_EVENT_HANDLERS];
+static size_t event_handler_count = 0;
+static QueueHandle_t event_queue = NULL;
+
+// Radio state
+static bool wifi_initialized = false;
+static bool wifi_started = false;
+static bool sta_connected = false;
+static wifi_mode_t wifi_mode = WIFI_MODE_NULL;
+static wifi_config_t wifi_configs[ESP_IF_MAX];
+static tcpip_adapter_ip_info_t if_ip_info[TCPIP_ADAPTER_IF_MAX];
+static bool dhcps_running = true;
+
+// Espressif OUI, then "LC" for the station and AP
+static const uint8_t sim_mac[ESP_IF_MAX][6] = {
+    { 0x5c, 0xcf, 0x7f, 0x4c, 0x43, 0x01 },
+    { 0x5e, 0xcf, 0x7f, 0x4c, 0x43, 0x01 },
+};
+
+/*
+ * Event loop
+ */
+
+static void event_task(void* pvParameters) {
+    sim_event_t event;
+    while (true) {
+        if (xQueueReceive(event_queue, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        for (size_t i = 0; i < event_handler_count; i++) {
+            if (event_handlers[i].base == event.base &&
+                (event_handlers[i].id == ESP_EVENT_ANY_ID || event_handlers[i].id == event.id)) {
+                event_handlers[i].handler(event_handlers[i].arg, event.base, event.id,
+                                          event.size ? event.data : NULL);
+            }
+        }
+    }
+}
+
+esp_err_t esp_event_loop_create_default(void) {
+    if (event_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    event_queue = xQueueCreate(EVENT_QUEUE_DEPTH, sizeof(sim_event_t));
+    if (!event_queue) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (xTaskCreate(event_task, "esp_event", EVENT_TASK_STACK, NULL,
+                    EVENT_TASK_PRIORITY, NULL) != pdPASS) {
+        vQueueDelete(event_queue);
+        event_queue = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id,
+                                     esp_event_handler_t event_handler, void* event_handler_arg) {
+    if (!event_handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (event_handler_count == LUCIDSIM_EVENT_HANDLERS) {
+        return ESP_ERR_NO_MEM;
+    }
+    event_handlers[event_handler_count].base = event_base;
+    event_handlers[event_handler_count].id = event_id;
+    event_handlers[event_handler_count].handler = event_handler;
+    event_handlers[event_handler_count].arg = event_handler_arg;
+    event_handler_count++;
+    return ESP_OK;
+}
+
+esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
+                         void* event_data, size_t event_data_size, TickType_t ticks_to_wait) {
+    if (!event_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (event_data_size > LUCIDSIM_EVENT_DATA_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    sim_event_t event = {
+        .base = event_base,
+        .id = event_id,
+        .size = event_data_size,
+    };
+    if (event_data_size) {
+        memcpy(event.data, event_data, event_data_size);
+    }
+    return (xQueueSend(event_queue, &event, ticks_to_wait) == pdTRUE) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+/*
+ * tcpip adapter
+ */
+
+void tcpip_adapter_init(void) {
+    memset(if_ip_info, 0, sizeof(if_ip_info));
+    IP4_ADDR(&if_ip_info[TCPIP_ADAPTER_IF_AP].ip, 192, 168, 4, 1);
+    IP4_ADDR(&if_ip_info[TCPIP_ADAPTER_IF_AP].gw, 192, 168, 4, 1);
+    IP4_ADDR(&if_ip_info[TCPIP_ADAPTER_IF_AP].netmask, 255, 255, 255, 0);
+}
+
+esp_err_t tcpip_adapter_set_ip_info(tcpip_adapter_if_t tcpip_if, const tcpip_adapter_ip_info_t* ip_info) {
+    if (tcpip_if >= TCPIP_ADAPTER_IF_MAX || !ip_info) {
+        return ESP_ERR_TCPIP_ADAPTER_INVALID_PARAMS;
+    }
+    if (tcpip_if == TCPIP_ADAPTER_IF_AP && dhcps_running) {
+        return ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STARTED;
+    }
+    if_ip_info[tcpip_if] = *ip_info;
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_get_ip_info(tcpip_adapter_if_t tcpip_if, tcpip_adapter_ip_info_t* ip_info) {
+    if (tcpip_if >= TCPIP_ADAPTER_IF_MAX || !ip_info) {
+        return ESP_ERR_TCPIP_ADAPTER_INVALID_PARAMS;
+    }
+    *ip_info = if_ip_info[tcpip_if];
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_dhcps_start(tcpip_adapter_if_t tcpip_if) {
+    if (tcpip_if != TCPIP_ADAPTER_IF_AP) {
+        return ESP_ERR_TCPIP_ADAPTER_INVALID_PARAMS;
+    }
+    if (dhcps_running) {
+        return ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STARTED;
+    }
+    dhcps_running = true;
+    return ESP_OK;
+}
+
+esp_err_t tcpip_adapter_dhcps_stop(tcpip_adapter_if_t tcpip_if) {
+    if (tcpip_if != TCPIP_ADAPTER_IF_AP) {
+        return ESP_ERR_TCPIP_ADAPTER_INVALID_PARAMS;
+    }
+    if (!dhcps_running) {
+        return ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STOPPED;
+    }
+    dhcps_running = false;
+    return ESP_OK;
+}
+
+/*
+ * WiFi driver
+ */
+
+esp_err_t esp_wifi_init(const wifi_init_config_t* config) {
+    if (!config || config->magic != WIFI_INIT_CONFIG_MAGIC) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    wifi_initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode) {
+    if (!wifi_initialized) {
+        return ESP_ERR_WIFI_NOT_INIT;
+    }
+    if (mode >= WIFI_MODE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    wifi_mode = mode;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_mode(wifi_mode_t* mode) {
+    if (!mode) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *mode = wifi_mode;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t* conf) {
+    if (!wifi_initialized) {
+        return ESP_ERR_WIFI_NOT_INIT;
+    }
+    if (interface >= ESP_IF_MAX || !conf) {
+        return ESP_ERR_WIFI_IF;
+    }
+    wifi_configs[interface] = *conf;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_start(void) {
+    if (!wifi_initialized) {
+        return ESP_ERR_WIFI_NOT_INIT;
+    }
+    wifi_started = true;
+    if (wifi_mode == WIFI_MODE_STA || wifi_mode == WIFI_MODE_APSTA) {
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, NULL, 0, portMAX_DELAY);
+    }
+    if (wifi_mode == WIFI_MODE_AP || wifi_mode == WIFI_MODE_APSTA) {
+        ESP_LOGI(TAG, "SoftAP \"%s\" (no radio; serving on the host network)",
+                 (const char*)wifi_configs[ESP_IF_WIFI_AP].ap.ssid);
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_AP_START, NULL, 0, portMAX_DELAY);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_stop(void) {
+    if (!wifi_initialized) {
+        return ESP_ERR_WIFI_NOT_INIT;
+    }
+    if (wifi_started && (wifi_mode == WIFI_MODE_STA || wifi_mode == WIFI_MODE_APSTA)) {
+        sta_connected = false;
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_STOP, NULL, 0, portMAX_DELAY);
+    }
+    if (wifi_started && (wifi_mode == WIFI_MODE_AP || wifi_mode == WIFI_MODE_APSTA)) {
+        esp_event_post(WIFI_EVENT, WIFI_EVENT_AP_STOP, NULL, 0, portMAX_DELAY);
+    }
+    wifi_started = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_connect(void) {
+    if (!wifi_started) {
+        return ESP_ERR_WIFI_NOT_STARTED;
+    }
+    if (wifi_mode != WIFI_MODE_STA && wifi_mode != WIFI_MODE_APSTA) {
+        return ESP_ERR_WIFI_MODE;
+    }
+
+    // Any SSID "associates"; the station address is the host loopback
+    const wifi_sta_config_t* sta = &wifi_configs[ESP_IF_WIFI_STA].sta;
+    wifi_event_sta_connected_t connected = {
+        .ssid_len = (uint8_t)strnlen((const char*)sta->ssid, sizeof(sta->ssid)),
+        .bssid = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 },
+        .channel = 1,
+        .authmode = WIFI_AUTH_WPA_WPA2_PSK,
+    };
+    memcpy(connected.ssid, sta->ssid, sizeof(connected.ssid));
+    sta_connected = true;
+    esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_CONNECTED, &connected, sizeof(connected), portMAX_DELAY);
+
+    ip_event_got_ip_t got_ip = {
+        .if_index = TCPIP_ADAPTER_IF_STA,
+        .ip_changed = true,
+    };
+    IP4_ADDR(&got_ip.ip_info.ip, 127, 0, 0, 1);
+    IP4_ADDR(&got_ip.ip_info.gw, 127, 0, 0, 1);
+    IP4_ADDR(&got_ip.ip_info.netmask, 255, 0, 0, 0);
+    if_ip_info[TCPIP_ADAPTER_IF_STA] = got_ip.ip_info;
+    esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &got_ip, sizeof(got_ip), portMAX_DELAY);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_disconnect(void) {
+    if (!wifi_started) {
+        return ESP_ERR_WIFI_NOT_STARTED;
+    }
+    sta_connected = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_mac(wifi_interface_t ifx, uint8_t mac[6]) {
+    if (ifx >= ESP_IF_MAX || !mac) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memcpy(mac, sim_mac[ifx], 6);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_sta_get_ap_info(wifi_ap_record_t* ap_info) {
+    if (!ap_info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!sta_connected) {
+        return ESP_ERR_WIFI_NOT_STARTED;
+    }
+    const wifi_sta_config_t* sta = &wifi_configs[ESP_IF_WIFI_STA].sta;
+    memset(ap_info, 0, sizeof(*ap_info));
+    memcpy(ap_info->ssid, sta->ssid, sizeof(sta->ssid));
+    ap_info->primary = 1;
+    ap_info->rssi = -40;
+    ap_info->authmode = WIFI_AUTH_WPA_WPA2_PSK;
+    return ESP_OK;
+}
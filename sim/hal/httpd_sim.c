@@ -0,0 +1,843 @@
+/*
+ * HTTP Server - LucidConsole Host Simulator
+ * esp_http_server subset on host sockets, polled from one server task
+ */
+
+#include "sim.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static const char* TAG = "SIM_HTTPD";
+
+#define HTTPD_SIM_SEND_FLAGS    MSG_NOSIGNAL
+
+typedef struct httpd_sim_server httpd_sim_server_t;
+
+// Extra response header set with httpd_resp_set_hdr()
+typedef struct {
+    const char* field;
+    const char* value;
+} httpd_sim_hdr_t;
+
+// One client connection and its in-flight request
+typedef struct {
+    bool used;
+    bool close_pending;                 // httpd_sess_trigger_close() or a failed handler
+    int fd;
+    void* ctx;
+    httpd_free_ctx_fn_t free_ctx;
+
+    // Bytes received but not yet consumed by a request
+    char rx[HTTPD_MAX_REQ_HDR_LEN];
+    size_t rx_len;
+
+    // Current request
+    httpd_req_t req;
+    char hdr[HTTPD_MAX_REQ_HDR_LEN + 1];
+    size_t body_left;                   // Content bytes not yet read by the handler
+    bool keep_alive;
+
+    // Current response
+    const char* status;
+    const char* type;
+    httpd_sim_hdr_t* resp_hdrs;
+    size_t resp_hdr_count;
+    bool chunked;                       // Headers sent, chunked body open
+} httpd_sim_sess_t;
+
+struct httpd_sim_server {
+    httpd_config_t config;
+    httpd_uri_t* handlers;
+    size_t handler_count;
+    httpd_sim_sess_t* sessions;
+    int listen_fd;
+    SemaphoreHandle_t mutex;            // Guards sessions against httpd_socket_send()
+    TaskHandle_t task;
+    volatile bool running;
+    volatile bool stopped;
+};
+
+/*
+ * Sessions
+ */
+
+static httpd_sim_sess_t* sess_by_fd(httpd_sim_server_t* server, int fd) {
+    for (size_t i = 0; i < server->config.max_open_sockets; i++) {
+        if (server->sessions[i].used && server->sessions[i].fd == fd) {
+            return &server->sessions[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Close a session from the server task
+ *
+ * The session destructor runs before the socket is closed and outside
+ * server->mutex: it may take application locks that are held around
+ * httpd_socket_send(), and the descriptor must not be reused by a new
+ * client while another task can still address it.
+ */
+static void sess_close(httpd_sim_server_t* server, httpd_sim_sess_t* sess) {
+    xSemaphoreTake(server->mutex, portMAX_DELAY);
+    sess->close_pending = true;
+    void* ctx = sess->ctx;
+    httpd_free_ctx_fn_t free_ctx = sess->free_ctx;
+    sess->ctx = NULL;
+    sess->free_ctx = NULL;
+    xSemaphoreGive(server->mutex);
+
+    if (ctx) {
+        if (free_ctx) {
+            free_ctx(ctx);
+        } else {
+            free(ctx);
+        }
+    }
+
+    xSemaphoreTake(server->mutex, portMAX_DELAY);
+    close(sess->fd);
+    sess->used = false;
+    xSemaphoreGive(server->mutex);
+}
+
+/**
+ * @brief Send on a session, waiting up to send_wait_timeout if the socket is full
+ *
+ * @return Bytes sent, or an HTTPD_SOCK_ERR_* code
+ */
+static int sess_send(httpd_sim_server_t* server, int fd, const char* buf, size_t len, bool wait) {
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(server->config.send_wait_timeout * 1000);
+    size_t done = 0;
+
+    while (done < len) {
+        xSemaphoreTake(server->mutex, portMAX_DELAY);
+        httpd_sim_sess_t* sess = sess_by_fd(server, fd);
+        bool open = sess && !sess->close_pending;
+        ssize_t sent = -1;
+        int err = 0;
+        if (open) {
+            sent = send(fd, buf + done, len - done, MSG_DONTWAIT | HTTPD_SIM_SEND_FLAGS);
+            err = errno;
+        }
+        xSemaphoreGive(server->mutex);
+
+        if (!open) {
+            return HTTPD_SOCK_ERR_INVALID;
+        }
+        if (sent > 0) {
+            done += sent;
+            continue;
+        }
+        if (sent < 0 && err != EAGAIN && err != EWOULDBLOCK && err != EINTR) {
+            return HTTPD_SOCK_ERR_FAIL;
+        }
+        if (!wait) {
+            return done ? (int)done : HTTPD_SOCK_ERR_TIMEOUT;
+        }
+        if (xTaskGetTickCount() - start >= timeout) {
+            return HTTPD_SOCK_ERR_TIMEOUT;
+        }
+        vTaskDelay(1);
+    }
+    return (int)done;
+}
+
+static httpd_sim_sess_t* req_sess(httpd_req_t* r) {
+    return r ? (httpd_sim_sess_t*)r->aux : NULL;
+}
+
+static esp_err_t req_send(httpd_req_t* r, const char* buf, size_t len) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (len == 0) {
+        return ESP_OK;
+    }
+    int sent = sess_send((httpd_sim_server_t*)r->handle, sess->fd, buf, len, true);
+    return (sent == (int)len) ? ESP_OK : ESP_ERR_HTTPD_RESP_SEND;
+}
+
+/**
+ * @brief Send the status line and headers of the current response
+ *
+ * @param content_len Body length, or -1 for a chunked body
+ */
+static esp_err_t req_send_head(httpd_req_t* r, ssize_t content_len) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    char head[HTTPD_MAX_REQ_HDR_LEN];
+    int len = snprintf(head, sizeof(head), "HTTP/1.1 %s\r\nContent-Type: %s\r\n",
+                       sess->status, sess->type);
+    if (content_len >= 0) {
+        len += snprintf(head + len, sizeof(head) - len, "Content-Length: %d\r\n", (int)content_len);
+    } else {
+        len += snprintf(head + len, sizeof(head) - len, "Transfer-Encoding: chunked\r\n");
+    }
+    for (size_t i = 0; i < sess->resp_hdr_count && len < (int)sizeof(head); i++) {
+        len += snprintf(head + len, sizeof(head) - len, "%s: %s\r\n",
+                        sess->resp_hdrs[i].field, sess->resp_hdrs[i].value);
+    }
+    if (len + 2 >= (int)sizeof(head)) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+    memcpy(head + len, "\r\n", 2);
+    return req_send(r, head, len + 2);
+}
+
+/*
+ * Requests
+ */
+
+static const char* hdr_find(httpd_sim_sess_t* sess, const char* field, size_t* value_len) {
+    size_t field_len = strlen(field);
+    const char* line = strstr(sess->hdr, "\r\n");
+    while (line && line[2] != '\r' && line[2] != '\0') {
+        line += 2;
+        const char* end = strstr(line, "\r\n");
+        if (!end) {
+            break;
+        }
+        if ((size_t)(end - line) > field_len && line[field_len] == ':' &&
+            strncasecmp(line, field, field_len) == 0) {
+            const char* value = line + field_len + 1;
+            while (*value == ' ' || *value == '\t') {
+                value++;
+            }
+            *value_len = end - value;
+            return value;
+        }
+        line = end;
+    }
+    return NULL;
+}
+
+static int method_from_name(const char* name, size_t len) {
+    static const struct {
+        const char* name;
+        httpd_method_t method;
+    } methods[] = {
+        { "DELETE", HTTP_DELETE },
+        { "GET", HTTP_GET },
+        { "HEAD", HTTP_HEAD },
+        { "POST", HTTP_POST },
+        { "PUT", HTTP_PUT },
+    };
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        if (strlen(methods[i].name) == len && strncmp(methods[i].name, name, len) == 0) {
+            return methods[i].method;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Split the header block off the session buffer and fill in the request
+ *
+ * @return ESP_OK, or ESP_ERR_HTTPD_INVALID_REQ after answering with an error
+ */
+static esp_err_t req_parse(httpd_sim_server_t* server, httpd_sim_sess_t* sess, size_t hdr_len) {
+    memcpy(sess->hdr, sess->rx, hdr_len);
+    sess->hdr[hdr_len] = '\0';
+    sess->rx_len -= hdr_len;
+    memmove(sess->rx, sess->rx + hdr_len, sess->rx_len);
+
+    httpd_req_t* r = &sess->req;
+    memset(r, 0, sizeof(*r));
+    r->handle = server;
+    r->aux = sess;
+    r->sess_ctx = sess->ctx;
+    r->free_ctx = sess->free_ctx;
+    sess->status = HTTPD_200;
+    sess->type = HTTPD_TYPE_TEXT;
+    sess->resp_hdr_count = 0;
+    sess->chunked = false;
+    sess->body_left = 0;
+
+    // Request line: METHOD SP URI SP VERSION
+    char* method_end = strchr(sess->hdr, ' ');
+    char* uri = method_end ? method_end + 1 : NULL;
+    char* uri_end = uri ? strchr(uri, ' ') : NULL;
+    if (!uri_end) {
+        httpd_resp_send_err(r, HTTPD_400_BAD_REQUEST, NULL);
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+    r->method = method_from_name(sess->hdr, method_end - sess->hdr);
+    if (r->method < 0) {
+        httpd_resp_send_err(r, HTTPD_501_METHOD_NOT_IMPLEMENTED, NULL);
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+    if (uri_end - uri > HTTPD_MAX_URI_LEN) {
+        httpd_resp_send_err(r, HTTPD_414_URI_TOO_LONG, NULL);
+        return ESP_ERR_HTTPD_INVALID_REQ;
+    }
+    memcpy((char*)r->uri, uri, uri_end - uri);
+    ((char*)r->uri)[uri_end - uri] = '\0';
+
+    size_t len;
+    const char* value = hdr_find(sess, "Content-Length", &len);
+    if (value) {
+        r->content_len = strtoul(value, NULL, 10);
+    }
+    sess->body_left = r->content_len;
+    value = hdr_find(sess, "Connection", &len);
+    sess->keep_alive = !(value && len == 5 && strncasecmp(value, "close", 5) == 0);
+    return ESP_OK;
+}
+
+static const httpd_uri_t* uri_match(httpd_sim_server_t* server, httpd_req_t* r, bool* uri_known) {
+    size_t path_len = strcspn(r->uri, "?");
+    *uri_known = false;
+    for (size_t i = 0; i < server->handler_count; i++) {
+        const httpd_uri_t* handler = &server->handlers[i];
+        if (strlen(handler->uri) == path_len && strncmp(handler->uri, r->uri, path_len) == 0) {
+            *uri_known = true;
+            if ((int)handler->method == r->method) {
+                return handler;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run one request that has its headers in sess->rx
+ *
+ * @return false if the session must be closed
+ */
+static bool req_process(httpd_sim_server_t* server, httpd_sim_sess_t* sess, size_t hdr_len) {
+    if (req_parse(server, sess, hdr_len) != ESP_OK) {
+        return false;
+    }
+
+    httpd_req_t* r = &sess->req;
+    bool uri_known;
+    const httpd_uri_t* handler = uri_match(server, r, &uri_known);
+    esp_err_t ret;
+    if (!handler) {
+        ret = httpd_resp_send_err(r, uri_known ? HTTPD_405_METHOD_NOT_ALLOWED : HTTPD_404_NOT_FOUND, NULL);
+    } else {
+        r->user_ctx = handler->user_ctx;
+        ret = handler->handler(r);
+    }
+
+    // Session context set or replaced by the handler
+    if (!r->ignore_sess_ctx_changes && r->sess_ctx != sess->ctx) {
+        if (sess->ctx) {
+            if (sess->free_ctx) {
+                sess->free_ctx(sess->ctx);
+            } else {
+                free(sess->ctx);
+            }
+        }
+        xSemaphoreTake(server->mutex, portMAX_DELAY);
+        sess->ctx = r->sess_ctx;
+        sess->free_ctx = r->free_ctx;
+        xSemaphoreGive(server->mutex);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGD(TAG, "Handler for %s failed, closing socket %d", r->uri, sess->fd);
+        return false;
+    }
+
+    // Drop any body the handler left unread so the next request parses
+    char scratch[256];
+    while (sess->body_left > 0) {
+        int got = httpd_req_recv(r, scratch, sizeof(scratch));
+        if (got <= 0) {
+            return false;
+        }
+    }
+    return sess->keep_alive;
+}
+
+/*
+ * Server task
+ */
+
+static void server_accept(httpd_sim_server_t* server) {
+    while (true) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        sim_set_nonblocking(fd);
+        int nodelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        httpd_sim_sess_t* sess = NULL;
+        for (size_t i = 0; i < server->config.max_open_sockets && !sess; i++) {
+            if (!server->sessions[i].used) {
+                sess = &server->sessions[i];
+            }
+        }
+        if (!sess) {
+            // No LRU purge: like the device, refuse the new connection
+            ESP_LOGW(TAG, "Session limit (%u) reached, closing new socket",
+                     server->config.max_open_sockets);
+            close(fd);
+            continue;
+        }
+
+        xSemaphoreTake(server->mutex, portMAX_DELAY);
+        httpd_sim_hdr_t* resp_hdrs = sess->resp_hdrs;
+        memset(sess, 0, sizeof(*sess));
+        sess->resp_hdrs = resp_hdrs;
+        sess->fd = fd;
+        sess->used = true;
+        xSemaphoreGive(server->mutex);
+    }
+}
+
+/**
+ * @brief Read from one session and run every complete request
+ *
+ * @return true if any bytes arrived
+ */
+static bool server_poll_sess(httpd_sim_server_t* server, httpd_sim_sess_t* sess) {
+    if (sess->close_pending) {
+        sess_close(server, sess);
+        return true;
+    }
+
+    if (sess->rx_len == sizeof(sess->rx)) {
+        return false;
+    }
+    ssize_t got = recv(sess->fd, sess->rx + sess->rx_len, sizeof(sess->rx) - sess->rx_len, 0);
+    if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        sess_close(server, sess);
+        return true;
+    }
+    if (got < 0) {
+        return false;
+    }
+    sess->rx_len += got;
+
+    while (sess->used && !sess->close_pending) {
+        char* end = memmem(sess->rx, sess->rx_len, "\r\n\r\n", 4);
+        if (!end) {
+            if (sess->rx_len == sizeof(sess->rx)) {
+                httpd_req_t* r = &sess->req;
+                r->handle = server;
+                r->aux = sess;
+                sess->status = HTTPD_200;
+                sess->type = HTTPD_TYPE_TEXT;
+                sess->resp_hdr_count = 0;
+                httpd_resp_send_err(r, HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE, NULL);
+                sess_close(server, sess);
+            }
+            break;
+        }
+        if (!req_process(server, sess, end + 4 - sess->rx)) {
+            sess_close(server, sess);
+            break;
+        }
+    }
+    return true;
+}
+
+static void server_task(void* pvParameters) {
+    httpd_sim_server_t* server = (httpd_sim_server_t*)pvParameters;
+
+    while (server->running) {
+        server_accept(server);
+
+        bool busy = false;
+        for (size_t i = 0; i < server->config.max_open_sockets; i++) {
+            if (server->sessions[i].used) {
+                busy |= server_poll_sess(server, &server->sessions[i]);
+            }
+        }
+        if (!busy) {
+            vTaskDelay(1);
+        }
+    }
+
+    server->stopped = true;
+    vTaskDelete(NULL);
+}
+
+esp_err_t httpd_start(httpd_handle_t* handle, const httpd_config_t* config) {
+    if (!handle || !config || config->max_open_sockets == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    httpd_sim_server_t* server = calloc(1, sizeof(*server));
+    if (!server) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    server->config = *config;
+    server->listen_fd = -1;
+    server->handlers = calloc(config->max_uri_handlers, sizeof(httpd_uri_t));
+    server->sessions = calloc(config->max_open_sockets, sizeof(httpd_sim_sess_t));
+    server->mutex = xSemaphoreCreateMutex();
+    bool alloc_ok = server->handlers && server->sessions && server->mutex;
+    for (size_t i = 0; alloc_ok && i < config->max_open_sockets; i++) {
+        server->sessions[i].resp_hdrs = calloc(config->max_resp_headers + 1, sizeof(httpd_sim_hdr_t));
+        alloc_ok = server->sessions[i].resp_hdrs != NULL;
+    }
+    if (!alloc_ok) {
+        httpd_stop(server);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int reuse = 1;
+    setsockopt(server->listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    uint16_t port = sim_map_port(config->server_port);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if (server->listen_fd < 0 ||
+        bind(server->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(server->listen_fd, config->backlog_conn) != 0) {
+        ESP_LOGE(TAG, "Cannot listen on port %u: %s", port, strerror(errno));
+        httpd_stop(server);
+        return ESP_ERR_HTTPD_TASK;
+    }
+    sim_set_nonblocking(server->listen_fd);
+
+    server->running = true;
+    if (xTaskCreate(server_task, "httpd", config->stack_size, server,
+                    config->task_priority, &server->task) != pdPASS) {
+        server->running = false;
+        httpd_stop(server);
+        return ESP_ERR_HTTPD_TASK;
+    }
+
+    ESP_LOGI(TAG, "Listening on port %u (device port %u)", port, config->server_port);
+    *handle = server;
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle) {
+    httpd_sim_server_t* server = (httpd_sim_server_t*)handle;
+    if (!server) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (server->running) {
+        server->running = false;
+        while (!server->stopped) {
+            vTaskDelay(1);
+        }
+    }
+    for (size_t i = 0; server->sessions && i < server->config.max_open_sockets; i++) {
+        if (server->sessions[i].used) {
+            sess_close(server, &server->sessions[i]);
+        }
+        free(server->sessions[i].resp_hdrs);
+    }
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+    }
+    if (server->mutex) {
+        vSemaphoreDelete(server->mutex);
+    }
+    free(server->sessions);
+    free(server->handlers);
+    free(server);
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t* uri_handler) {
+    httpd_sim_server_t* server = (httpd_sim_server_t*)handle;
+    if (!server || !uri_handler || !uri_handler->uri || !uri_handler->handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < server->handler_count; i++) {
+        if (server->handlers[i].method == uri_handler->method &&
+            strcmp(server->handlers[i].uri, uri_handler->uri) == 0) {
+            return ESP_ERR_HTTPD_HANDLER_EXISTS;
+        }
+    }
+    if (server->handler_count == server->config.max_uri_handlers) {
+        ESP_LOGW(TAG, "No slot left for URI handler %s (max_uri_handlers %u)",
+                 uri_handler->uri, server->config.max_uri_handlers);
+        return ESP_ERR_HTTPD_HANDLERS_FULL;
+    }
+    server->handlers[server->handler_count++] = *uri_handler;
+    return ESP_OK;
+}
+
+/*
+ * Request API
+ */
+
+int httpd_req_recv(httpd_req_t* r, char* buf, size_t buf_len) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (!sess || !buf) {
+        return HTTPD_SOCK_ERR_INVALID;
+    }
+    if (buf_len > sess->body_left) {
+        buf_len = sess->body_left;
+    }
+    if (buf_len == 0) {
+        return 0;
+    }
+
+    // Body bytes that arrived with the headers come first
+    if (sess->rx_len > 0) {
+        size_t n = (sess->rx_len < buf_len) ? sess->rx_len : buf_len;
+        memcpy(buf, sess->rx, n);
+        sess->rx_len -= n;
+        memmove(sess->rx, sess->rx + n, sess->rx_len);
+        sess->body_left -= n;
+        return (int)n;
+    }
+
+    httpd_sim_server_t* server = (httpd_sim_server_t*)r->handle;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(server->config.recv_wait_timeout * 1000);
+    while (true) {
+        ssize_t got = recv(sess->fd, buf, buf_len, 0);
+        if (got > 0) {
+            sess->body_left -= got;
+            return (int)got;
+        }
+        if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            return HTTPD_SOCK_ERR_FAIL;
+        }
+        if (xTaskGetTickCount() - start >= timeout) {
+            return HTTPD_SOCK_ERR_TIMEOUT;
+        }
+        vTaskDelay(1);
+    }
+}
+
+size_t httpd_req_get_hdr_value_len(httpd_req_t* r, const char* field) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    size_t len = 0;
+    if (!sess || !field || !hdr_find(sess, field, &len)) {
+        return 0;
+    }
+    return len;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t* r, const char* field, char* val, size_t val_size) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (!sess || !field || !val || val_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t len;
+    const char* value = hdr_find(sess, field, &len);
+    if (!value) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    size_t copy = (len < val_size - 1) ? len : val_size - 1;
+    memcpy(val, value, copy);
+    val[copy] = '\0';
+    return (copy < len) ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+size_t httpd_req_get_url_query_len(httpd_req_t* r) {
+    const char* query = r ? strchr(r->uri, '?') : NULL;
+    return query ? strlen(query + 1) : 0;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t* r, char* buf, size_t buf_len) {
+    if (!r || !buf || buf_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const char* query = strchr(r->uri, '?');
+    if (!query) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    query++;
+    size_t len = strlen(query);
+    size_t copy = (len < buf_len - 1) ? len : buf_len - 1;
+    memcpy(buf, query, copy);
+    buf[copy] = '\0';
+    return (copy < len) ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+}
+
+esp_err_t httpd_query_key_value(const char* qry, const char* key, char* val, size_t val_size) {
+    if (!qry || !key || !val || val_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t key_len = strlen(key);
+    const char* pair = qry;
+    while (*pair) {
+        size_t pair_len = strcspn(pair, "&");
+        const char* eq = memchr(pair, '=', pair_len);
+        size_t name_len = eq ? (size_t)(eq - pair) : pair_len;
+        if (name_len == key_len && strncmp(pair, key, key_len) == 0) {
+            const char* value = eq ? eq + 1 : pair + pair_len;
+            size_t len = pair + pair_len - value;
+            size_t copy = (len < val_size - 1) ? len : val_size - 1;
+            memcpy(val, value, copy);
+            val[copy] = '\0';
+            return (copy < len) ? ESP_ERR_HTTPD_RESULT_TRUNC : ESP_OK;
+        }
+        pair += pair_len;
+        if (*pair == '&') {
+            pair++;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+int httpd_req_to_sockfd(httpd_req_t* r) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    return sess ? sess->fd : -1;
+}
+
+/*
+ * Response API
+ */
+
+esp_err_t httpd_resp_set_status(httpd_req_t* r, const char* status) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (!sess || !status) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    sess->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t* r, const char* type) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (!sess || !type) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    sess->type = type;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t* r, const char* field, const char* value) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (!sess || !field || !value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    httpd_sim_server_t* server = (httpd_sim_server_t*)r->handle;
+    if (sess->resp_hdr_count >= server->config.max_resp_headers) {
+        return ESP_ERR_HTTPD_RESP_HDR;
+    }
+    sess->resp_hdrs[sess->resp_hdr_count].field = field;
+    sess->resp_hdrs[sess->resp_hdr_count].value = value;
+    sess->resp_hdr_count++;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t* r, const char* buf, ssize_t buf_len) {
+    if (!req_sess(r)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!buf) {
+        buf_len = 0;
+    } else if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = strlen(buf);
+    }
+    esp_err_t ret = req_send_head(r, buf_len);
+    if (ret == ESP_OK) {
+        ret = req_send(r, buf, buf_len);
+    }
+    return ret;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t* r, const char* buf, ssize_t buf_len) {
+    httpd_sim_sess_t* sess = req_sess(r);
+    if (!sess) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!buf) {
+        buf_len = 0;
+    } else if (buf_len == HTTPD_RESP_USE_STRLEN) {
+        buf_len = strlen(buf);
+    }
+    if (!sess->chunked) {
+        esp_err_t ret = req_send_head(r, -1);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        sess->chunked = true;
+    }
+
+    char size[16];
+    int size_len = snprintf(size, sizeof(size), "%x\r\n", (unsigned)buf_len);
+    esp_err_t ret = req_send(r, size, size_len);
+    if (ret == ESP_OK) {
+        ret = req_send(r, buf, buf_len);
+    }
+    if (ret == ESP_OK) {
+        ret = req_send(r, "\r\n", 2);
+    }
+    if (buf_len == 0) {
+        sess->chunked = false;
+    }
+    return ret;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t* req, httpd_err_code_t error, const char* msg) {
+    static const struct {
+        const char* status;
+        const char* msg;
+    } errors[HTTPD_ERR_CODE_MAX] = {
+        [HTTPD_500_INTERNAL_SERVER_ERROR] = { "500 Internal Server Error", "Server has encountered an unexpected error" },
+        [HTTPD_501_METHOD_NOT_IMPLEMENTED] = { "501 Method Not Implemented", "Request method is not supported by server" },
+        [HTTPD_505_VERSION_NOT_SUPPORTED] = { "505 Version Not Supported", "HTTP version not supported by server" },
+        [HTTPD_400_BAD_REQUEST] = { "400 Bad Request", "Server unable to understand request due to invalid syntax" },
+        [HTTPD_404_NOT_FOUND] = { "404 Not Found", "This URI does not exist" },
+        [HTTPD_405_METHOD_NOT_ALLOWED] = { "405 Method Not Allowed", "Request method for this URI is not handled by server" },
+        [HTTPD_408_REQ_TIMEOUT] = { "408 Request Timeout", "Server closed this connection" },
+        [HTTPD_411_LENGTH_REQUIRED] = { "411 Length Required", "Chunked encoding not supported by server" },
+        [HTTPD_414_URI_TOO_LONG] = { "414 URI Too Long", "URI is too long for server to interpret" },
+        [HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE] = { "431 Request Header Fields Too Large", "Header fields are too long for server to interpret" },
+    };
+    if (!req_sess(req) || error >= HTTPD_ERR_CODE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    httpd_resp_set_status(req, errors[error].status);
+    httpd_resp_set_type(req, HTTPD_TYPE_TEXT);
+    return httpd_resp_send(req, msg ? msg : errors[error].msg, HTTPD_RESP_USE_STRLEN);
+}
+
+/*
+ * Session API
+ */
+
+int httpd_socket_send(httpd_handle_t hd, int sockfd, const char* buf, size_t buf_len, int flags) {
+    httpd_sim_server_t* server = (httpd_sim_server_t*)hd;
+    if (!server || !buf) {
+        return HTTPD_SOCK_ERR_INVALID;
+    }
+    return sess_send(server, sockfd, buf, buf_len, !(flags & MSG_DONTWAIT));
+}
+
+esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd) {
+    httpd_sim_server_t* server = (httpd_sim_server_t*)handle;
+    if (!server) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    xSemaphoreTake(server->mutex, portMAX_DELAY);
+    httpd_sim_sess_t* sess = sess_by_fd(server, sockfd);
+    if (sess) {
+        sess->close_pending = true;
+    }
+    xSemaphoreGive(server->mutex);
+    return sess ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void* httpd_sess_get_ctx(httpd_handle_t handle, int sockfd) {
+    httpd_sim_server_t* server = (httpd_sim_server_t*)handle;
+    if (!server) {
+        return NULL;
+    }
+    xSemaphoreTake(server->mutex, portMAX_DELAY);
+    httpd_sim_sess_t* sess = sess_by_fd(server, sockfd);
+    void* ctx = sess ? sess->ctx : NULL;
+    xSemaphoreGive(server->mutex);
+    return ctx;
+}
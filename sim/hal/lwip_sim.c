@@ -0,0 +1,60 @@
+/*
+ * lwIP Sockets - LucidConsole Host Simulator
+ * select() and bind() adapted to the POSIX port (see lwip/sockets.h)
+ */
+
+#include "sim.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <string.h>
+
+int sim_select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds,
+               struct timeval* timeout) {
+    fd_set rd, wr, ex;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t wait = portMAX_DELAY;
+    if (timeout) {
+        uint64_t ms = (uint64_t)timeout->tv_sec * 1000 + timeout->tv_usec / 1000;
+        wait = pdMS_TO_TICKS(ms);
+    }
+
+    while (true) {
+        // Poll with a zero timeout; the host call never blocks the thread
+        if (readfds) rd = *readfds;
+        if (writefds) wr = *writefds;
+        if (exceptfds) ex = *exceptfds;
+        struct timeval zero = { 0, 0 };
+        int ready = select(nfds, readfds ? &rd : NULL, writefds ? &wr : NULL,
+                           exceptfds ? &ex : NULL, &zero);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready != 0 || (wait != portMAX_DELAY && xTaskGetTickCount() - start >= wait)) {
+            if (ready >= 0) {
+                if (readfds) *readfds = rd;
+                if (writefds) *writefds = wr;
+                if (exceptfds) *exceptfds = ex;
+            }
+            return ready;
+        }
+        vTaskDelay(1);
+    }
+}
+
+int sim_bind(int fd, const struct sockaddr* addr, socklen_t len) {
+    if (addr && addr->sa_family == AF_INET && len >= sizeof(struct sockaddr_in)) {
+        struct sockaddr_in mapped;
+        memcpy(&mapped, addr, sizeof(mapped));
+        mapped.sin_port = htons(sim_map_port(ntohs(mapped.sin_port)));
+
+        // Restarting the sim should not wait out TIME_WAIT
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        return bind(fd, (const struct sockaddr*)&mapped, sizeof(mapped));
+    }
+    return bind(fd, addr, len);
+}
@@ -0,0 +1,347 @@
+/*
+ * NVS - LucidConsole Host Simulator
+ * Key-value store in RAM, saved to nvs.txt under --state-dir on commit
+ */
+
+#include "sim.h"
+#include "nvs_flash.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* TAG = "SIM_NVS";
+
+#define NVS_SIM_ENTRIES     64
+#define NVS_SIM_HANDLES     8
+#define NVS_SIM_STR_MAX     256     // Longest string value kept
+#define NVS_SIM_FILE        "nvs.txt"
+
+typedef enum {
+    NVS_SIM_U32 = 0,
+    NVS_SIM_STR,
+} nvs_sim_type_t;
+
+typedef struct {
+    bool used;
+    char ns[NVS_KEY_NAME_MAX_SIZE];
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    nvs_sim_type_t type;
+    uint32_t u32;
+    char str[NVS_SIM_STR_MAX];
+} nvs_sim_entry_t;
+
+typedef struct {
+    bool used;
+    char ns[NVS_KEY_NAME_MAX_SIZE];
+    nvs_open_mode_t mode;
+} nvs_sim_handle_t;
+
+static nvs_sim_entry_t entries[NVS_SIM_ENTRIES];
+static nvs_sim_handle_t handles[NVS_SIM_HANDLES];
+static SemaphoreHandle_t nvs_mutex = NULL;
+
+/**
+ * @brief Load nvs.txt: one "namespace key type value" line per entry,
+ *        string values hex-encoded so any byte survives
+ */
+static void nvs_sim_load(void) {
+    char path[256];
+    if (!sim_state_path(NVS_SIM_FILE, path, sizeof(path))) {
+        return;
+    }
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return;
+    }
+
+    char line[NVS_SIM_STR_MAX * 2 + 64];
+    size_t count = 0;
+    while (count < NVS_SIM_ENTRIES && fgets(line, sizeof(line), file)) {
+        nvs_sim_entry_t* entry = &entries[count];
+        char type[4];
+        char value[NVS_SIM_STR_MAX * 2 + 1];
+        value[0] = '\0';
+        if (sscanf(line, "%15s %15s %3s %512s", entry->ns, entry->key, type, value) < 3) {
+            continue;
+        }
+        if (strcmp(type, "u32") == 0) {
+            entry->type = NVS_SIM_U32;
+            entry->u32 = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(type, "str") == 0) {
+            entry->type = NVS_SIM_STR;
+            size_t len = strlen(value) / 2;
+            for (size_t i = 0; i < len && i < NVS_SIM_STR_MAX - 1; i++) {
+                unsigned byte;
+                sscanf(&value[i * 2], "%2x", &byte);
+                entry->str[i] = (char)byte;
+            }
+            entry->str[(len < NVS_SIM_STR_MAX) ? len : NVS_SIM_STR_MAX - 1] = '\0';
+        } else {
+            continue;
+        }
+        entry->used = true;
+        count++;
+    }
+    fclose(file);
+    ESP_LOGI(TAG, "Loaded %u entries from %s", (unsigned)count, path);
+}
+
+static esp_err_t nvs_sim_save(void) {
+    char path[256];
+    if (!sim_state_path(NVS_SIM_FILE, path, sizeof(path))) {
+        return ESP_OK;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        ESP_LOGE(TAG, "Cannot write %s", path);
+        return ESP_FAIL;
+    }
+    for (size_t i = 0; i < NVS_SIM_ENTRIES; i++) {
+        const nvs_sim_entry_t* entry = &entries[i];
+        if (!entry->used) {
+            continue;
+        }
+        if (entry->type == NVS_SIM_U32) {
+            fprintf(file, "%s %s u32 %u\n", entry->ns, entry->key, (unsigned)entry->u32);
+            continue;
+        }
+        fprintf(file, "%s %s str ", entry->ns, entry->key);
+        for (const char* p = entry->str; *p; p++) {
+            fprintf(file, "%02x", (unsigned char)*p);
+        }
+        fputc('\n', file);
+    }
+    fclose(file);
+    return ESP_OK;
+}
+
+static nvs_sim_handle_t* nvs_sim_handle(nvs_handle_t handle) {
+    if (handle == 0 || handle > NVS_SIM_HANDLES || !handles[handle - 1].used) {
+        return NULL;
+    }
+    return &handles[handle - 1];
+}
+
+static nvs_sim_entry_t* nvs_sim_find(const char* ns, const char* key) {
+    for (size_t i = 0; i < NVS_SIM_ENTRIES; i++) {
+        if (entries[i].used && strcmp(entries[i].ns, ns) == 0 &&
+            (!key || strcmp(entries[i].key, key) == 0)) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find or allocate the entry for a write (caller holds nvs_mutex)
+ */
+static esp_err_t nvs_sim_slot(nvs_handle_t handle, const char* key, nvs_sim_entry_t** out) {
+    nvs_sim_handle_t* h = nvs_sim_handle(handle);
+    if (!h) {
+        return ESP_ERR_NVS_INVALID_HANDLE;
+    }
+    if (h->mode == NVS_READONLY) {
+        return ESP_ERR_NVS_READ_ONLY;
+    }
+    if (!key || strlen(key) >= NVS_KEY_NAME_MAX_SIZE) {
+        return ESP_ERR_NVS_KEY_TOO_LONG;
+    }
+
+    nvs_sim_entry_t* entry = nvs_sim_find(h->ns, key);
+    for (size_t i = 0; !entry && i < NVS_SIM_ENTRIES; i++) {
+        if (!entries[i].used) {
+            entry = &entries[i];
+            memset(entry, 0, sizeof(*entry));
+            strcpy(entry->ns, h->ns);
+            strcpy(entry->key, key);
+        }
+    }
+    if (!entry) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+    *out = entry;
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_init(void) {
+    if (!nvs_mutex) {
+        nvs_mutex = xSemaphoreCreateMutex();
+        if (!nvs_mutex) {
+            return ESP_ERR_NO_MEM;
+        }
+        nvs_sim_load();
+    }
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    if (nvs_mutex) {
+        xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    }
+    memset(entries, 0, sizeof(entries));
+    esp_err_t ret = nvs_sim_save();
+    if (nvs_mutex) {
+        xSemaphoreGive(nvs_mutex);
+    }
+    return ret;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t* out_handle) {
+    if (!nvs_mutex) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+    if (!name || !out_handle || strlen(name) >= NVS_KEY_NAME_MAX_SIZE) {
+        return ESP_ERR_NVS_INVALID_NAME;
+    }
+
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    esp_err_t ret = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    if (open_mode == NVS_READONLY && !nvs_sim_find(name, NULL)) {
+        // A namespace only exists once something was written to it
+        ret = ESP_ERR_NVS_NOT_FOUND;
+    } else {
+        for (size_t i = 0; i < NVS_SIM_HANDLES; i++) {
+            if (!handles[i].used) {
+                handles[i].used = true;
+                handles[i].mode = open_mode;
+                strcpy(handles[i].ns, name);
+                *out_handle = (nvs_handle_t)(i + 1);
+                ret = ESP_OK;
+                break;
+            }
+        }
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char* key, const char* value) {
+    if (!value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (strlen(value) >= NVS_SIM_STR_MAX) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_entry_t* entry = NULL;
+    esp_err_t ret = nvs_sim_slot(handle, key, &entry);
+    if (ret == ESP_OK) {
+        entry->type = NVS_SIM_STR;
+        strcpy(entry->str, value);
+        entry->used = true;
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char* key, char* out_value, size_t* length) {
+    if (!key || !length) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_handle_t* h = nvs_sim_handle(handle);
+    nvs_sim_entry_t* entry = h ? nvs_sim_find(h->ns, key) : NULL;
+    esp_err_t ret = ESP_OK;
+    if (!h) {
+        ret = ESP_ERR_NVS_INVALID_HANDLE;
+    } else if (!entry || entry->type != NVS_SIM_STR) {
+        ret = ESP_ERR_NVS_NOT_FOUND;
+    } else {
+        size_t needed = strlen(entry->str) + 1;
+        if (!out_value) {
+            *length = needed;
+        } else if (*length < needed) {
+            ret = ESP_ERR_NVS_INVALID_LENGTH;
+        } else {
+            memcpy(out_value, entry->str, needed);
+            *length = needed;
+        }
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char* key, uint32_t value) {
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_entry_t* entry = NULL;
+    esp_err_t ret = nvs_sim_slot(handle, key, &entry);
+    if (ret == ESP_OK) {
+        entry->type = NVS_SIM_U32;
+        entry->u32 = value;
+        entry->used = true;
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char* key, uint32_t* out_value) {
+    if (!key || !out_value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_handle_t* h = nvs_sim_handle(handle);
+    nvs_sim_entry_t* entry = h ? nvs_sim_find(h->ns, key) : NULL;
+    esp_err_t ret = ESP_OK;
+    if (!h) {
+        ret = ESP_ERR_NVS_INVALID_HANDLE;
+    } else if (!entry || entry->type != NVS_SIM_U32) {
+        ret = ESP_ERR_NVS_NOT_FOUND;
+    } else {
+        *out_value = entry->u32;
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_entry_t* entry = NULL;
+    esp_err_t ret = nvs_sim_slot(handle, key, &entry);
+    if (ret == ESP_OK && !entry->used) {
+        ret = ESP_ERR_NVS_NOT_FOUND;
+    } else if (ret == ESP_OK) {
+        entry->used = false;
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle) {
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_handle_t* h = nvs_sim_handle(handle);
+    esp_err_t ret = ESP_OK;
+    if (!h) {
+        ret = ESP_ERR_NVS_INVALID_HANDLE;
+    } else if (h->mode == NVS_READONLY) {
+        ret = ESP_ERR_NVS_READ_ONLY;
+    } else {
+        nvs_sim_entry_t* entry;
+        while ((entry = nvs_sim_find(h->ns, NULL)) != NULL) {
+            entry->used = false;
+        }
+    }
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    esp_err_t ret = nvs_sim_handle(handle) ? nvs_sim_save() : ESP_ERR_NVS_INVALID_HANDLE;
+    xSemaphoreGive(nvs_mutex);
+    return ret;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    xSemaphoreTake(nvs_mutex, portMAX_DELAY);
+    nvs_sim_handle_t* h = nvs_sim_handle(handle);
+    if (h) {
+        h->used = false;
+    }
+    xSemaphoreGive(nvs_mutex);
+}
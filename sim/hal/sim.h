@@ -0,0 +1,73 @@
+/*
+ * Simulator Core - LucidConsole Host Simulator
+ * Command-line options and helpers shared by the HAL shims
+ */
+
+#pragma once
+
+#include "esp_log.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LUCIDSIM_DEFAULT_PORT_OFFSET    8000    // :80 -> :8080, :23 -> :8023
+#define LUCIDSIM_UART_FIFO_MAX          4096    // Upper bound for --fifo-size
+
+// UART backends (sim --uart)
+typedef enum {
+    SIM_UART_STDIO = 0,         // RX from stdin, TX to stdout
+    SIM_UART_LOOPBACK,          // TX looped to RX, as with a jumper
+    SIM_UART_PTY,               // Pseudo-terminal, for emulators and test scripts
+} sim_uart_mode_t;
+
+// Simulator options
+typedef struct {
+    uint16_t port_offset;       // Added to listening ports below 1024
+    const char* state_dir;      // NVS and flash images, NULL to keep them in RAM
+    sim_uart_mode_t uart_mode;
+    bool uart_paced;            // Move RX/TX at the configured baud rate
+    uint16_t uart_fifo_size;    // Simulated hardware RX FIFO, paced mode only
+    esp_log_level_t log_level;
+} sim_options_t;
+
+extern sim_options_t sim_options;
+
+/**
+ * @brief Host port for a firmware listening port
+ */
+uint16_t sim_map_port(uint16_t port);
+
+/**
+ * @brief Path of a state file, or NULL without --state-dir
+ *
+ * @param name File name inside the state directory
+ * @param path Receives the path
+ * @param size Capacity of path
+ */
+const char* sim_state_path(const char* name, char* path, size_t size);
+
+/**
+ * @brief Make a host descriptor non-blocking
+ */
+void sim_set_nonblocking(int fd);
+
+/**
+ * @brief Allocate host memory that is not counted as firmware heap
+ * 
+ * For simulator-only state such as flash images, which live outside the
+ * device's RAM.
+ */
+void* sim_host_malloc(size_t size);
+
+/**
+ * @brief Initialise clocks and heap accounting; called from main() before the scheduler
+ */
+void sim_system_init(void);
+
+#ifdef __cplusplus
+}
+#endif
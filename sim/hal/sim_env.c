@@ -0,0 +1,37 @@
+/*
+ * Simulator Environment - LucidConsole Host Simulator
+ * Options and helpers shared by the simulator and the host benchmarks
+ */
+
+#include "sim.h"
+#include "driver/uart.h"
+#include <stdio.h>
+#include <fcntl.h>
+
+sim_options_t sim_options = {
+    .port_offset = LUCIDSIM_DEFAULT_PORT_OFFSET,
+    .state_dir = NULL,
+    .uart_mode = SIM_UART_STDIO,
+    .uart_paced = false,
+    .uart_fifo_size = UART_FIFO_LEN,
+    .log_level = ESP_LOG_INFO,
+};
+
+uint16_t sim_map_port(uint16_t port) {
+    return (port < 1024) ? port + sim_options.port_offset : port;
+}
+
+const char* sim_state_path(const char* name, char* path, size_t size) {
+    if (!sim_options.state_dir) {
+        return NULL;
+    }
+    snprintf(path, size, "%s/%s", sim_options.state_dir, name);
+    return path;
+}
+
+void sim_set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0) {
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Simulator Entry - LucidConsole Host Simulator
+ * Parses options, then runs app_main() on the FreeRTOS POSIX port
+ */
+
+#include "sim.h"
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_MAIN_TASK_STACK     3584    // ESP_TASK_MAIN_STACK
+#define SIM_MAIN_TASK_PRIORITY  1       // ESP_TASK_MAIN_PRIO
+
+extern void app_main(void);
+
+/**
+ * @brief The SDK's main task: run app_main() and go away
+ */
+static void sim_main_task(void* pvParameters) {
+    app_main();
+    vTaskDelete(NULL);
+}
+
+static void usage(const char* argv0) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -p, --port-offset N   Add N to listening ports below 1024 (default %d)\n"
+            "  -s, --state-dir DIR   Keep NVS and flash partitions in DIR across runs\n"
+            "  -u, --uart MODE       stdio (default), loopback or pty\n"
+            "  -b, --pace on|off     Pace the UART at its baud rate (default: on for pty)\n"
+            "  -f, --fifo-size N     Hardware RX FIFO bytes when paced (default %d, max %d)\n"
+            "  -l, --log LEVEL       none, error, warn, info (default), debug, verbose\n"
+            "  -h, --help\n",
+            argv0, LUCIDSIM_DEFAULT_PORT_OFFSET, UART_FIFO_LEN, LUCIDSIM_UART_FIFO_MAX);
+}
+
+int main(int argc, char** argv) {
+    static const struct option long_options[] = {
+        { "port-offset", required_argument, NULL, 'p' },
+        { "state-dir", required_argument, NULL, 's' },
+        { "uart", required_argument, NULL, 'u' },
+        { "pace", required_argument, NULL, 'b' },
+        { "fifo-size", required_argument, NULL, 'f' },
+        { "log", required_argument, NULL, 'l' },
+        { "help", no_argument, NULL, 'h' },
+        { NULL, 0, NULL, 0 },
+    };
+    static const char* levels[] = { "none", "error", "warn", "info", "debug", "verbose" };
+
+    int pace = -1;              // Follows the backend unless given
+    int opt;
+    while ((opt = getopt_long(argc, argv, "p:s:u:b:f:l:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'p':
+                sim_options.port_offset = (uint16_t)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                sim_options.state_dir = optarg;
+                break;
+            case 'u':
+                if (strcmp(optarg, "stdio") == 0) {
+                    sim_options.uart_mode = SIM_UART_STDIO;
+                } else if (strcmp(optarg, "loopback") == 0) {
+                    sim_options.uart_mode = SIM_UART_LOOPBACK;
+                } else if (strcmp(optarg, "pty") == 0) {
+                    sim_options.uart_mode = SIM_UART_PTY;
+                } else {
+                    fprintf(stderr, "Unknown UART mode: %s\n", optarg);
+                    return 2;
+                }
+                break;
+            case 'b':
+                if (strcmp(optarg, "on") == 0) {
+                    pace = 1;
+                } else if (strcmp(optarg, "off") == 0) {
+                    pace = 0;
+                } else {
+                    fprintf(stderr, "--pace takes on or off\n");
+                    return 2;
+                }
+                break;
+            case 'f': {
+                unsigned long size = strtoul(optarg, NULL, 10);
+                if (size < 1 || size > LUCIDSIM_UART_FIFO_MAX) {
+                    fprintf(stderr, "FIFO size must be 1..%d\n", LUCIDSIM_UART_FIFO_MAX);
+                    return 2;
+                }
+                sim_options.uart_fifo_size = (uint16_t)size;
+                break;
+            }
+            case 'l': {
+                size_t i;
+                for (i = 0; i < sizeof(levels) / sizeof(levels[0]); i++) {
+                    if (strcmp(optarg, levels[i]) == 0) {
+                        break;
+                    }
+                }
+                if (i == sizeof(levels) / sizeof(levels[0])) {
+                    fprintf(stderr, "Unknown log level: %s\n", optarg);
+                    return 2;
+                }
+                sim_options.log_level = (esp_log_level_t)i;
+                break;
+            }
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 2;
+        }
+    }
+
+    // A pty stands in for a real line, so it gets real line timing by default
+    sim_options.uart_paced = (pace < 0) ? (sim_options.uart_mode == SIM_UART_PTY) : (pace == 1);
+
+    // Clients hanging up must show up as send() errors, as with lwIP
+    signal(SIGPIPE, SIG_IGN);
+    sim_system_init();
+
+    fprintf(stderr, "LucidConsole simulator: http://127.0.0.1:%u/ (port offset %u)\n",
+            sim_map_port(80), sim_options.port_offset);
+
+    xTaskCreate(sim_main_task, "main", SIM_MAIN_TASK_STACK, NULL, SIM_MAIN_TASK_PRIORITY, NULL);
+    vTaskStartScheduler();
+
+    // Only reached if the scheduler could not start
+    fprintf(stderr, "FreeRTOS scheduler failed to start\n");
+    return 1;
+}
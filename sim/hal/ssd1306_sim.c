@@ -0,0 +1,129 @@
+/*
+ * SSD1306 Driver - LucidConsole Host Simulator
+ * Framebuffer drawing as in the ssd1306 component, uploads into a shadow display
+ */
+
+#include "sim.h"
+#include "ssd1306/ssd1306.h"
+#include "esp_log.h"
+#include <errno.h>
+#include <string.h>
+
+static const char* TAG = "SIM_OLED";
+
+#define SSD1306_SIM_MAX_FB  (128 * 64 / 8)
+
+// What the panel would show after the last upload
+static uint8_t shadow_display[SSD1306_SIM_MAX_FB];
+static uint32_t frames_loaded = 0;
+
+int ssd1306_init(const ssd1306_t* dev) {
+    if (!dev || (size_t)dev->width * dev->height / 8 > SSD1306_SIM_MAX_FB) {
+        return -EINVAL;
+    }
+    ESP_LOGI(TAG, "Simulated %ux%u display at 0x%02x", dev->width, dev->height, dev->i2c_addr);
+    return 0;
+}
+
+int ssd1306_load_frame_buffer(const ssd1306_t* dev, uint8_t buf[]) {
+    if (!dev) {
+        return -EINVAL;
+    }
+    size_t len = (size_t)dev->width * dev->height / 8;
+    if (buf) {
+        memcpy(shadow_display, buf, len);
+    } else {
+        memset(shadow_display, 0, len);
+    }
+    frames_loaded++;
+    return 0;
+}
+
+int ssd1306_draw_pixel(const ssd1306_t* dev, uint8_t* fb, int8_t x, int8_t y, ssd1306_color_t color) {
+    if (x < 0 || y < 0 || x >= dev->width || y >= dev->height) {
+        return -EINVAL;
+    }
+    size_t index = x + (y / 8) * dev->width;
+    uint8_t mask = 1 << (y & 7);
+    switch (color) {
+        case OLED_COLOR_WHITE:
+            fb[index] |= mask;
+            break;
+        case OLED_COLOR_BLACK:
+            fb[index] &= ~mask;
+            break;
+        case OLED_COLOR_INVERT:
+            fb[index] ^= mask;
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+int ssd1306_draw_hline(const ssd1306_t* dev, uint8_t* fb, int8_t x, int8_t y, uint8_t w,
+                       ssd1306_color_t color) {
+    if (x < 0 || y < 0 || x >= dev->width || y >= dev->height) {
+        return -EINVAL;
+    }
+    int end = x + w;
+    if (end > dev->width) {
+        end = dev->width;
+    }
+    for (int i = x; i < end; i++) {
+        ssd1306_draw_pixel(dev, fb, i, y, color);
+    }
+    return 0;
+}
+
+int ssd1306_fill_rectangle(const ssd1306_t* dev, uint8_t* fb, int8_t x, int8_t y, uint8_t w,
+                           uint8_t h, ssd1306_color_t color) {
+    if (x < 0 || y < 0 || x >= dev->width || y >= dev->height) {
+        return -EINVAL;
+    }
+    for (int row = y; row < y + h && row < dev->height; row++) {
+        ssd1306_draw_hline(dev, fb, x, row, w, color);
+    }
+    return 0;
+}
+
+int ssd1306_draw_char(const ssd1306_t* dev, uint8_t* fb, const font_info_t* font, uint8_t x,
+                      uint8_t y, char c, ssd1306_color_t foreground, ssd1306_color_t background) {
+    if (!font || !fb) {
+        return -EINVAL;
+    }
+    const font_char_desc_t* d = font_get_char_desc(font, c);
+    if (!d) {
+        return 0;
+    }
+
+    // Rows of (width + 7) / 8 bytes, leftmost pixel in the MSB
+    const uint8_t* b = font->bitmap + d->offset;
+    for (uint8_t j = 0; j < font->height; j++) {
+        for (uint8_t i = 0; i < d->width; i++) {
+            if (b[i / 8] & (0x80 >> (i % 8))) {
+                ssd1306_draw_pixel(dev, fb, x + i, y + j, foreground);
+            } else if (background != OLED_COLOR_TRANSPARENT) {
+                ssd1306_draw_pixel(dev, fb, x + i, y + j, background);
+            }
+        }
+        b += (d->width + 7) / 8;
+    }
+    return d->width;
+}
+
+int ssd1306_draw_string(const ssd1306_t* dev, uint8_t* fb, const font_info_t* font, uint8_t x,
+                        uint8_t y, const char* str, ssd1306_color_t foreground,
+                        ssd1306_color_t background) {
+    if (!str || !font) {
+        return -EINVAL;
+    }
+
+    // Text past the right edge is clipped, as on the panel
+    int t = x;
+    while (*str && t < dev->width) {
+        t += ssd1306_draw_char(dev, fb, font, t, y, *str, foreground, background) + font->c;
+        str++;
+    }
+    return t - x;
+}
@@ -0,0 +1,606 @@
+/*
+ * UART Driver - LucidConsole Host Simulator
+ * ESP8266 UART driver API over a host descriptor pair (see sim --uart)
+ *
+ * Unpaced, the pump moves whatever the host offers and a full ring simply
+ * leaves the rest in the host pipe. Paced (sim --pace on), bytes cross the
+ * "wire" at the configured baud rate into a simulated hardware FIFO, and
+ * the driver behaves like the SDK's ISR: a full ring masks RX interrupts
+ * and posts UART_BUFFER_FULL, and bytes arriving at a full FIFO are lost
+ * with UART_FIFO_OVF.
+ */
+
+#include "sim.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static const char* TAG = "SIM_UART";
+
+#define UART_SIM_PUMP_PRIORITY  (configMAX_PRIORITIES - 1)    // Stands in for the RX ISR
+#define UART_SIM_PUMP_STACK     2048
+#define UART_SIM_WIRE_BURST     10      // Ticks of line time a late pump may catch up
+
+// Line time, in bytes, credited per tick at the configured baud rate
+typedef struct {
+    TickType_t last_tick;
+    uint64_t acc;                       // Fractional bytes, in half-bit units
+    size_t credit;
+} uart_sim_wire_t;
+
+typedef struct {
+    // Host side, kept across driver reinstalls
+    bool backend_open;
+    int rx_fd;
+    int tx_fd;
+    int pty_slave;                      // Held open so the master never sees a hangup
+    bool rx_eof;
+    
+    // Driver
+    bool installed;
+    QueueHandle_t event_queue;
+    SemaphoreHandle_t lock;
+    uint8_t* ring;
+    size_t ring_size;
+    size_t ring_head;                   // Total bytes written
+    size_t ring_tail;                   // Total bytes read
+    bool rx_intr_enabled;
+    uint32_t baud_rate;
+    uart_config_t config;
+    uart_intr_config_t intr;
+    TaskHandle_t pump_task;
+    volatile bool pump_stop;
+    
+    // Paced mode: line timing and the hardware RX FIFO
+    uart_sim_wire_t rx_wire;
+    uart_sim_wire_t tx_wire;
+    uint8_t fifo[LUCIDSIM_UART_FIFO_MAX];
+    size_t fifo_len;
+    bool rx_stalled;                    // Ring was full; RX interrupts masked
+    bool fifo_overflowed;               // UART_FIFO_OVF sent for this stall
+} uart_sim_port_t;
+
+static uart_sim_port_t ports[UART_NUM_MAX];
+
+/**
+ * @brief Open a pseudo-terminal and publish its slave path
+ */
+static esp_err_t backend_open_pty(uart_sim_port_t* port) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        ESP_LOGE(TAG, "Failed to allocate a pty: %s", strerror(errno));
+        if (master >= 0) {
+            close(master);
+        }
+        return ESP_FAIL;
+    }
+    const char* slave_name = ptsname(master);
+    int slave = slave_name ? open(slave_name, O_RDWR | O_NOCTTY) : -1;
+    if (slave < 0) {
+        close(master);
+        return ESP_FAIL;
+    }
+    
+    // Raw line: no echo, no CR/LF translation, no line buffering
+    struct termios tio;
+    if (tcgetattr(slave, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+    }
+    
+    port->rx_fd = master;
+    port->tx_fd = master;
+    port->pty_slave = slave;
+    ESP_LOGI(TAG, "UART backend: pty %s", slave_name);
+    
+    // Stable name for scripts: <state-dir>/uart.pty
+    char link_path[256];
+    if (sim_state_path("uart.pty", link_path, sizeof(link_path))) {
+        unlink(link_path);
+        if (symlink(slave_name, link_path) != 0) {
+            ESP_LOGW(TAG, "Could not link %s: %s", link_path, strerror(errno));
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Open the host descriptors selected with --uart
+ */
+static esp_err_t backend_open(uart_sim_port_t* port) {
+    if (port->backend_open) {
+        return ESP_OK;
+    }
+    port->pty_slave = -1;
+    switch (sim_options.uart_mode) {
+        case SIM_UART_LOOPBACK: {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                return ESP_FAIL;
+            }
+            port->rx_fd = fds[0];
+            port->tx_fd = fds[1];
+            ESP_LOGI(TAG, "UART backend: loopback (TX wired to RX)");
+            break;
+        }
+        case SIM_UART_PTY:
+            if (backend_open_pty(port) != ESP_OK) {
+                return ESP_FAIL;
+            }
+            break;
+        case SIM_UART_STDIO:
+        default:
+            port->rx_fd = STDIN_FILENO;
+            port->tx_fd = STDOUT_FILENO;
+            ESP_LOGI(TAG, "UART backend: stdin/stdout");
+            break;
+    }
+    sim_set_nonblocking(port->rx_fd);
+    sim_set_nonblocking(port->tx_fd);
+    if (sim_options.uart_paced) {
+        ESP_LOGI(TAG, "UART paced at the configured baud rate, %u byte RX FIFO",
+                 sim_options.uart_fifo_size);
+    }
+    port->backend_open = true;
+    return ESP_OK;
+}
+
+static void post_event(uart_sim_port_t* port, uart_event_type_t type, size_t size) {
+    if (!port->event_queue) {
+        return;
+    }
+    uart_event_t event = {
+        .type = type,
+        .size = size,
+    };
+    // Like the ISR: a full event queue drops the event
+    xQueueSend(port->event_queue, &event, 0);
+}
+
+/**
+ * @brief Bits on the line per character, in half bits (1.5 stop bits exist)
+ */
+static uint32_t frame_half_bits(const uart_config_t* config) {
+    uint32_t half_bits = 2 + (5 + config->data_bits) * 2;       // Start + data
+    if (config->parity != UART_PARITY_DISABLE) {
+        half_bits += 2;
+    }
+    switch (config->stop_bits) {
+        case UART_STOP_BITS_1_5:
+            half_bits += 3;
+            break;
+        case UART_STOP_BITS_2:
+            half_bits += 4;
+            break;
+        default:
+            half_bits += 2;
+            break;
+    }
+    return half_bits;
+}
+
+/**
+ * @brief Credit the line time elapsed since the last call, in whole characters
+ */
+static void wire_refill(uart_sim_port_t* port, uart_sim_wire_t* wire) {
+    TickType_t now = xTaskGetTickCount();
+    TickType_t elapsed = now - wire->last_tick;
+    wire->last_tick = now;
+    if (elapsed > UART_SIM_WIRE_BURST) {
+        // A host scheduling hiccup is not line time; don't replay it as a burst
+        elapsed = UART_SIM_WIRE_BURST;
+    }
+    
+    uint64_t per_char = (uint64_t)frame_half_bits(&port->config) * configTICK_RATE_HZ;
+    wire->acc += (uint64_t)port->baud_rate * 2 * elapsed;
+    size_t chars = wire->acc / per_char;
+    wire->acc -= chars * per_char;
+    
+    size_t burst_max = (size_t)((uint64_t)port->baud_rate * 2 * UART_SIM_WIRE_BURST / per_char) + 1;
+    wire->credit += chars;
+    if (wire->credit > burst_max) {
+        wire->credit = burst_max;
+    }
+}
+
+/**
+ * @brief RX interrupt: move the FIFO into the ring (caller holds port->lock)
+ *
+ * @return Bytes moved; 0 with rx_stalled set if the ring had no room
+ */
+static size_t isr_drain_fifo(uart_sim_port_t* port) {
+    size_t space = port->ring_size - (port->ring_head - port->ring_tail);
+    if (port->fifo_len > space) {
+        // As in the SDK driver: keep the bytes in the FIFO and mask RX interrupts
+        port->rx_stalled = true;
+        return 0;
+    }
+    for (size_t i = 0; i < port->fifo_len; i++) {
+        port->ring[(port->ring_head + i) % port->ring_size] = port->fifo[i];
+    }
+    port->ring_head += port->fifo_len;
+    size_t moved = port->fifo_len;
+    port->fifo_len = 0;
+    return moved;
+}
+
+/**
+ * @brief One tick of paced RX: line -> FIFO -> ring, with ISR events
+ */
+static void pump_paced(uart_sim_port_t* port) {
+    uint8_t chunk[512];
+    size_t fifo_size = sim_options.uart_fifo_size;
+    size_t thresh = port->intr.rxfifo_full_thresh;
+    if (thresh == 0 || thresh > fifo_size) {
+        thresh = fifo_size;
+    }
+    
+    wire_refill(port, &port->rx_wire);
+    bool line_idle = true;
+    while (port->rx_wire.credit > 0 && !port->rx_eof) {
+        size_t want = (port->rx_wire.credit < sizeof(chunk)) ? port->rx_wire.credit : sizeof(chunk);
+        ssize_t got = read(port->rx_fd, chunk, want);
+        if (got == 0) {
+            port->rx_eof = true;
+            ESP_LOGI(TAG, "UART RX input closed");
+            break;
+        }
+        if (got < 0) {
+            break;
+        }
+        port->rx_wire.credit -= got;
+        line_idle = ((size_t)got < want);
+        
+        // Characters land in the FIFO one at a time; the ISR runs at the threshold
+        xSemaphoreTake(port->lock, portMAX_DELAY);
+        for (ssize_t i = 0; i < got; i++) {
+            if (port->fifo_len == fifo_size) {
+                // Hardware resets the FIFO on overflow; everything in it is lost
+                port->fifo_len = 0;
+                if (!port->fifo_overflowed && (port->intr.intr_enable_mask & UART_RXFIFO_OVF_INT_ENA_M)) {
+                    port->fifo_overflowed = true;
+                    post_event(port, UART_FIFO_OVF, 0);
+                }
+            }
+            port->fifo[port->fifo_len++] = chunk[i];
+            if (port->fifo_len >= thresh && port->rx_intr_enabled && !port->rx_stalled) {
+                size_t moved = isr_drain_fifo(port);
+                post_event(port, moved ? UART_DATA : UART_BUFFER_FULL, moved);
+            }
+        }
+        xSemaphoreGive(port->lock);
+    }
+    
+    // RX timeout: the line went quiet with bytes still below the threshold
+    if (line_idle) {
+        // Idle line time is gone; it must not come back as a burst
+        port->rx_wire.credit = 0;
+        xSemaphoreTake(port->lock, portMAX_DELAY);
+        if (port->fifo_len && port->rx_intr_enabled && !port->rx_stalled) {
+            size_t moved = isr_drain_fifo(port);
+            post_event(port, moved ? UART_DATA : UART_BUFFER_FULL, moved);
+        }
+        xSemaphoreGive(port->lock);
+    }
+}
+
+/**
+ * @brief One tick of unpaced RX: everything the host offers, up to the ring's space
+ */
+static void pump_unpaced(uart_sim_port_t* port) {
+    uint8_t chunk[512];
+    size_t received = 0;
+    while (!port->rx_eof && port->rx_intr_enabled) {
+        // A full ring leaves the rest in the host pipe: backpressure, not loss
+        xSemaphoreTake(port->lock, portMAX_DELAY);
+        size_t space = port->ring_size - (port->ring_head - port->ring_tail);
+        xSemaphoreGive(port->lock);
+        if (space == 0) {
+            break;
+        }
+        
+        ssize_t got = read(port->rx_fd, chunk, (space < sizeof(chunk)) ? space : sizeof(chunk));
+        if (got == 0) {
+            port->rx_eof = true;
+            ESP_LOGI(TAG, "UART RX input closed");
+            break;
+        }
+        if (got < 0) {
+            break;
+        }
+        
+        xSemaphoreTake(port->lock, portMAX_DELAY);
+        for (ssize_t i = 0; i < got; i++) {
+            port->ring[(port->ring_head + i) % port->ring_size] = chunk[i];
+        }
+        port->ring_head += got;
+        xSemaphoreGive(port->lock);
+        received += got;
+    }
+    
+    if (received) {
+        post_event(port, UART_DATA, received);
+    }
+}
+
+/**
+ * @brief Move host bytes into the driver once per tick, as the RX ISR would
+ */
+static void uart_pump_task(void* pvParameters) {
+    uart_sim_port_t* port = (uart_sim_port_t*)pvParameters;
+    
+    port->rx_wire.last_tick = xTaskGetTickCount();
+    while (!port->pump_stop) {
+        if (sim_options.uart_paced) {
+            pump_paced(port);
+        } else {
+            pump_unpaced(port);
+        }
+        vTaskDelay(1);
+    }
+    
+    port->pump_task = NULL;
+    vTaskDelete(NULL);
+}
+
+static uart_sim_port_t* port_get(uart_port_t uart_num) {
+    if (uart_num >= UART_NUM_MAX || !ports[uart_num].installed) {
+        return NULL;
+    }
+    return &ports[uart_num];
+}
+
+/**
+ * @brief Reset the FIFO and lift an RX stall (caller holds port->lock)
+ */
+static void rx_fifo_reset(uart_sim_port_t* port) {
+    port->fifo_len = 0;
+    port->rx_stalled = false;
+    port->fifo_overflowed = false;
+}
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size,
+                              int queue_size, QueueHandle_t* uart_queue, int no_use) {
+    if (uart_num >= UART_NUM_MAX || rx_buffer_size <= UART_FIFO_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uart_sim_port_t* port = &ports[uart_num];
+    if (port->installed) {
+        ESP_LOGE(TAG, "UART driver already installed");
+        return ESP_FAIL;
+    }
+    if (backend_open(port) != ESP_OK) {
+        return ESP_FAIL;
+    }
+    
+    port->ring = malloc(rx_buffer_size);
+    port->lock = xSemaphoreCreateMutex();
+    port->event_queue = (uart_queue && queue_size > 0) ? xQueueCreate(queue_size, sizeof(uart_event_t)) : NULL;
+    if (!port->ring || !port->lock || (uart_queue && queue_size > 0 && !port->event_queue)) {
+        free(port->ring);
+        if (port->lock) {
+            vSemaphoreDelete(port->lock);
+        }
+        if (port->event_queue) {
+            vQueueDelete(port->event_queue);
+        }
+        return ESP_ERR_NO_MEM;
+    }
+    port->ring_size = rx_buffer_size;
+    port->ring_head = 0;
+    port->ring_tail = 0;
+    port->rx_intr_enabled = true;
+    rx_fifo_reset(port);
+    if (!port->baud_rate) {
+        port->baud_rate = 74880;        // ROM boot default
+    }
+    if (!port->config.baud_rate) {
+        port->config.data_bits = UART_DATA_8_BITS;
+        port->config.stop_bits = UART_STOP_BITS_1;
+    }
+    if (uart_queue) {
+        *uart_queue = port->event_queue;
+    }
+    
+    port->pump_stop = false;
+    if (xTaskCreate(uart_pump_task, "uart_isr", UART_SIM_PUMP_STACK, port,
+                    UART_SIM_PUMP_PRIORITY, &port->pump_task) != pdPASS) {
+        free(port->ring);
+        vSemaphoreDelete(port->lock);
+        if (port->event_queue) {
+            vQueueDelete(port->event_queue);
+        }
+        return ESP_ERR_NO_MEM;
+    }
+    port->installed = true;
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t uart_num) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port) {
+        return ESP_FAIL;
+    }
+    port->pump_stop = true;
+    while (port->pump_task) {
+        vTaskDelay(1);
+    }
+    port->installed = false;
+    if (port->event_queue) {
+        vQueueDelete(port->event_queue);
+        port->event_queue = NULL;
+    }
+    vSemaphoreDelete(port->lock);
+    free(port->ring);
+    port->ring = NULL;
+    return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t* uart_conf) {
+    if (uart_num >= UART_NUM_MAX || !uart_conf || uart_conf->baud_rate <= 0 ||
+        uart_conf->data_bits >= UART_DATA_BITS_MAX || uart_conf->stop_bits >= UART_STOP_BITS_MAX ||
+        uart_conf->flow_ctrl >= UART_HW_FLOWCTRL_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ports[uart_num].config = *uart_conf;
+    ports[uart_num].baud_rate = uart_conf->baud_rate;
+    return ESP_OK;
+}
+
+esp_err_t uart_intr_config(uart_port_t uart_num, const uart_intr_config_t* intr_conf) {
+    if (uart_num >= UART_NUM_MAX || !intr_conf) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ports[uart_num].intr = *intr_conf;
+    return ESP_OK;
+}
+
+esp_err_t uart_set_baudrate(uart_port_t uart_num, uint32_t baudrate) {
+    if (uart_num >= UART_NUM_MAX || baudrate == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    ports[uart_num].baud_rate = baudrate;
+    return ESP_OK;
+}
+
+esp_err_t uart_get_baudrate(uart_port_t uart_num, uint32_t* baudrate) {
+    if (uart_num >= UART_NUM_MAX || !baudrate) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *baudrate = ports[uart_num].baud_rate;
+    return ESP_OK;
+}
+
+esp_err_t uart_enable_rx_intr(uart_port_t uart_num) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port) {
+        return ESP_FAIL;
+    }
+    port->rx_intr_enabled = true;
+    return ESP_OK;
+}
+
+esp_err_t uart_disable_rx_intr(uart_port_t uart_num) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port) {
+        return ESP_FAIL;
+    }
+    port->rx_intr_enabled = false;
+    return ESP_OK;
+}
+
+int uart_read_bytes(uart_port_t uart_num, uint8_t* buf, uint32_t length, TickType_t ticks_to_wait) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port || !buf) {
+        return -1;
+    }
+    
+    TickType_t start = xTaskGetTickCount();
+    uint32_t copied = 0;
+    while (copied < length) {
+        xSemaphoreTake(port->lock, portMAX_DELAY);
+        while (copied < length && port->ring_tail != port->ring_head) {
+            buf[copied++] = port->ring[port->ring_tail % port->ring_size];
+            port->ring_tail++;
+        }
+        // Room again: the driver moves the held FIFO bytes and unmasks RX
+        if (port->rx_stalled) {
+            port->rx_stalled = false;
+            isr_drain_fifo(port);       // Stalls again if there still isn't room
+            port->fifo_overflowed = port->rx_stalled && port->fifo_overflowed;
+        }
+        xSemaphoreGive(port->lock);
+        
+        if (copied == length || xTaskGetTickCount() - start >= ticks_to_wait) {
+            break;
+        }
+        vTaskDelay(1);
+    }
+    return (int)copied;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const char* src, size_t size) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port || !src) {
+        return -1;
+    }
+    
+    size_t done = 0;
+    if (sim_options.uart_paced && xTaskGetTickCount() - port->tx_wire.last_tick > 1) {
+        // The line sat idle since the last write; restart its clock
+        port->tx_wire.last_tick = xTaskGetTickCount();
+        port->tx_wire.credit = 0;
+    }
+    while (done < size) {
+        size_t len = size - done;
+        if (sim_options.uart_paced) {
+            wire_refill(port, &port->tx_wire);
+            if (port->tx_wire.credit == 0) {
+                vTaskDelay(1);
+                continue;
+            }
+            if (len > port->tx_wire.credit) {
+                len = port->tx_wire.credit;
+            }
+        }
+        
+        ssize_t sent = write(port->tx_fd, src + done, len);
+        if (sent > 0) {
+            done += sent;
+            if (sim_options.uart_paced) {
+                port->tx_wire.credit -= sent;
+            }
+        } else if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            return -1;
+        } else if (sim_options.uart_paced) {
+            // The line doesn't wait for a receiver: what it can't take is lost
+            done += len;
+            port->tx_wire.credit -= len;
+        } else {
+            // Host side is full: wait as the driver waits for TX buffer space
+            vTaskDelay(1);
+        }
+    }
+    return (int)done;
+}
+
+esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t* size) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port || !size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    xSemaphoreTake(port->lock, portMAX_DELAY);
+    *size = port->ring_head - port->ring_tail;
+    xSemaphoreGive(port->lock);
+    return ESP_OK;
+}
+
+esp_err_t uart_flush_input(uart_port_t uart_num) {
+    uart_sim_port_t* port = port_get(uart_num);
+    if (!port) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    xSemaphoreTake(port->lock, portMAX_DELAY);
+    port->ring_tail = port->ring_head;
+    rx_fifo_reset(port);
+    xSemaphoreGive(port->lock);
+    return ESP_OK;
+}
+
+esp_err_t uart_flush(uart_port_t uart_num) {
+    return uart_flush_input(uart_num);
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait) {
+    // Writes go straight to the host descriptor once paced, so nothing is pending
+    return port_get(uart_num) ? ESP_OK : ESP_FAIL;
+}
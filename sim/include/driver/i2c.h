@@ -0,0 +1,26 @@
+/*
+ * I2C Driver - LucidConsole Host Simulator
+ * Constants for i2c_hw_bus.h; the board shim answers for the display
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    I2C_NUM_0 = 0,
+    I2C_NUM_MAX,
+} i2c_port_t;
+
+typedef enum {
+    I2C_MASTER_WRITE = 0,
+    I2C_MASTER_READ,
+} i2c_rw_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+/*
+ * UART Driver - LucidConsole Host Simulator
+ * ESP8266 UART driver API over a host file descriptor (see sim --uart)
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UART_FIFO_LEN   128     // Hardware FIFO depth on the ESP8266
+
+typedef enum {
+    UART_NUM_0 = 0,
+    UART_NUM_1,
+    UART_NUM_MAX,
+} uart_port_t;
+
+typedef enum {
+    UART_DATA_5_BITS = 0x0,
+    UART_DATA_6_BITS = 0x1,
+    UART_DATA_7_BITS = 0x2,
+    UART_DATA_8_BITS = 0x3,
+    UART_DATA_BITS_MAX = 0x4,
+} uart_word_length_t;
+
+typedef enum {
+    UART_STOP_BITS_1 = 0x1,
+    UART_STOP_BITS_1_5 = 0x2,
+    UART_STOP_BITS_2 = 0x3,
+    UART_STOP_BITS_MAX = 0x4,
+} uart_stop_bits_t;
+
+typedef enum {
+    UART_PARITY_DISABLE = 0x0,
+    UART_PARITY_EVEN = 0x2,
+    UART_PARITY_ODD = 0x3,
+} uart_parity_t;
+
+typedef enum {
+    UART_HW_FLOWCTRL_DISABLE = 0x0,
+    UART_HW_FLOWCTRL_RTS = 0x1,
+    UART_HW_FLOWCTRL_CTS = 0x2,
+    UART_HW_FLOWCTRL_CTS_RTS = 0x3,
+    UART_HW_FLOWCTRL_MAX = 0x4,
+} uart_hw_flowcontrol_t;
+
+typedef struct {
+    int baud_rate;
+    uart_word_length_t data_bits;
+    uart_parity_t parity;
+    uart_stop_bits_t stop_bits;
+    uart_hw_flowcontrol_t flow_ctrl;
+    uint8_t rx_flow_ctrl_thresh;
+} uart_config_t;
+
+#define UART_RXFIFO_FULL_INT_ENA_M  (1 << 0)
+#define UART_TXFIFO_EMPTY_INT_ENA_M (1 << 1)
+#define UART_PARITY_ERR_INT_ENA_M   (1 << 2)
+#define UART_FRM_ERR_INT_ENA_M      (1 << 3)
+#define UART_RXFIFO_OVF_INT_ENA_M   (1 << 4)
+#define UART_RXFIFO_TOUT_INT_ENA_M  (1 << 8)
+
+typedef struct {
+    uint32_t intr_enable_mask;
+    uint8_t rx_timeout_thresh;          // Idle time in symbols before a timeout event
+    uint8_t txfifo_empty_intr_thresh;
+    uint8_t rxfifo_full_thresh;         // FIFO bytes that raise a data event
+} uart_intr_config_t;
+
+typedef enum {
+    UART_DATA,
+    UART_BUFFER_FULL,
+    UART_FIFO_OVF,
+    UART_FRAME_ERR,
+    UART_PARITY_ERR,
+    UART_EVENT_MAX,
+} uart_event_type_t;
+
+typedef struct {
+    uart_event_type_t type;
+    size_t size;
+} uart_event_t;
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size,
+                              int queue_size, QueueHandle_t* uart_queue, int no_use);
+esp_err_t uart_driver_delete(uart_port_t uart_num);
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t* uart_conf);
+esp_err_t uart_intr_config(uart_port_t uart_num, const uart_intr_config_t* intr_conf);
+esp_err_t uart_set_baudrate(uart_port_t uart_num, uint32_t baudrate);
+esp_err_t uart_get_baudrate(uart_port_t uart_num, uint32_t* baudrate);
+esp_err_t uart_enable_rx_intr(uart_port_t uart_num);
+esp_err_t uart_disable_rx_intr(uart_port_t uart_num);
+int uart_read_bytes(uart_port_t uart_num, uint8_t* buf, uint32_t length, TickType_t ticks_to_wait);
+int uart_write_bytes(uart_port_t uart_num, const char* src, size_t size);
+esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t* size);
+esp_err_t uart_flush_input(uart_port_t uart_num);
+esp_err_t uart_flush(uart_port_t uart_num);
+esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
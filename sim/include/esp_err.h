@@ -0,0 +1,54 @@
+/*
+ * ESP Error Codes - LucidConsole Host Simulator
+ * Same values as the ESP8266 RTOS SDK so logs and JSON match the device
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int32_t esp_err_t;
+
+#define ESP_OK                      0
+#define ESP_FAIL                    -1
+
+#define ESP_ERR_NO_MEM              0x101
+#define ESP_ERR_INVALID_ARG         0x102
+#define ESP_ERR_INVALID_STATE       0x103
+#define ESP_ERR_INVALID_SIZE        0x104
+#define ESP_ERR_NOT_FOUND           0x105
+#define ESP_ERR_NOT_SUPPORTED       0x106
+#define ESP_ERR_TIMEOUT             0x107
+#define ESP_ERR_INVALID_RESPONSE    0x108
+#define ESP_ERR_INVALID_CRC         0x109
+#define ESP_ERR_INVALID_VERSION     0x10A
+#define ESP_ERR_INVALID_MAC         0x10B
+
+#define ESP_ERR_WIFI_BASE           0x3000
+#define ESP_ERR_NVS_BASE            0x1100
+#define ESP_ERR_TCPIP_ADAPTER_BASE  0x5000
+
+/**
+ * @brief Name of an error code, "UNKNOWN ERROR" if it has none
+ */
+const char* esp_err_to_name(esp_err_t code);
+
+#define ESP_ERROR_CHECK(x) do {                                             \
+        esp_err_t __err_rc = (x);                                           \
+        if (__err_rc != ESP_OK) {                                           \
+            fprintf(stderr, "ESP_ERROR_CHECK failed: %s (0x%x) at %s:%d: %s\n", \
+                    esp_err_to_name(__err_rc), (unsigned)__err_rc,          \
+                    __FILE__, __LINE__, #x);                                \
+            abort();                                                        \
+        }                                                                   \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+/*
+ * ESP Event Loop - LucidConsole Host Simulator
+ * Default event loop only, dispatched from its own task as on the device
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"          // Pulled in by the SDK header as well
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef const char* esp_event_base_t;
+typedef void (*esp_event_handler_t)(void* event_handler_arg, esp_event_base_t event_base,
+                                    int32_t event_id, void* event_data);
+
+#define ESP_EVENT_ANY_ID            -1
+#define ESP_EVENT_DECLARE_BASE(id)  extern esp_event_base_t id
+#define ESP_EVENT_DEFINE_BASE(id)   esp_event_base_t id = #id
+
+#define LUCIDSIM_EVENT_HANDLERS     16      // Registrations across all bases
+#define LUCIDSIM_EVENT_DATA_MAX     64      // Largest event payload copied
+
+ESP_EVENT_DECLARE_BASE(WIFI_EVENT);
+ESP_EVENT_DECLARE_BASE(IP_EVENT);
+
+/**
+ * @brief Create the default event loop and its dispatch task
+ */
+esp_err_t esp_event_loop_create_default(void);
+
+/**
+ * @brief Register a handler on the default loop
+ */
+esp_err_t esp_event_handler_register(esp_event_base_t event_base, int32_t event_id,
+                                     esp_event_handler_t event_handler, void* event_handler_arg);
+
+/**
+ * @brief Post an event to the default loop; the payload is copied
+ */
+esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
+                         void* event_data, size_t event_data_size, TickType_t ticks_to_wait);
+
+#ifdef __cplusplus
+}
+#endif
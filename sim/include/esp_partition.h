@@ -0,0 +1,66 @@
+/*
+ * ESP Partition - LucidConsole Host Simulator
+ * Data partitions backed by RAM or by image files, with NOR flash rules
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPI_FLASH_SEC_SIZE  4096
+
+typedef enum {
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01,
+} esp_partition_type_t;
+
+typedef enum {
+    ESP_PARTITION_SUBTYPE_DATA_OTA = 0x00,
+    ESP_PARTITION_SUBTYPE_DATA_PHY = 0x01,
+    ESP_PARTITION_SUBTYPE_DATA_NVS = 0x02,
+    ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct {
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+    bool encrypted;
+} esp_partition_t;
+
+/**
+ * @brief Find a partition from the simulated table (see partitions_ota.csv)
+ * 
+ * @param label Partition label, or NULL to match on type and subtype only
+ */
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type,
+                                                esp_partition_subtype_t subtype,
+                                                const char* label);
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t src_offset,
+                             void* dst, size_t size);
+
+/**
+ * @brief Program bytes; like NOR flash, writes can only clear bits
+ */
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t dst_offset,
+                              const void* src, size_t size);
+
+/**
+ * @brief Erase whole sectors back to 0xFF
+ */
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t start_addr,
+                                    size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+/*
+ * ESP System - LucidConsole Host Simulator
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Emulated free heap: configTOTAL_HEAP_SIZE minus live firmware allocations
+ */
+uint32_t esp_get_free_heap_size(void);
+
+/**
+ * @brief Lowest esp_get_free_heap_size() seen so far
+ */
+uint32_t esp_get_minimum_free_heap_size(void);
+
+uint32_t esp_random(void);
+
+/**
+ * @brief Exit the simulator (status 0, so a wrapper script can restart it)
+ */
+void esp_restart(void) __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+#endif
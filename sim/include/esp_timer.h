@@ -0,0 +1,20 @@
+/*
+ * ESP Timer - LucidConsole Host Simulator
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Microseconds since the simulator started (CLOCK_MONOTONIC)
+ */
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+/*
+ * Fonts - LucidConsole Host Simulator
+ * Same bitmap font layout as the fonts component used on the device
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t width;              // Character width in pixels
+    uint16_t offset;            // Offset of the character in the bitmap
+} font_char_desc_t;
+
+typedef struct {
+    uint8_t height;             // Character height in pixels
+    uint8_t c;                  // Spacing between adjacent characters
+    char char_start;
+    char char_end;
+    const font_char_desc_t* char_descriptors;
+    const uint8_t* bitmap;      // Rows of (width + 7) / 8 bytes, MSB first
+} font_info_t;
+
+static inline const font_char_desc_t* font_get_char_desc(const font_info_t* font, char c) {
+    if (c < font->char_start || c > font->char_end) {
+        return NULL;
+    }
+    const font_char_desc_t* desc = &font->char_descriptors[c - font->char_start];
+    return desc->width ? desc : NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,8 @@
+/*
+ * FreeRTOS - LucidConsole Host Simulator
+ * Maps the ESP8266 SDK include path onto the upstream kernel headers
+ */
+
+#pragma once
+
+#include <FreeRTOS.h>
@@ -0,0 +1,9 @@
+/*
+ * FreeRTOS Event Groups - LucidConsole Host Simulator
+ * Maps the ESP8266 SDK include path onto the upstream kernel headers
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <event_groups.h>
@@ -0,0 +1,9 @@
+/*
+ * FreeRTOS Semaphores - LucidConsole Host Simulator
+ * Maps the ESP8266 SDK include path onto the upstream kernel headers
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <semphr.h>
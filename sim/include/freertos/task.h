@@ -0,0 +1,24 @@
+/*
+ * FreeRTOS Tasks - LucidConsole Host Simulator
+ * Upstream task API with stack depths scaled for host threads
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <task.h>
+
+/**
+ * @brief Scale a firmware stack depth for a POSIX-port task
+ * 
+ * Every task runs on a host pthread, and glibc's stdio alone needs more
+ * than the 1-8 KB the firmware asks for. Depths keep their relative
+ * size but never drop below configMINIMAL_STACK_SIZE.
+ */
+static inline configSTACK_DEPTH_TYPE sim_stack_depth(uint32_t depth) {
+    configSTACK_DEPTH_TYPE scaled = (configSTACK_DEPTH_TYPE)depth * 16 / sizeof(StackType_t);
+    return (scaled > configMINIMAL_STACK_SIZE) ? scaled : configMINIMAL_STACK_SIZE;
+}
+
+#define xTaskCreate(task, name, depth, param, priority, handle) \
+    xTaskCreate((task), (name), sim_stack_depth(depth), (param), (priority), (handle))
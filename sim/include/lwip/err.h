@@ -0,0 +1,11 @@
+/*
+ * lwIP Errors - LucidConsole Host Simulator
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int8_t err_t;
+
+#define ERR_OK  0
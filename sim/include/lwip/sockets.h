@@ -0,0 +1,41 @@
+/*
+ * lwIP Sockets - LucidConsole Host Simulator
+ * Host BSD sockets with the calls that block routed through the scheduler
+ */
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief select() that waits in vTaskDelay() instead of the host kernel
+ * 
+ * Under the POSIX port only one task's thread runs at a time, so a task
+ * blocked in a host syscall would stall every other task.
+ */
+int sim_select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds,
+               struct timeval* timeout);
+
+/**
+ * @brief bind() with privileged ports moved by sim --port-offset
+ */
+int sim_bind(int fd, const struct sockaddr* addr, socklen_t len);
+
+#define select  sim_select
+#define bind    sim_bind
+
+#ifdef __cplusplus
+}
+#endif
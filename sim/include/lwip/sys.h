@@ -0,0 +1,5 @@
+/*
+ * lwIP System - LucidConsole Host Simulator
+ */
+
+#pragma once
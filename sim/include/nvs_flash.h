@@ -0,0 +1,25 @@
+/*
+ * NVS Flash - LucidConsole Host Simulator
+ */
+
+#pragma once
+
+#include "nvs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Load the NVS file (see sim --state-dir), or start empty
+ */
+esp_err_t nvs_flash_init(void);
+
+/**
+ * @brief Drop every entry and the NVS file
+ */
+esp_err_t nvs_flash_erase(void);
+
+#ifdef __cplusplus
+}
+#endif
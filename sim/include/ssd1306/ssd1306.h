@@ -0,0 +1,64 @@
+/*
+ * SSD1306 Driver - LucidConsole Host Simulator
+ * Framebuffer drawing as in the ssd1306 component; uploads land in a
+ * shadow display instead of on the I2C bus
+ */
+
+#pragma once
+
+#include "fonts/fonts.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SSD1306_SCREEN = 0,
+    SH1106_SCREEN,
+} ssd1306_screen_t;
+
+typedef enum {
+    OLED_COLOR_TRANSPARENT = -1,
+    OLED_COLOR_BLACK = 0,
+    OLED_COLOR_WHITE = 1,
+    OLED_COLOR_INVERT = 2,
+} ssd1306_color_t;
+
+typedef struct {
+    uint8_t i2c_port;
+    uint8_t i2c_addr;
+    ssd1306_screen_t screen;
+    uint8_t width;
+    uint8_t height;
+} ssd1306_t;
+
+int ssd1306_init(const ssd1306_t* dev);
+
+/**
+ * @brief Upload a framebuffer (width * height / 8 bytes, page-major)
+ */
+int ssd1306_load_frame_buffer(const ssd1306_t* dev, uint8_t buf[]);
+
+int ssd1306_draw_pixel(const ssd1306_t* dev, uint8_t* fb, int8_t x, int8_t y, ssd1306_color_t color);
+int ssd1306_draw_hline(const ssd1306_t* dev, uint8_t* fb, int8_t x, int8_t y, uint8_t w,
+                       ssd1306_color_t color);
+int ssd1306_fill_rectangle(const ssd1306_t* dev, uint8_t* fb, int8_t x, int8_t y, uint8_t w,
+                           uint8_t h, ssd1306_color_t color);
+
+/**
+ * @return Character width in pixels (0 if the font lacks it), -EINVAL without a font
+ */
+int ssd1306_draw_char(const ssd1306_t* dev, uint8_t* fb, const font_info_t* font, uint8_t x,
+                      uint8_t y, char c, ssd1306_color_t foreground, ssd1306_color_t background);
+
+/**
+ * @return String width in pixels, -EINVAL without a font or string
+ */
+int ssd1306_draw_string(const ssd1306_t* dev, uint8_t* fb, const font_info_t* font, uint8_t x,
+                        uint8_t y, const char* str, ssd1306_color_t foreground,
+                        ssd1306_color_t background);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+/*
+ * TCP/IP Adapter - LucidConsole Host Simulator
+ * Interface addressing is recorded but the host stack serves every socket
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t addr;              // Network byte order
+} ip4_addr_t;
+
+#define IP4_ADDR(ipaddr, a, b, c, d) \
+    (ipaddr)->addr = ((uint32_t)((d) & 0xff) << 24) | ((uint32_t)((c) & 0xff) << 16) | \
+                     ((uint32_t)((b) & 0xff) << 8) | (uint32_t)((a) & 0xff)
+
+#define ip4_addr1_16(ipaddr) ((uint16_t)(((ipaddr)->addr) & 0xff))
+#define ip4_addr2_16(ipaddr) ((uint16_t)(((ipaddr)->addr >> 8) & 0xff))
+#define ip4_addr3_16(ipaddr) ((uint16_t)(((ipaddr)->addr >> 16) & 0xff))
+#define ip4_addr4_16(ipaddr) ((uint16_t)(((ipaddr)->addr >> 24) & 0xff))
+
+#define IPSTR "%d.%d.%d.%d"
+#define IP2STR(ipaddr) ip4_addr1_16(ipaddr), ip4_addr2_16(ipaddr), \
+                       ip4_addr3_16(ipaddr), ip4_addr4_16(ipaddr)
+
+typedef enum {
+    TCPIP_ADAPTER_IF_STA = 0,
+    TCPIP_ADAPTER_IF_AP,
+    TCPIP_ADAPTER_IF_MAX
+} tcpip_adapter_if_t;
+
+typedef struct {
+    ip4_addr_t ip;
+    ip4_addr_t netmask;
+    ip4_addr_t gw;
+} tcpip_adapter_ip_info_t;
+
+#define ESP_ERR_TCPIP_ADAPTER_INVALID_PARAMS        (ESP_ERR_TCPIP_ADAPTER_BASE + 0x01)
+#define ESP_ERR_TCPIP_ADAPTER_IF_NOT_READY          (ESP_ERR_TCPIP_ADAPTER_BASE + 0x02)
+#define ESP_ERR_TCPIP_ADAPTER_DHCPC_START_FAILED    (ESP_ERR_TCPIP_ADAPTER_BASE + 0x03)
+#define ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STARTED  (ESP_ERR_TCPIP_ADAPTER_BASE + 0x04)
+#define ESP_ERR_TCPIP_ADAPTER_DHCP_ALREADY_STOPPED  (ESP_ERR_TCPIP_ADAPTER_BASE + 0x05)
+
+void tcpip_adapter_init(void);
+esp_err_t tcpip_adapter_set_ip_info(tcpip_adapter_if_t tcpip_if, const tcpip_adapter_ip_info_t* ip_info);
+esp_err_t tcpip_adapter_get_ip_info(tcpip_adapter_if_t tcpip_if, tcpip_adapter_ip_info_t* ip_info);
+esp_err_t tcpip_adapter_dhcps_start(tcpip_adapter_if_t tcpip_if);
+esp_err_t tcpip_adapter_dhcps_stop(tcpip_adapter_if_t tcpip_if);
+
+#ifdef __cplusplus
+}
+#endif
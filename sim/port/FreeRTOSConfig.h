@@ -0,0 +1,69 @@
+/*
+ * FreeRTOS Configuration - LucidConsole Host Simulator
+ * POSIX port settings chosen to match the ESP8266 RTOS SDK kernel
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stddef.h>
+
+// Scheduler - same tick and priority range as the device (CONFIG_FREERTOS_HZ)
+#define configUSE_PREEMPTION                    1
+#define configUSE_TIME_SLICING                  1
+#define configTICK_RATE_HZ                      100
+#define configMAX_PRIORITIES                    15
+#define configUSE_16_BIT_TICKS                  0
+#define configTICK_TYPE_WIDTH_IN_BITS           TICK_TYPE_WIDTH_32_BITS
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+
+// Host threads need far more stack than the Xtensa build (see freertos/task.h)
+#define configSTACK_DEPTH_TYPE                  size_t
+#define configMINIMAL_STACK_SIZE                ((configSTACK_DEPTH_TYPE)(65536 / sizeof(StackType_t)))
+#define configMAX_TASK_NAME_LEN                 16
+
+// Memory - pvPortMalloc() (esp_system_sim.c) hands allocations to the host malloc
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configTOTAL_HEAP_SIZE                   (80 * 1024)    // Reported heap, as on the ESP8266
+
+// Synchronisation primitives used by the firmware
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_QUEUE_SETS                    0
+#define configQUEUE_REGISTRY_SIZE               0
+
+// No hooks, software timers or co-routines
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_TIMERS                        0
+#define configUSE_CO_ROUTINES                   0
+
+// Run-time stats for perf comparisons against the idle task
+#define configUSE_TRACE_FACILITY                1
+#define configGENERATE_RUN_TIME_STATS           0
+#define configUSE_STATS_FORMATTING_FUNCTIONS    0
+
+// API subset
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_xTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_eTaskGetState                   1
+
+// Kernel assertions abort so a debugger stops at the fault
+void sim_assert_failed(const char* file, unsigned long line);
+#define configASSERT(x) if ((x) == 0) sim_assert_failed(__FILE__, __LINE__)
+
+#endif /* FREERTOS_CONFIG_H */